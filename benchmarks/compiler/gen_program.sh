@@ -0,0 +1,99 @@
+#!/bin/bash
+
+# Generate synthetic COOL program for the compiler throughput benchmark
+#
+# Usage: gen_program.sh <classes> <depth> <methods> <statements> <case branches>
+#   classes      --- number of classes;
+#   depth        --- length of the inheritance chains;
+#   methods      --- number of methods in every class;
+#   statements   --- number of statements in every method;
+#   case branches --- number of branches in the case expression of Main.
+#
+# Program is printed to stdout.
+
+if [ $# -ne 5 ]; then
+    echo "Usage: $0 <classes> <depth> <methods> <statements> <case branches>"
+    exit 1
+fi
+
+classes=$1
+depth=$2
+methods=$3
+statements=$4
+branches=$(( $5 < $1 ? $5 : $1 ))
+
+# statement number j of the method m of the class c. Statements differ, so the optimizer can't merge them
+statement() {
+    local c=$1 m=$2 j=$3
+    case $(( j % 5 )) in
+    0)
+        echo "            x <- x + a${c} * ${j};"
+    ;;
+    1)
+        echo "            if x < ${j} then x <- x + ${c} else x <- x - ${m} fi;"
+    ;;
+    2)
+        echo "            x <- x + \"string ${c} ${m} ${j}\".length();"
+    ;;
+    3)
+        echo "            let y : Int <- x in while 0 < y loop y <- y - ${j} - 1 pool;"
+    ;;
+    4)
+        echo "            x <- over(x) + (if s${c}.length() = ${j} then 1 else 0 fi);"
+    ;;
+    esac
+}
+
+for (( c = 0; c < classes; c++ )); do
+    if (( c % depth == 0 )); then
+        parent=IO
+    else
+        parent=C$(( c - 1 ))
+    fi
+
+    echo "class C${c} inherits ${parent} {"
+    echo "    a${c} : Int <- ${c};"
+    echo "    s${c} : String <- \"attribute ${c}\";"
+    echo ""
+    echo "    over(x : Int) : Int { x + ${c} };"
+
+    for (( m = 0; m < methods; m++ )); do
+        echo ""
+        echo "    m${c}_${m}(x : Int) : Int {"
+        echo "        {"
+        for (( j = 0; j < statements; j++ )); do
+            statement $c $m $j
+        done
+        echo "            x;"
+        echo "        }"
+        echo "    };"
+    done
+
+    echo "};"
+    echo ""
+done
+
+echo "class Main inherits IO {"
+echo "    classify(o : Object) : Int {"
+echo "        case o of"
+for (( b = 0; b < branches; b++ )); do
+    echo "            c${b} : C${b} => c${b}.over(${b});"
+done
+echo "            o : Object => 0;"
+echo "        esac"
+echo "    };"
+echo ""
+echo "    main() : Object {"
+echo "        {"
+for (( c = 0; c < classes; c += depth )); do
+    last=$(( c + depth - 1 < classes - 1 ? c + depth - 1 : classes - 1 ))
+    if (( methods > 0 )); then
+        echo "            out_int(classify(new C${last}) + (new C${last}).m${last}_0(${c}));"
+    else
+        echo "            out_int(classify(new C${last}));"
+    fi
+    echo "            out_string(\"\\n\");"
+done
+echo "        }"
+echo "    };"
+echo "};"
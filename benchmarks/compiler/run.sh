@@ -0,0 +1,82 @@
+#!/bin/bash
+
+# Compiler throughput benchmark: generate synthetic programs of growing size and compile them with every given coolc
+#
+# Usage: run.sh [-o <out dir>] <name>=<bin dir> [<name>=<bin dir> ...]
+#   out dir --- folder for the programs, executables and results (default is the current folder);
+#   name    --- label of the compiler in the report, e.g. ARCH of its build;
+#   bin dir --- folder with coolc.
+# Additional coolc flags can be passed in COOLC_ARGS, e.g. COOLC_ARGS="-O0 -j4".
+#
+# Every compilation is run with -time-phases=json. Raw reports are saved to results/<name>.<program>.json and the
+# summary of the phases is printed as a table and saved to results/summary.txt.
+
+CURR_DIR=$(pwd)
+BENCH_DIR=$(cd $(dirname $0) && pwd)
+
+OUT_DIR=$CURR_DIR
+if [ "$1" == "-o" ]; then
+    OUT_DIR=$2
+    shift 2
+fi
+
+if [ $# -eq 0 ]; then
+    echo "Usage: $0 [-o <out dir>] <name>=<bin dir> [<name>=<bin dir> ...]"
+    exit 1
+fi
+
+COMPILERS=("$@")
+
+# name classes depth methods statements case_branches
+PROGRAMS=(
+    "classes-500 500 1 1 5 0"
+    "classes-2k 2000 1 1 5 0"
+    "deep-500 500 500 1 5 0"
+    "methods-100x10 100 10 10 20 0"
+    "large-methods-20x200 20 5 2 200 0"
+    "case-1k 1000 10 0 0 1000"
+    "strings-50x100 50 10 5 100 0"
+)
+
+mkdir -p $OUT_DIR
+cd $OUT_DIR
+
+rm -rf programs results out
+mkdir programs results out
+
+for program in "${PROGRAMS[@]}"; do
+    set -- $program
+    $BENCH_DIR/gen_program.sh $2 $3 $4 $5 $6 > programs/$1.cl
+done
+
+summary=results/summary.txt
+printf "%-12s %-24s %-20s %12s %12s %15s\n" "compiler" "program" "phase" "wall (s)" "cpu (s)" "peak rss (KB)" > $summary
+
+for compiler in "${COMPILERS[@]}"; do
+    name=${compiler%%=*}
+    bin_dir=$(cd $CURR_DIR && cd ${compiler#*=} && pwd)
+
+    for program in "${PROGRAMS[@]}"; do
+        program=${program%% *}
+        report=results/$name.$program.json
+
+        if ! LD_LIBRARY_PATH=$bin_dir $bin_dir/coolc programs/$program.cl -o out/$name.$program -time-phases=json $COOLC_ARGS \
+            2> $report > /dev/null; then
+            printf "%-12s %-24s %-20s\n" $name $program "FAILED" >> $summary
+            continue
+        fi
+
+        # phases are on one line: {"name": "parse", "depth": 0, "wall": 0.1, "cpu": 0.1, "peak_rss_kb": 1024}
+        grep -o '{"name": "[^"]*", "depth": [0-9]*, "wall": [^,]*, "cpu": [^,]*, "peak_rss_kb": [0-9]*}' $report |
+            sed -E 's/\{"name": "([^"]*)", "depth": ([0-9]*), "wall": ([^,]*), "cpu": ([^,]*), "peak_rss_kb": ([0-9]*)\}/\2 \1|\3 \4 \5/' |
+            while IFS='|' read -r phase values; do
+                set -- $values
+                indent=$(printf "%$(( ${phase%% *} * 2 ))s" "")
+                printf "%-12s %-24s %-20s %12.4f %12.4f %15s\n" $name $program "$indent${phase#* }" $1 $2 $3
+            done >> $summary
+    done
+done
+
+cat $summary
+
+cd $CURR_DIR
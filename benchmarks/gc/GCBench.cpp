@@ -0,0 +1,418 @@
+#include "runtime/gc/GC.hpp"
+#include "runtime/gc/Utils.hpp"
+#include "runtime/globals.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <csignal>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+// Standalone benchmark of the collectors: builds object graphs with the runtime allocator directly, without COOL
+// programs and LLVM. Every (workload, GC) pair runs in its own process, so running out of heap doesn't stop the others.
+//
+// Usage: gc_benchmark [MaxHeapSize=<size>] [GCAlgo=<code>] [Timeout=<seconds>] [<workload> ...]
+//   MaxHeapSize --- heap size (default 64Mb);
+//   GCAlgo      --- run only this GC (default all);
+//   Timeout     --- time limit for one run (default 60);
+//   workload    --- run only these workloads (default all).
+// The table goes to stdout, runtime errors go to stderr.
+
+// ---------------------------- Symbols that coolc defines for every program ----------------------------
+// collectors don't look at the names and the dispatch tables, they only distinguish special types by tag
+extern "C"
+{
+    void *class_nameTab = nullptr; // NOLINT
+    int _int_tag = 2;              // NOLINT
+    int _bool_tag = 3;             // NOLINT
+    int _string_tag = 4;           // NOLINT
+
+    void *String_dispTab = nullptr; // NOLINT
+    void *Int_dispTab = nullptr;    // NOLINT
+};
+
+// stack walkers are linked in, but never see COOL frames: all roots of the benchmark are runtime roots
+#ifdef LLVM_SHADOW_STACK
+StackEntry *llvm_gc_root_chain = nullptr; // NOLINT
+#endif                                    // LLVM_SHADOW_STACK
+
+#ifdef LLVM_STATEPOINT_EXAMPLE
+asm(".globl __start_llvm_stackmaps\n.globl __stop_llvm_stackmaps\n"
+    ".data\n__start_llvm_stackmaps:\n__stop_llvm_stackmaps:\n.text\n");
+
+thread_local address _stack_pointer = nullptr; // NOLINT
+thread_local address _frame_pointer = nullptr; // NOLINT
+#endif                                         // LLVM_STATEPOINT_EXAMPLE
+
+namespace
+{
+
+constexpr int NodeTag = 5;
+void *NodeDispTab = nullptr;
+
+const char *GCNames[GcTypeNumber] = {"ZeroGC", "MarkSweepGC", "ThreadedCompactionGC", "CompressorGC",
+                                     "SemispaceCopyingGC"};
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Stack walker for the mutator without stack roots
+ *
+ */
+class EmptyStackWalker : public gc::StackWalker
+{
+  public:
+    static void init() { Walker = new EmptyStackWalker; }
+
+    void process_roots(void *obj, void (*visitor)(void *obj, address *root, const address *meta),
+                       bool records_derived_ptrs = false) override
+    {
+    }
+
+    void fix_derived_pointers() override {}
+};
+
+/**
+ * @brief Collector with pause time measurements
+ *
+ * @tparam T Collector
+ */
+template <class T> class TimedGC : public T
+{
+  private:
+    std::vector<double> _pauses; // in seconds
+
+  public:
+    TimedGC() { gc::GC::Gc = this; }
+
+    void collect() override
+    {
+        const auto start = Clock::now();
+        T::collect();
+        _pauses.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+    }
+
+    const std::vector<double> &pauses() const { return _pauses; }
+};
+
+/**
+ * @brief Mutator that allocates objects through the collector. Its roots are fields of one big object that is
+ * preserved as a runtime root, like globals of COOL program are fields of Main
+ */
+class Mutator
+{
+  private:
+    address _roots;
+    int _top; // roots above the top are free
+
+    size_t _allocated_bytes;
+    size_t _allocated_objects;
+
+  public:
+    static constexpr int ROOTS_NUM = 1 << 16;
+
+    Mutator() : _roots(nullptr), _top(0), _allocated_bytes(0), _allocated_objects(0)
+    {
+        _roots = (address)node(ROOTS_NUM);
+        gc::GC::gc()->add_runtime_root(&_roots);
+    }
+
+    ~Mutator() { gc::GC::gc()->clean_runtime_roots(); }
+
+    ObjectLayout *allocate(const int &tag, const size_t &size, void *disp_tab)
+    {
+        auto *const object = gc::GC::gc()->allocate(tag, size, disp_tab);
+        _allocated_bytes += object->_size;
+        _allocated_objects++;
+        return object;
+    }
+
+    // object with fields of pointers to other objects
+    ObjectLayout *node(const int &fields)
+    {
+        auto *const object = allocate(NodeTag, sizeof(ObjectLayout) + fields * FIELD_SIZE, &NodeDispTab);
+        std::fill(object->fields_base(), object->fields_base() + fields, nullptr);
+        return object;
+    }
+
+    // string object isn't scanned by collectors
+    ObjectLayout *string(const size_t &length)
+    {
+        auto *const object = (StringLayout *)allocate(_string_tag, sizeof(StringLayout) + length, &String_dispTab);
+        object->_string_size = nullptr;
+        memset(object->_string, 'a', length);
+        object->_string[length] = 0;
+        return object;
+    }
+
+    inline static address &field(address object, const int &i) { return ((ObjectLayout *)object)->fields_base()[i]; }
+
+    // objects can move during allocation, so keep them in the roots only
+    inline address &root(const int &i) { return field(_roots, i); }
+    inline void push(ObjectLayout *object) { root(_top++) = (address)object; }
+    inline ObjectLayout *pop()
+    {
+        auto *const object = (ObjectLayout *)root(--_top);
+        root(_top) = nullptr;
+        return object;
+    }
+
+    size_t allocated_bytes() const { return _allocated_bytes; }
+    size_t allocated_objects() const { return _allocated_objects; }
+};
+
+// ---------------------------- Workloads ----------------------------
+// every workload allocates about the same amount of memory, the difference is how much of it survives
+
+// singly-linked lists: all nodes of the current list are alive, previous lists are garbage
+void lists(Mutator &m)
+{
+    for (int round = 0; round < 100; round++)
+    {
+        m.root(0) = nullptr;
+        for (int i = 0; i < 20000; i++)
+        {
+            auto *const node = m.node(2);
+            node->fields_base()[0] = m.root(0);
+            m.root(0) = (address)node;
+        }
+    }
+}
+
+// binary trees: a long-lived tree and a lot of short-lived ones
+ObjectLayout *make_tree(Mutator &m, const int &depth)
+{
+    if (depth == 0)
+    {
+        return m.node(2);
+    }
+
+    m.push(make_tree(m, depth - 1));
+    m.push(make_tree(m, depth - 1));
+
+    auto *const node = m.node(2);
+    node->fields_base()[1] = (address)m.pop();
+    node->fields_base()[0] = (address)m.pop();
+    return node;
+}
+
+void trees(Mutator &m)
+{
+    m.push(make_tree(m, 16)); // long-lived
+
+    for (int depth = 4; depth <= 16; depth += 4)
+    {
+        for (int i = 0; i < (1 << (20 - depth)); i++)
+        {
+            make_tree(m, depth);
+        }
+    }
+}
+
+// random graphs: nodes are connected by random edges with a lot of cycles, previous graphs are garbage
+void random_graph(Mutator &m)
+{
+    constexpr int nodes = 20000;
+    constexpr int edges = 4;
+    std::mt19937 rnd(42);
+
+    for (int round = 0; round < 100; round++)
+    {
+        for (int i = 0; i < nodes; i++)
+        {
+            m.root(i) = (address)m.node(edges);
+        }
+
+        for (int i = 0; i < nodes; i++)
+        {
+            for (int e = 0; e < edges; e++)
+            {
+                Mutator::field(m.root(i), e) = m.root(rnd() % nodes);
+            }
+        }
+    }
+}
+
+// large strings: a ring of recent strings of 1Kb - 64Kb
+void large_strings(Mutator &m)
+{
+    constexpr int ring = 64;
+    std::mt19937 rnd(42);
+
+    for (int i = 0; i < 20000; i++)
+    {
+        m.root(i % ring) = (address)m.string(1024 << (rnd() % 7));
+    }
+}
+
+// survival rate: every allocated object is kept in a big ring of roots with the given probability
+void survival(Mutator &m, const double &rate)
+{
+    constexpr int ring = Mutator::ROOTS_NUM;
+    std::mt19937 rnd(42);
+    std::bernoulli_distribution keep(rate);
+
+    int next = 0;
+    for (int i = 0; i < 2000000; i++)
+    {
+        auto *const node = m.node(2);
+        if (keep(rnd))
+        {
+            m.root(next) = (address)node;
+            next = (next + 1) % ring;
+        }
+    }
+}
+
+const std::vector<std::pair<std::string, std::function<void(Mutator &)>>> Workloads = {
+    {"lists", lists},
+    {"trees", trees},
+    {"random-graph", random_graph},
+    {"large-strings", large_strings},
+    {"survival-low", [](Mutator &m) { survival(m, 0.01); }},
+    {"survival-high", [](Mutator &m) { survival(m, 0.5); }},
+};
+
+template <class T> void run_with(const std::function<void(Mutator &)> &workload)
+{
+    auto *const gc = new TimedGC<T>();
+
+    const auto start = Clock::now();
+    size_t bytes = 0, objects = 0;
+    {
+        Mutator m;
+        workload(m);
+        bytes = m.allocated_bytes();
+        objects = m.allocated_objects();
+    }
+    const auto total = std::chrono::duration<double>(Clock::now() - start).count();
+
+    const auto &pauses = gc->pauses();
+    double pauses_sum = 0, max_pause = 0;
+    for (const auto &pause : pauses)
+    {
+        pauses_sum += pause;
+        max_pause = std::max(max_pause, pause);
+    }
+
+    printf("%10.3f %10.1f %12.1f %8zu %12.3f %12.3f %12.3f", total, bytes / total / (1 << 20), objects / total / 1e6,
+           pauses.size(), pauses_sum * 1000, pauses.empty() ? 0 : pauses_sum / pauses.size() * 1000,
+           max_pause * 1000);
+    fflush(stdout);
+}
+
+void run(const int &algo, const std::function<void(Mutator &)> &workload)
+{
+    GCAlgo = algo;
+    gc::Allocator::init(std::max(str_to_size(MaxHeapSize), sizeof(ObjectLayout)));
+    EmptyStackWalker::init();
+    gc::Marker::init();
+
+    switch (algo)
+    {
+    case ZEROGC:
+        run_with<gc::ZeroGC>(workload);
+        break;
+    case MARKSWEEPGC:
+        run_with<gc::MarkSweepGC>(workload);
+        break;
+    case THREADED_MC_GC:
+        run_with<gc::ThreadedCompactionGC>(workload);
+        break;
+    case COMPRESSOR_GC:
+        run_with<gc::CompressorGC>(workload);
+        break;
+    case SEMISPACE_COPYING_GC:
+        run_with<gc::SemispaceCopyingGC>(workload);
+        break;
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    MaxHeapSize = "64Mb";
+    GCAlgo = -1;
+    process_runtime_args(argc, argv);
+
+    const auto selected_algo = GCAlgo;
+
+    int timeout = 60;
+    std::vector<std::string> selected;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (arg.starts_with("Timeout="))
+        {
+            timeout = std::stoi(arg.substr(strlen("Timeout=")));
+        }
+        else if (arg.find('=') == std::string::npos)
+        {
+            selected.push_back(arg);
+        }
+    }
+
+    printf("Heap size: %s\n", MaxHeapSize.c_str());
+    printf("%-14s %-22s %10s %10s %12s %8s %12s %12s %12s %12s\n", "workload", "gc", "time (s)", "MB/s",
+           "Mobjects/s", "pauses", "total (ms)", "mean (ms)", "max (ms)", "peak rss (KB)");
+    fflush(stdout);
+
+    for (const auto &workload : Workloads)
+    {
+        if (!selected.empty() && std::find(selected.begin(), selected.end(), workload.first) == selected.end())
+        {
+            continue;
+        }
+
+        for (int algo = 0; algo < GcTypeNumber; algo++)
+        {
+            if (selected_algo >= 0 && algo != selected_algo)
+            {
+                continue;
+            }
+
+            printf("%-14s %-22s ", workload.first.c_str(), GCNames[algo]);
+            fflush(stdout);
+
+            // heap state is global, so start every run from scratch
+            const auto pid = fork();
+            if (pid == 0)
+            {
+                alarm(timeout);
+                run(algo, workload.second);
+                exit(0);
+            }
+
+            int status = 0;
+            rusage usage;
+            wait4(pid, &status, 0, &usage);
+
+            if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+            {
+                printf(" %13ld\n", usage.ru_maxrss);
+            }
+            else if (WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM)
+            {
+                printf("TIMEOUT\n");
+            }
+            else if (WIFEXITED(status))
+            {
+                printf("OUT OF MEMORY\n"); // allocator exits if the heap is exhausted
+            }
+            else
+            {
+                printf("CRASHED (signal %d)\n", WTERMSIG(status));
+            }
+            fflush(stdout);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+(*
+ * Allocation-heavy benchmark: a lot of short-lived trees while one big tree stays alive.
+ *)
+
+class Tree {
+    left : Tree;
+    right : Tree;
+
+    init(l : Tree, r : Tree) : Tree {
+        {
+            left <- l;
+            right <- r;
+            self;
+        }
+    };
+
+    check() : Int {
+        if isvoid left then 1 else 1 + left.check() + right.check() fi
+    };
+};
+
+class Main inherits IO {
+    max_depth : Int <- 14;
+
+    make(depth : Int) : Tree {
+        if depth = 0 then new Tree else (new Tree).init(make(depth - 1), make(depth - 1)) fi
+    };
+
+    pow2(n : Int) : Int {
+        if n = 0 then 1 else 2 * pow2(n - 1) fi
+    };
+
+    main() : Object {
+        let long_lived : Tree <- make(max_depth),
+            depth : Int <- 4
+        in
+            {
+                while depth <= max_depth loop
+                    let iterations : Int <- pow2(max_depth - depth + 4),
+                        i : Int <- 0,
+                        check : Int <- 0
+                    in
+                        {
+                            while i < iterations loop
+                                {
+                                    check <- check + make(depth).check();
+                                    i <- i + 1;
+                                }
+                            pool;
+                            out_int(iterations);
+                            out_string(" trees of depth ");
+                            out_int(depth);
+                            out_string(" check: ");
+                            out_int(check);
+                            out_string("\n");
+                            depth <- depth + 2;
+                        }
+                pool;
+                out_string("long lived tree of depth ");
+                out_int(max_depth);
+                out_string(" check: ");
+                out_int(long_lived.check());
+                out_string("\n");
+            }
+    };
+};
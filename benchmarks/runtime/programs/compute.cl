@@ -0,0 +1,45 @@
+(*
+ * Compute-heavy benchmark: recursion, arithmetic and loops with almost no allocations.
+ *)
+
+class Main inherits IO {
+    fib(n : Int) : Int {
+        if n < 2 then n else fib(n - 1) + fib(n - 2) fi
+    };
+
+    mod(a : Int, b : Int) : Int { a - a / b * b };
+
+    collatz(n : Int) : Int {
+        let steps : Int <- 0,
+            x : Int <- n
+        in
+            {
+                while not x = 1 loop
+                    {
+                        if mod(x, 2) = 0 then x <- x / 2 else x <- 3 * x + 1 fi;
+                        steps <- steps + 1;
+                    }
+                pool;
+                steps;
+            }
+    };
+
+    main() : Object {
+        let max_steps : Int <- 0,
+            i : Int <- 1
+        in
+            {
+                out_int(fib(32));
+                out_string("\n");
+
+                while i < 1000000 loop
+                    {
+                        let steps : Int <- collatz(i) in if max_steps < steps then max_steps <- steps else 0 fi;
+                        i <- i + 1;
+                    }
+                pool;
+                out_int(max_steps);
+                out_string("\n");
+            }
+    };
+};
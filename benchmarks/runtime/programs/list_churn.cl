@@ -0,0 +1,88 @@
+(*
+ * Allocation-heavy benchmark with high survival rate: a long list stays alive and is updated,
+ * while short lists are created and dropped.
+ *)
+
+class Node {
+    value : Int;
+    next : Node;
+
+    init(v : Int, n : Node) : Node {
+        {
+            value <- v;
+            next <- n;
+            self;
+        }
+    };
+
+    value() : Int { value };
+
+    next() : Node { next };
+
+    set_next(n : Node) : Node { next <- n };
+};
+
+class Main inherits IO {
+    build(n : Int) : Node {
+        let list : Node,
+            i : Int <- 0
+        in
+            {
+                while i < n loop
+                    {
+                        list <- (new Node).init(i, list);
+                        i <- i + 1;
+                    }
+                pool;
+                list;
+            }
+    };
+
+    sum(list : Node) : Int {
+        let s : Int <- 0,
+            node : Node <- list
+        in
+            {
+                while not isvoid node loop
+                    {
+                        s <- s + node.value();
+                        node <- node.next();
+                    }
+                pool;
+                s;
+            }
+    };
+
+    main() : Object {
+        let live : Node <- build(100000),
+            total : Int <- 0,
+            round : Int <- 0
+        in
+            {
+                while round < 300 loop
+                    {
+                        -- garbage
+                        total <- total + sum(build(5000));
+
+                        -- old nodes point to the new ones
+                        let node : Node <- live,
+                            i : Int <- 0
+                        in
+                            while i < 100 loop
+                                {
+                                    node.set_next((new Node).init(round, node.next()));
+                                    node <- node.next().next();
+                                    i <- i + 1;
+                                }
+                            pool;
+
+                        round <- round + 1;
+                    }
+                pool;
+                out_int(total);
+                out_string(" ");
+                out_int(sum(live));
+                out_string("\n");
+            }
+    };
+};
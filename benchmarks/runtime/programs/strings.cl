@@ -0,0 +1,44 @@
+(*
+ * String benchmark: many small strings and a few large ones.
+ *)
+
+class Main inherits IO {
+    main() : Object {
+        let s : String <- "",
+            i : Int <- 0,
+            total : Int <- 0
+        in
+            {
+                -- small strings
+                while i < 1000000 loop
+                    {
+                        s <- s.concat("x");
+                        if 1000 < s.length() then s <- s.substr(500, 500) else s fi;
+                        total <- total + s.length();
+                        i <- i + 1;
+                    }
+                pool;
+
+                -- large strings
+                i <- 0;
+                while i < 100 loop
+                    let big : String <- "0123456789abcdef",
+                        j : Int <- 0
+                    in
+                        {
+                            while j < 16 loop
+                                {
+                                    big <- big.concat(big);
+                                    j <- j + 1;
+                                }
+                            pool;
+                            total <- total + big.substr(i, 1000).length();
+                            i <- i + 1;
+                        }
+                pool;
+
+                out_int(total);
+                out_string("\n");
+            }
+    };
+};
@@ -0,0 +1,135 @@
+#!/bin/bash
+
+# Runtime benchmark: run programs under every GC algorithm with different heap sizes
+#
+# Usage: run.sh [-o <out dir>] <bin dir>
+#   out dir --- folder for the executables and results (default is the current folder);
+#   bin dir --- folder with coolc and runtime library.
+# Environment:
+#   COOLC_ARGS --- additional coolc flags, e.g. "-O3";
+#   GC_ALGOS   --- GCAlgo codes to run (default "0 1 2 3 4");
+#   HEAP_SIZES --- MaxHeapSize values to run (default "1Mb 4Mb 16Mb 64Mb 256Mb");
+#   TIMEOUT    --- time limit for one run in seconds (default 60).
+#
+# Wall time is measured by the script, GC phases and peak RSS are taken from +PrintGCStatistics. The comparison table
+# is printed and saved to results/summary.txt.
+
+CURR_DIR=$(pwd)
+
+OUT_DIR=$CURR_DIR
+if [ "$1" == "-o" ]; then
+    OUT_DIR=$2
+    shift 2
+fi
+
+if [ $# -ne 1 ]; then
+    echo "Usage: $0 [-o <out dir>] <bin dir>"
+    exit 1
+fi
+
+BIN_DIR=$(cd $1 && pwd)
+BENCH_DIR=$(cd $(dirname $0) && pwd)
+EXAMPLES_DIR=$BENCH_DIR/../../examples
+
+GC_ALGOS=${GC_ALGOS:-"0 1 2 3 4"}
+HEAP_SIZES=${HEAP_SIZES:-"1Mb 4Mb 16Mb 64Mb 256Mb"}
+TIMEOUT=${TIMEOUT:-60}
+
+GC_NAMES=("ZeroGC" "MarkSweepGC" "ThreadedCompactionGC" "CompressorGC" "SemispaceCopyingGC")
+
+PROGRAMS=(
+    $EXAMPLES_DIR/hairyscary.cl
+    $EXAMPLES_DIR/primes.cl
+    $EXAMPLES_DIR/sort_list.cl
+    $EXAMPLES_DIR/life.cl
+    $BENCH_DIR/programs/*.cl
+)
+
+# stdin of the program
+input_for() {
+    case $1 in
+    sort_list)
+        echo 3000
+    ;;
+    life)
+        # choose the pattern, evolve it for a while and quit
+        printf "y\n20\n"
+        yes y | head -n 3000
+        printf "n\nn\n"
+    ;;
+    esac
+}
+
+# "GC Phase MARK    : 1h:2m:3.004s" -> seconds
+phase_seconds() {
+    grep "GC Phase $1" $2 | sed 's/.*: //' |
+        awk -F: '{ s = 0; for (i = 1; i <= NF; i++) { v = $i + 0; if ($i ~ /h$/) v *= 3600; if ($i ~ /m$/) v *= 60; s += v } printf "%.3f", s }'
+}
+
+# "Peak RSS: 1Gb 2Mb 3Kb 4b" -> Kb
+peak_rss_kb() {
+    grep "Peak RSS" $1 | sed 's/.*: //' |
+        awk '{ s = 0; for (i = 1; i <= NF; i++) { v = $i + 0; if ($i ~ /Gb$/) v *= 1048576; else if ($i ~ /Mb$/) v *= 1024; else if ($i ~ /Kb$/) v *= 1; else v /= 1024; s += v } printf "%d", s }'
+}
+
+mkdir -p $OUT_DIR
+cd $OUT_DIR
+
+rm -rf results out
+mkdir results out
+
+summary=results/summary.txt
+printf "%-14s %-22s %8s %10s %10s %10s %10s %15s  %s\n" "program" "gc" "heap" "wall (s)" "alloc (s)" "mark (s)" \
+    "collect (s)" "peak rss (KB)" "status" > $summary
+
+for program in "${PROGRAMS[@]}"; do
+    name=$(basename $program .cl)
+
+    if ! $BIN_DIR/coolc $program -o out/$name $COOLC_ARGS; then
+        printf "%-14s %s\n" $name "COMPILE FAILED" >> $summary
+        continue
+    fi
+
+    input_for $name > out/$name.in
+
+    for gc in $GC_ALGOS; do
+        for heap in $HEAP_SIZES; do
+            stats=results/$name.$gc.$heap.txt
+
+            start=$(date +%s%N)
+            LD_LIBRARY_PATH=$BIN_DIR DYLD_LIBRARY_PATH=$BIN_DIR timeout $TIMEOUT out/$name GCAlgo=$gc \
+                MaxHeapSize=$heap +PrintGCStatistics < out/$name.in > /dev/null 2> $stats
+            code=$?
+            end=$(date +%s%N)
+
+            if [ $code -eq 124 ]; then
+                status="TIMEOUT"
+            elif grep -q "cannot allocate" $stats; then
+                status="OUT OF MEMORY"
+            elif [ $code -ne 0 ]; then
+                status="EXIT $code" # e.g. abort() at the end of primes.cl
+            else
+                status="OK"
+            fi
+
+            # statistics are printed only on the normal exit
+            alloc=-
+            mark=-
+            collect=-
+            rss=-
+            if grep -q "GC Phase" $stats; then
+                alloc=$(phase_seconds ALLOCATE $stats)
+                mark=$(phase_seconds MARK $stats)
+                collect=$(phase_seconds COLLECT $stats)
+                rss=$(peak_rss_kb $stats)
+            fi
+
+            printf "%-14s %-22s %8s %10.3f %10s %10s %10s %15s  %s\n" $name ${GC_NAMES[$gc]} $heap \
+                $(awk "BEGIN { print ($end - $start) / 1e9 }") $alloc $mark $collect $rss "$status" >> $summary
+        done
+    done
+done
+
+cat $summary
+
+cd $CURR_DIR
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ast/Arena.h"
+#include "ast/SymbolTable.h"
 #include <memory>
 #include <string>
 #include <variant>
@@ -198,6 +200,7 @@ struct BinaryExpression
 struct ObjectExpression
 {
     std::string _object;
+    int _symbol = SymbolTable::NO_SYMBOL; // id of the name in SymbolTable
 };
 
 struct IntExpression
@@ -218,6 +221,7 @@ struct BoolExpression
 struct Type
 {
     std::string _string;
+    int _symbol = SymbolTable::NO_SYMBOL; // id of the name in SymbolTable
 };
 
 struct Expression
@@ -227,9 +231,9 @@ struct Expression
                  StringExpression, BoolExpression>
         _data;
 
-    int _line_number;
-
     std::shared_ptr<Type> _type;
+
+    int _line_number;
     bool _can_allocate = false;
 };
 
@@ -0,0 +1,30 @@
+#include "ast/Arena.h"
+#include <algorithm>
+#include <mutex>
+
+using namespace ast;
+
+void Arena::new_block(const size_t &size)
+{
+    const auto block_size = std::max(size, BLOCK_SIZE);
+
+    _blocks.push_back(std::make_unique_for_overwrite<std::byte[]>(block_size));
+    _ptr = _blocks.back().get();
+    _end = _ptr + block_size;
+}
+
+Arena &Arena::thread_arena()
+{
+    // arenas are not freed: nodes of the AST can be referenced from the static objects and from other threads
+    static auto *const arenas = new std::vector<Arena *>();
+    static std::mutex arenas_lock;
+
+    thread_local Arena *arena = nullptr;
+    if (!arena)
+    {
+        const std::lock_guard<std::mutex> guard(arenas_lock);
+        arena = arenas->emplace_back(new Arena());
+    }
+
+    return *arena;
+}
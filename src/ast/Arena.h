@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ast
+{
+
+/**
+ * @brief Bump allocator for AST nodes
+ *
+ * @details
+ * Nodes are allocated in big blocks one after another and are never freed one by one: AST lives until the end of the
+ * compilation. Every thread has its own arena, so parsers running in parallel don't share allocation state.
+ */
+class Arena
+{
+  private:
+    static constexpr size_t BLOCK_SIZE = 256 * 1024;
+
+    std::vector<std::unique_ptr<std::byte[]>> _blocks;
+    std::byte *_ptr;
+    std::byte *_end;
+
+    void new_block(const size_t &size);
+
+    Arena() : _ptr(nullptr), _end(nullptr) {}
+
+  public:
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+     * @brief Allocate memory in the arena
+     *
+     * @param size Size in bytes
+     * @param alignment Alignment of the memory
+     * @return Pointer to the memory
+     */
+    inline void *allocate(const size_t &size, const size_t &alignment)
+    {
+        auto *const ptr = reinterpret_cast<std::byte *>((reinterpret_cast<uintptr_t>(_ptr) + alignment - 1) &
+                                                        ~(uintptr_t)(alignment - 1));
+        if (!_ptr || ptr + size > _end)
+        {
+            new_block(size + alignment);
+            return allocate(size, alignment);
+        }
+
+        _ptr = ptr + size;
+        return ptr;
+    }
+
+    /**
+     * @brief Get the arena of the current thread
+     *
+     * @return Arena that lives until the exit of the compiler
+     */
+    static Arena &thread_arena();
+};
+
+/**
+ * @brief Stateless allocator that places objects in the arena of the current thread. Deallocation is no-op
+ *
+ * @tparam T Type of the objects
+ */
+template <class T> class ArenaAllocator
+{
+  public:
+    using value_type = T;
+
+    ArenaAllocator() = default;
+    template <class U> ArenaAllocator(const ArenaAllocator<U> &other) {}
+
+    inline T *allocate(const size_t &n)
+    {
+        return static_cast<T *>(Arena::thread_arena().allocate(n * sizeof(T), alignof(T)));
+    }
+    inline void deallocate(T *, const size_t &) {}
+
+    template <class U> inline bool operator==(const ArenaAllocator<U> &other) const { return true; }
+};
+
+/**
+ * @brief Create AST node in the arena of the current thread
+ *
+ * @tparam T Type of the node
+ * @param args Arguments for the constructor of the node
+ * @return Node
+ */
+template <class T, class... Args> inline std::shared_ptr<T> make(Args &&...args)
+{
+    return std::allocate_shared<T>(ArenaAllocator<T>(), std::forward<Args>(args)...);
+}
+
+} // namespace ast
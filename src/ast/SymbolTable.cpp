@@ -0,0 +1,91 @@
+#include "ast/SymbolTable.h"
+#include "utils/Utils.h"
+#include <bit>
+
+using namespace ast;
+
+SymbolTable::SymbolTable() : _size(0)
+{
+    for (auto &chunk : _chunks)
+    {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+SymbolTable::~SymbolTable()
+{
+    for (auto &chunk : _chunks)
+    {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+SymbolTable &SymbolTable::table()
+{
+    static SymbolTable symbols;
+    return symbols;
+}
+
+std::string &SymbolTable::slot(const int &symbol) const
+{
+    // chunk i starts from FIRST_CHUNK_SIZE * (2^i - 1)
+    const unsigned blocks = symbol / FIRST_CHUNK_SIZE + 1;
+    const int chunk = std::bit_width(blocks) - 1;
+    const int offset = symbol - FIRST_CHUNK_SIZE * ((1 << chunk) - 1);
+
+    return _chunks[chunk].load(std::memory_order_acquire)[offset];
+}
+
+int SymbolTable::intern(const std::string_view &name)
+{
+    auto &symbols = table();
+    const std::lock_guard<std::mutex> guard(symbols._lock);
+
+    const auto id = symbols._ids.find(name);
+    if (id != symbols._ids.end())
+    {
+        return id->second;
+    }
+
+    const int symbol = symbols._size.load(std::memory_order_relaxed);
+
+    // the first name of the chunk allocates it
+    const unsigned blocks = symbol / FIRST_CHUNK_SIZE + 1;
+    if (!(blocks & (blocks - 1)) && symbol % FIRST_CHUNK_SIZE == 0)
+    {
+        const int chunk = std::bit_width(blocks) - 1;
+        GUARANTEE_DEBUG(chunk < MAX_CHUNKS);
+        symbols._chunks[chunk].store(new std::string[FIRST_CHUNK_SIZE << chunk], std::memory_order_release);
+    }
+
+    auto &slot = symbols.slot(symbol);
+    slot = name;
+    symbols._ids.insert({slot, symbol});
+
+    // publish the name for readers
+    symbols._size.store(symbol + 1, std::memory_order_release);
+
+    return symbol;
+}
+
+int SymbolTable::find(const std::string_view &name)
+{
+    auto &symbols = table();
+    const std::lock_guard<std::mutex> guard(symbols._lock);
+
+    const auto id = symbols._ids.find(name);
+    return id != symbols._ids.end() ? id->second : NO_SYMBOL;
+}
+
+const std::string &SymbolTable::name(const int &symbol)
+{
+    auto &symbols = table();
+    GUARANTEE_DEBUG(symbol >= 0 && symbol < symbols._size.load(std::memory_order_acquire));
+
+    return symbols.slot(symbol);
+}
+
+int SymbolTable::size()
+{
+    return table()._size.load(std::memory_order_acquire);
+}
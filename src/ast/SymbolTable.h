@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace ast
+{
+
+/**
+ * @brief Global table of the interned names of types, methods and objects
+ *
+ * @details
+ * Lexer interns every identifier, so later phases compare and hash small integer ids instead of strings. Ids are
+ * dense: they are assigned one after another starting from 0, so they can be used as indices in arrays. The table is
+ * shared by all threads and lives until the exit of the compiler. Only interning of the new names takes the lock, names
+ * are stored in chunks that never move, so getting a name by id doesn't lock.
+ */
+class SymbolTable
+{
+  private:
+    // chunk i holds FIRST_CHUNK_SIZE << i names, so MAX_CHUNKS chunks are enough for any int id
+    static constexpr int FIRST_CHUNK_SIZE = 1024;
+    static constexpr int MAX_CHUNKS = 22;
+
+    std::mutex _lock;
+    std::unordered_map<std::string_view, int> _ids; // keys refer to the strings in _chunks
+    std::array<std::atomic<std::string *>, MAX_CHUNKS> _chunks;
+    std::atomic<int> _size; // names with the lower ids are ready to be read
+
+    SymbolTable();
+    ~SymbolTable();
+
+    static SymbolTable &table();
+
+    std::string &slot(const int &symbol) const;
+
+  public:
+    // id of the name that was not interned
+    static constexpr int NO_SYMBOL = -1;
+
+    /**
+     * @brief Get id of the name. Assign a new one if the name is met for the first time
+     *
+     * @param name Name
+     * @return Id of the name
+     */
+    static int intern(const std::string_view &name);
+
+    /**
+     * @brief Get id of the name without interning it
+     *
+     * @param name Name
+     * @return Id of the name or NO_SYMBOL if the name was not interned
+     */
+    static int find(const std::string_view &name);
+
+    /**
+     * @brief Get the name by id
+     *
+     * @param symbol Id of the name
+     * @return Name
+     */
+    static const std::string &name(const int &symbol);
+
+    /**
+     * @brief Number of the interned names. All ids are less than this number
+     *
+     * @return Number of the names
+     */
+    static int size();
+};
+
+} // namespace ast
@@ -3,20 +3,40 @@
 #include "codegen/emitter/data/Data.inline.h"
 #include "opt/dae/DAE.hpp"
 #include "opt/nce/NCE.hpp"
+#include "opt/slm/SLM.hpp"
+#include "utils/timer/PhaseTimer.h"
 #include <boost/dll/runtime_symbol_info.hpp> // NOLINT
 #include <boost/filesystem.hpp>
 #include <filesystem>
 #include <iostream>
+#include <numeric>
+#include <optional>
 #include <llvm-14/llvm/Support/CodeGen.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/MDBuilder.h>
+#include <llvm/IR/PassTimingInfo.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/MC/TargetRegistry.h>
+#include <llvm/Object/ELF.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Passes/StandardInstrumentations.h>
 #include <llvm/Support/Host.h>
 #include <llvm/Support/Program.h>
+#include <llvm/Support/SmallVectorMemoryBuffer.h>
 #include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/Timer.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Transforms/InstCombine/InstCombine.h>
 #include <llvm/Transforms/Scalar.h>
 #include <llvm/Transforms/Scalar/GVN.h>
+#include <llvm/Transforms/Scalar/Reassociate.h>
+#include <llvm/Transforms/Scalar/RewriteStatepointsForGC.h>
+#include <llvm/Transforms/Scalar/SimplifyCFG.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Utils/SplitModule.h>
 
 using namespace codegen;
 
@@ -24,7 +44,9 @@ using namespace codegen;
 
 CodeGenLLVM::CodeGenLLVM(const std::shared_ptr<semant::ClassNode> &root)
     : CodeGen(std::make_shared<KlassBuilderLLVM>(root)), _ir_builder(_context),
-      _module(root->_class->_file_name, _context), _runtime(_module), _data(_builder, _module, _runtime),
+      _module(root->_class->_file_name, _context), _runtime(_module), _data(_builder, _module, _runtime), _nni(_builder),
+      _profile_counters(nullptr), _function_profile(nullptr), _function_counters(0), _next_counter(0),
+      _is_tail_call(false), _method_body(nullptr),
       _true_obj(_data.bool_const(true)), _false_obj(_data.bool_const(false)),
       _true_val(llvm::ConstantInt::get(_runtime.default_int(), TrueValue)),
       _false_val(llvm::ConstantInt::get(_runtime.default_int(), FalseValue)),
@@ -32,59 +54,126 @@ CodeGenLLVM::CodeGenLLVM(const std::shared_ptr<semant::ClassNode> &root)
       _int0_32(llvm::ConstantInt::get(_runtime.int32_type(), 0, true)),
       _int0_8(llvm::ConstantInt::get(_runtime.int8_type(), 0, true)),
       _int0_8_ptr(llvm::ConstantPointerNull::get(_runtime.int8_type()->getPointerTo())),
-      _stack_slot_null(llvm::ConstantPointerNull::get(_runtime.stack_slot_type())), _optimizer(&_module)
+      _stack_slot_null(llvm::ConstantPointerNull::get(_runtime.stack_slot_type()))
 {
     GUARANTEE_DEBUG(_true_obj);
     GUARANTEE_DEBUG(_false_obj);
 
-    init_optimizer();
-
     DEBUG_ONLY(_table.set_printer([](const std::string &name, const Symbol &s) {
         LOG("Added symbol \"" + name + "\": " + static_cast<std::string>(s))
     }));
 }
 
-void CodeGenLLVM::init_optimizer()
+void CodeGenLLVM::optimize(llvm::TargetMachine *target_machine)
 {
-    if (DoOpts)
+    llvm::LoopAnalysisManager lam;
+    llvm::FunctionAnalysisManager fam;
+    llvm::CGSCCAnalysisManager cgam;
+    llvm::ModuleAnalysisManager mam;
+
+    // report of the pass timings is printed when instrumentations are destroyed, so the stream must outlive them
+    std::string timings;
+    llvm::raw_string_ostream timings_os(timings);
+
+    llvm::PassInstrumentationCallbacks pic;
+    llvm::StandardInstrumentations si(false /* debug logging */);
+    if (TimePhases)
     {
-        // Eliminate excessive null checks
-        _optimizer.add(new opt::NCE(_runtime));
+        si.registerCallbacks(pic, &fam);
+        si.getTimePasses().setOutStream(TimePhasesJSON ? llvm::nulls() : timings_os);
     }
 
-    // Do simple "peephole" optimizations and bit-twiddling optimizations.
-    _optimizer.add(llvm::createInstructionCombiningPass());
+    llvm::PassBuilder pb(target_machine, llvm::PipelineTuningOptions(), llvm::None, TimePhases ? &pic : nullptr);
 
-    // Reassociate expressions.
-    _optimizer.add(llvm::createReassociatePass());
+    // custom passes match the IR exactly as it was emitted, so run them before the standard pipeline
+    pb.registerPipelineStartEPCallback([this](llvm::ModulePassManager &mpm, llvm::OptimizationLevel level) {
+        if (level == llvm::OptimizationLevel::O0)
+        {
+            return;
+        }
 
-    // Eliminate Common SubExpressions.
-    _optimizer.add(llvm::createGVNPass());
+        llvm::FunctionPassManager fpm;
 
-    // Simplify the control flow graph (deleting unreachable blocks, etc).
-    _optimizer.add(llvm::createCFGSimplificationPass());
+        if (DoOpts)
+        {
+            // Eliminate excessive null checks
+            fpm.addPass(opt::NCE(_runtime));
+        }
 
-    if (DoOpts)
-    {
-        // TODO: custom GVN
-        int int_tag = _builder->tag(BaseClassesNames[BaseClasses::INT]);
+        // Do simple "peephole" optimizations and bit-twiddling optimizations.
+        fpm.addPass(llvm::InstCombinePass());
 
-        // Eliminate Dead Allocations
-        _optimizer.add(new opt::DAE(_runtime, int_tag));
+        // Reassociate expressions.
+        fpm.addPass(llvm::ReassociatePass());
 
-        // Eliminate Common SubExpressions
-        _optimizer.add(llvm::createGVNPass());
+        // Eliminate Common SubExpressions.
+        fpm.addPass(llvm::GVNPass());
 
-        // Eliminate Dead Allocations One More Time
-        _optimizer.add(new opt::DAE(_runtime, int_tag));
-    }
+        // Simplify the control flow graph (deleting unreachable blocks, etc).
+        fpm.addPass(llvm::SimplifyCFGPass());
+
+        if (DoOpts)
+        {
+            // TODO: custom GVN
+            int int_tag = _builder->tag(BaseClassesNames[BaseClasses::INT]);
+
+            // Eliminate Dead Allocations
+            fpm.addPass(opt::DAE(_runtime, int_tag));
+
+            // Eliminate Common SubExpressions
+            fpm.addPass(llvm::GVNPass());
+
+            // Eliminate Dead Allocations One More Time
+            fpm.addPass(opt::DAE(_runtime, int_tag));
+        }
+
+        mpm.addPass(llvm::createModuleToFunctionPassAdaptor(std::move(fpm)));
+    });
+
+    pb.registerModuleAnalyses(mam);
+    pb.registerCGSCCAnalyses(cgam);
+    pb.registerFunctionAnalyses(fam);
+    pb.registerLoopAnalyses(lam);
+    pb.crossRegisterProxies(lam, fam, cgam, mam);
+
+    static const llvm::OptimizationLevel opt_levels[] = {llvm::OptimizationLevel::O0, llvm::OptimizationLevel::O1,
+                                                         llvm::OptimizationLevel::O2, llvm::OptimizationLevel::O3};
+
+    // inliner, IPSCCP, global DCE, loop and vectorization passes
+    auto mpm = OptLevel == 0 ? pb.buildO0DefaultPipeline(opt_levels[OptLevel])
+                             : pb.buildPerModuleDefaultPipeline(opt_levels[OptLevel]);
+
+#if defined(LLVM_SHADOW_STACK) || defined(LLVM_STATEPOINT_EXAMPLE)
+    // inlined methods bring their own stack maps of locals, merge them with the caller's one
+    mpm.addPass(llvm::createModuleToFunctionPassAdaptor(opt::SLM()));
+#endif // LLVM_SHADOW_STACK || LLVM_STATEPOINT_EXAMPLE
+
+#ifdef LLVM_STATEPOINT_EXAMPLE
+    mpm.addPass(llvm::RewriteStatepointsForGC());
+#endif // LLVM_STATEPOINT_EXAMPLE
+
+    mpm.run(_module, mam);
+
+    if (TimePhases)
+    {
+        if (TimePhasesJSON)
+        {
+            timings_os << "{";
+            llvm::TimerGroup::printAllJSONValues(timings_os, "");
+            timings_os << "}";
+        }
+        else
+        {
+            si.getTimePasses().print();
+        }
 
-    _optimizer.doInitialization();
+        PhaseTimer::add_report("optimizer passes", timings_os.str());
+    }
 }
 
 void CodeGenLLVM::add_fields()
 {
-    const auto &this_klass = _builder->klass(_current_class->_type->_string);
+    const auto &this_klass = _builder->klass(_current_class->_type);
 
     for (auto field = this_klass->fields_begin(); field != this_klass->fields_end(); field++)
     {
@@ -100,13 +189,20 @@ void CodeGenLLVM::allocate_shadow_stack(int max_stack)
     _stack.resize(max_stack);
     _current_stack_size = 0;
     _need_reload = false;
+    _has_raw_locals = false;
 #ifdef DEBUG
     _max_stack_size = 0;
+    _raw_slots = 0;
 #endif // DEBUG
 }
 
 void CodeGenLLVM::set_need_reload(bool need_reload) { _need_reload = need_reload; }
 
+bool CodeGenLLVM::can_allocate(const std::shared_ptr<ast::Expression> &expr) const
+{
+    return expr->_can_allocate || _has_raw_locals;
+}
+
 void CodeGenLLVM::init_shadow_stack(const std::vector<llvm::Value *> &args)
 {
     // stack slots for temporaries
@@ -179,11 +275,100 @@ void CodeGenLLVM::emit_class_method_inner(const std::shared_ptr<ast::Feature> &m
         return;
     }
 
-    auto *const func = _module.getFunction(
-        _builder->klass(_current_class->_type->_string)->method_full_name(method->_object->_object));
+    const auto &klass = _builder->klass(_current_class->_type);
+    auto *const func = _module.getFunction(klass->method_full_name(method->_object->_object));
 
     GUARANTEE_DEBUG(func);
+    _function_klass.insert({func->getName().str(), klass->name()});
+
+    auto *const unboxed_func = unboxed_method(klass, *method->_object);
+    if (unboxed_func)
+    {
+        _function_klass.insert({unboxed_func->getName().str(), klass->name()});
+
+        // dispatch table refers to the boxed method, so it just calls the unboxed one
+        emit_method_body(unboxed_func, method);
+        emit_boxed_wrapper(func, unboxed_func, method);
+    }
+    else
+    {
+        emit_method_body(func, method);
+    }
+
+    if (DoOpts && _nni.is_non_null(method))
+    {
+        func->addRetAttr(llvm::Attribute::NonNull);
+        if (unboxed_func && unboxed_func->getReturnType()->isPointerTy())
+        {
+            unboxed_func->addRetAttr(llvm::Attribute::NonNull);
+        }
+    }
+}
+
+llvm::Function *CodeGenLLVM::unboxed_method(const std::shared_ptr<Klass> &klass,
+                                            const ast::ObjectExpression &method_name)
+{
+    if (!DoOpts)
+    {
+        return nullptr;
+    }
+
+    const auto &method = *(klass->methods_begin() + klass->method_index(method_name._symbol));
+
+    // methods of the basic classes are implemented in runtime
+    if (semant::Semant::is_basic_type(method.first))
+    {
+        return nullptr;
+    }
+
+    const auto is_primitive = [](const std::shared_ptr<ast::Type> &type) {
+        return semant::Semant::is_int(type) || semant::Semant::is_bool(type);
+    };
+
+    const auto &formals = std::get<ast::MethodFeature>(method.second->_base)._formals;
+    if (!is_primitive(method.second->_type) &&
+        std::none_of(formals.begin(), formals.end(), [&](const auto &formal) { return is_primitive(formal->_type); }))
+    {
+        return nullptr;
+    }
+
+    auto *const boxed_func = _module.getFunction(klass->method_full_name(method_name._object));
+    GUARANTEE_DEBUG(boxed_func);
+
+    const auto unboxed_name = Names::name(Names::Comment::UNBOXED, static_cast<std::string>(boxed_func->getName()));
+    if (auto *const func = _module.getFunction(unboxed_name))
+    {
+        return func;
+    }
+
+    std::vector<llvm::Type *> args = {boxed_func->getArg(0)->getType()}; // this
+    for (auto i = 0; i < formals.size(); i++)
+    {
+        args.push_back(is_primitive(formals[i]->_type) ? _runtime.default_int() : boxed_func->getArg(i + 1)->getType());
+    }
+
+    auto *const return_type = is_primitive(method.second->_type) ? _runtime.default_int() : boxed_func->getReturnType();
+
+    // unboxed method is called only directly, so optimizer is free to change it
+    auto *const func = llvm::Function::Create(llvm::FunctionType::get(return_type, args, false),
+                                              llvm::Function::InternalLinkage, unboxed_name, &_module);
+
+    if (boxed_func->hasGC())
+    {
+        func->setGC(boxed_func->getGC());
+    }
+
+    for (auto i = 0; i < func->arg_size(); i++)
+    {
+        func->getArg(i)->setName(boxed_func->getArg(i)->getName());
+    }
+    func->addParamAttrs(0, llvm::AttrBuilder(_context, boxed_func->getAttributes().getParamAttrs(0))); // this
+
+    return func;
+}
 
+void CodeGenLLVM::emit_method_body(llvm::Function *func, const std::shared_ptr<ast::Feature> &method)
+{
 #if LLVM_STATEPOINT_EXAMPLE
     func->addFnAttr(llvm::Attribute::get(_context, "frame-pointer", "all"));
 #endif // LLVM_STATEPOINT_EXAMPLE
@@ -204,15 +389,22 @@ void CodeGenLLVM::emit_class_method_inner(const std::shared_ptr<ast::Feature> &m
     allocate_stack(m._expression_stack);
 #endif // LLVM_SHADOW_STACK
 
-    // stack slots for args
+    // stack slots for args. Slots of raw values are not GC roots
+    std::vector<llvm::Value *> args_slots;
     std::vector<llvm::Value *> args_stack;
     for (int i = 0; i < func->arg_size(); i++)
     {
         auto *const arg = func->getArg(i);
-        args_stack.push_back(__ CreateAlloca(arg->getType()));
+        args_slots.push_back(__ CreateAlloca(arg->getType()));
+
+        if (!arg->getType()->isIntegerTy())
+        {
+            args_stack.push_back(args_slots.back());
+        }
     }
 
 #ifdef LLVM_SHADOW_STACK
+    _has_raw_locals = args_slots.size() != args_stack.size();
     init_shadow_stack(args_stack);
 #else
     init_stack();
@@ -225,22 +417,43 @@ void CodeGenLLVM::emit_class_method_inner(const std::shared_ptr<ast::Feature> &m
     for (auto i = 0; i < func->arg_size(); i++)
     {
         auto *const arg = func->getArg(i);
-        __ CreateStore(arg, args_stack[i]);
+        __ CreateStore(arg, args_slots[i]);
 
         _table.add_symbol(static_cast<std::string>(arg->getName()),
-                          Symbol(args_stack[i], i != 0 ? formals[i - 1]->_type : _current_class->_type));
+                          Symbol(args_slots[i], i != 0 ? formals[i - 1]->_type : _current_class->_type,
+                                 arg->getType()->isIntegerTy() ? Symbol::RAW_LOCAL : Symbol::LOCAL));
     }
 
     for (auto i = 0; i < func->arg_size(); i++)
     {
-        DEBUG_ONLY(verify_oop(func->getArg(i)));
+        if (!func->getArg(i)->getType()->isIntegerTy())
+        {
+            DEBUG_ONLY(verify_oop(func->getArg(i)));
+        }
     }
 
-    __ CreateRet(maybe_cast(emit_expr(method->_expr), func->getReturnType()));
+    profile_function_begin(func);
 
-    _table.pop_scope();
+    // self tail calls jump here, so the frame and GC roots are set up once
+    _tail_calls.clear();
+    find_tail_calls(method->_expr);
+    _args_slots = args_slots;
+    _method_body = nullptr;
+    if (!_tail_calls.empty())
+    {
+        _method_body = llvm::BasicBlock::Create(_context, Names::comment(Names::Comment::LOOP_HEADER), func);
+        __ CreateBr(_method_body);
+        __ SetInsertPoint(_method_body);
+    }
+
+    auto *const result = func->getReturnType()->isIntegerTy()
+                             ? emit_value(method->_expr)
+                             : maybe_cast(emit_expr(method->_expr), func->getReturnType());
+    __ CreateRet(result);
 
-    _optimizer.run(*func);
+    profile_function_end(func);
+
+    _table.pop_scope();
 
 #ifdef DEBUG
     verify(func);
@@ -251,6 +464,71 @@ void CodeGenLLVM::emit_class_method_inner(const std::shared_ptr<ast::Feature> &m
 #else
     GUARANTEE_DEBUG(_max_stack_size == _stack.size());
 #endif // LLVM_SHADOW_STACK
+
+    _tail_calls.clear();
+    _method_body = nullptr;
+}
+
+llvm::Value *CodeGenLLVM::emit_call(llvm::Function *callee, const std::vector<llvm::Value *> &args)
+{
+    if (!_is_tail_call || !_method_body || _method_body->getParent() != callee)
+    {
+        return __ CreateCall(callee, args);
+    }
+
+    // all args are evaluated, so the slots can be overwritten. They are GC roots of the method, so new values are
+    // visible to GC in the next iteration like the incoming args
+    for (auto i = 0; i < args.size(); i++)
+    {
+        __ CreateStore(args[i], _args_slots[i]);
+    }
+    __ CreateBr(_method_body);
+
+    // the rest of the dispatch and the return are unreachable, they are removed by the optimizer
+    __ SetInsertPoint(llvm::BasicBlock::Create(_context, "", callee));
+    return llvm::UndefValue::get(callee->getReturnType());
+}
+
+void CodeGenLLVM::emit_boxed_wrapper(llvm::Function *func, llvm::Function *unboxed_func,
+                                     const std::shared_ptr<ast::Feature> &method)
+{
+#if LLVM_STATEPOINT_EXAMPLE
+    func->addFnAttr(llvm::Attribute::get(_context, "frame-pointer", "all"));
+#endif // LLVM_STATEPOINT_EXAMPLE
+
+    auto *entry = llvm::BasicBlock::Create(_context, Names::comment(Names::Comment::ENTRY_BLOCK), func);
+    __ SetInsertPoint(entry);
+
+    // args are not used after the call, so no locals at all
+#ifdef LLVM_SHADOW_STACK
+    allocate_shadow_stack(0);
+    init_shadow_stack({});
+#else
+    allocate_stack(0);
+    init_stack();
+#endif // LLVM_SHADOW_STACK
+
+#ifdef LLVM_STATEPOINT_EXAMPLE
+    save_locals({});
+#endif // LLVM_STATEPOINT_EXAMPLE
+
+    // Int and Bool args are never void
+    const auto &formals = std::get<ast::MethodFeature>(method->_base)._formals;
+    std::vector<llvm::Value *> args;
+    for (auto &arg : func->args())
+    {
+        args.push_back(unboxed_func->getArg(arg.getArgNo())->getType()->isIntegerTy()
+                           ? emit_load_primitive(&arg, _builder->klass(formals[arg.getArgNo() - 1]->_type))
+                           : static_cast<llvm::Value *>(&arg));
+    }
+
+    auto *const result = __ CreateCall(unboxed_func, args);
+
+    __ CreateRet(maybe_cast(emit_box(result, method->_type), func->getReturnType()));
+
+#ifdef DEBUG
+    verify(func);
+#endif // DEBUG
 }
 
 #ifdef LLVM_SHADOW_STACK
@@ -260,7 +538,7 @@ int CodeGenLLVM::preserve_value_for_gc(llvm::Value *value, bool preserve)
     {
         __ CreateStore(__ CreateBitCast(value, _runtime.stack_slot_type()), _stack.at(_current_stack_size++));
 #ifdef DEBUG
-        _max_stack_size = std::max(_current_stack_size, _max_stack_size);
+        _max_stack_size = std::max(_current_stack_size + _raw_slots, _max_stack_size);
 #endif // DEBUG
         return 1;
     }
@@ -279,7 +557,7 @@ void CodeGenLLVM::pop_dead_value(int slots)
 
 llvm::Value *CodeGenLLVM::reload_value_from_stack(int slot_num, llvm::Value *orig_value, bool reload)
 {
-    return (reload || !ReduceGCSpills) ? __ CreateLoad(orig_value->getType(), _stack.at(slot_num)) : orig_value;
+    return (reload || !ReduceGCSpills) ? emit_load_slot(_stack.at(slot_num), orig_value->getType()) : orig_value;
 }
 
 int CodeGenLLVM::reload_args(std::vector<llvm::Value *> &args, const std::shared_ptr<ast::Expression> &self,
@@ -289,6 +567,12 @@ int CodeGenLLVM::reload_args(std::vector<llvm::Value *> &args, const std::shared
     for (int i = 0; i < expr_args.size(); i++)
     {
         auto *const orig_value = args.at(i + 1);
+        if (orig_value->getType()->isIntegerTy())
+        {
+            // raw values are not preserved
+            continue;
+        }
+
         args[i + 1] = reload_value_from_stack(_current_stack_size - (slots - n), orig_value, true);
         if (orig_value != args.at(i + 1))
         {
@@ -305,6 +589,7 @@ void CodeGenLLVM::allocate_stack(int max_stack)
     _current_stack_size = 0;
 #ifdef DEBUG
     _max_stack_size = 0;
+    _raw_slots = 0;
 #endif // DEBUG
 }
 
@@ -312,7 +597,7 @@ void CodeGenLLVM::push(llvm::Value *value)
 {
     __ CreateStore(__ CreateBitCast(value, _runtime.stack_slot_type()), _stack.at(_current_stack_size++));
 #ifdef DEBUG
-    _max_stack_size = std::max(_current_stack_size, _max_stack_size);
+    _max_stack_size = std::max(_current_stack_size + _raw_slots, _max_stack_size);
 #endif // DEBUG
 }
 
@@ -342,6 +627,11 @@ llvm::Value *CodeGenLLVM::maybe_cast(llvm::Value *val, llvm::Type *type)
     return val;
 }
 
+llvm::Value *CodeGenLLVM::emit_load_slot(llvm::Value *slot, llvm::Type *type)
+{
+    return maybe_cast(__ CreateLoad(slot->getType()->getPointerElementType(), slot), type);
+}
+
 void CodeGenLLVM::maybe_cast(std::vector<llvm::Value *> &args, llvm::FunctionType *func)
 {
     for (int i = 0; i < args.size(); i++)
@@ -364,6 +654,13 @@ void CodeGenLLVM::verify(llvm::Function *func)
     }
 }
 
+void CodeGenLLVM::hold_raw_slots(int slots)
+{
+    // keep the stack size in sync with semant
+    _raw_slots += slots;
+    _max_stack_size = std::max(_current_stack_size + _raw_slots, _max_stack_size);
+}
+
 void CodeGenLLVM::verify_oop(llvm::Value *object)
 {
     static auto *const VERIFY_OOP = _runtime.symbol_by_id(RuntimeLLVM::RuntimeLLVMSymbols::VERIFY_OOP)->_func;
@@ -376,12 +673,13 @@ void CodeGenLLVM::verify_oop(llvm::Value *object)
 
 void CodeGenLLVM::emit_class_init_method_inner()
 {
-    const auto &klass = _builder->klass(_current_class->_type->_string);
+    const auto &klass = _builder->klass(_current_class->_type);
 
     // Note, that init method don't init header
     auto *const func = _module.getFunction(klass->init_method());
 
     GUARANTEE_DEBUG(func);
+    _function_klass.insert({func->getName().str(), klass->name()});
 
 #if LLVM_STATEPOINT_EXAMPLE
     func->addFnAttr(llvm::Attribute::get(_context, "frame-pointer", "all"));
@@ -420,6 +718,8 @@ void CodeGenLLVM::emit_class_init_method_inner()
     save_locals(args_stack);
 #endif // LLVM_STATEPOINT_EXAMPLE
 
+    profile_function_begin(func);
+
     // set default value before init for fields of this class
     for (const auto &feature : _current_class->_features)
     {
@@ -469,14 +769,14 @@ void CodeGenLLVM::emit_class_init_method_inner()
                 }
             }
 
-            __ CreateStore(initial_val, field_ptr);
+            mark_field_access(__ CreateStore(initial_val, field_ptr), klass, this_field._value._offset);
         }
     }
 
     // call parent constructor
     if (!semant::Semant::is_empty_type(_current_class->_parent)) // Object moment
     {
-        const auto parent = _builder->klass(_current_class->_parent->_string);
+        const auto parent = _builder->klass(_current_class->_parent);
         auto *const parent_struct = _data.class_struct(parent);
 
         __ CreateCall(_module.getFunction(parent->init_method()),
@@ -505,16 +805,17 @@ void CodeGenLLVM::emit_class_init_method_inner()
                 auto *const field_ptr = __ CreateStructGEP(klass_struct, self, this_field._value._offset);
                 auto *const pointee_type = klass_struct->getTypeAtIndex(this_field._value._offset);
 
-                __ CreateStore(maybe_cast(value, pointee_type), field_ptr);
+                mark_field_access(__ CreateStore(maybe_cast(value, pointee_type), field_ptr), klass,
+                                  this_field._value._offset);
             }
         }
     }
 
     __ CreateRet(nullptr);
 
-    _table.pop_scope();
+    profile_function_end(func);
 
-    _optimizer.run(*func);
+    _table.pop_scope();
 
 #ifdef DEBUG
     verify(func);
@@ -528,7 +829,7 @@ void CodeGenLLVM::emit_class_init_method_inner()
 }
 
 void CodeGenLLVM::make_control_flow(llvm::Value *pred, llvm::BasicBlock *&true_block, llvm::BasicBlock *&false_block,
-                                    llvm::BasicBlock *&merge_block)
+                                    llvm::BasicBlock *&merge_block, llvm::MDNode *weights)
 {
     auto *const func = __ GetInsertBlock()->getParent();
 
@@ -536,7 +837,7 @@ void CodeGenLLVM::make_control_flow(llvm::Value *pred, llvm::BasicBlock *&true_b
     false_block = llvm::BasicBlock::Create(_context, Names::comment(Names::Comment::FALSE_BRANCH));
     merge_block = llvm::BasicBlock::Create(_context, Names::comment(Names::Comment::MERGE_BLOCK));
 
-    __ CreateCondBr(pred, true_block, false_block);
+    __ CreateCondBr(pred, true_block, false_block, weights);
 
     __ SetInsertPoint(true_block);
 }
@@ -570,118 +871,263 @@ llvm::Value *CodeGenLLVM::emit_ternary_operator(llvm::Value *pred, llvm::Value *
 llvm::Value *CodeGenLLVM::emit_binary_expr_inner(const ast::BinaryExpression &expr,
                                                  const std::shared_ptr<ast::Type> &expr_type)
 {
+    // arithmetic, comparisons and equality of Int and Bool work with raw values
+    if (!std::holds_alternative<ast::EqExpression>(expr._base) || semant::Semant::is_int(expr._lhs->_type) ||
+        semant::Semant::is_bool(expr._lhs->_type))
+    {
+        return emit_box(emit_binary_value(expr), expr_type);
+    }
+
     auto *lhs = emit_expr(expr._lhs);
 #ifdef LLVM_SHADOW_STACK
     // preserve lhs on stack for gc
-    preserve_value_for_gc(lhs, expr._rhs->_can_allocate);
+    preserve_value_for_gc(lhs, can_allocate(expr._rhs));
 #endif // LLVM_SHADOW_STACK
 
     auto *const rhs = emit_expr(expr._rhs);
 #ifdef LLVM_SHADOW_STACK
-    lhs = reload_value_from_stack(_current_stack_size - 1, lhs, expr._rhs->_can_allocate);
+    lhs = reload_value_from_stack(_current_stack_size - 1, lhs, can_allocate(expr._rhs));
 #endif // LLVM_SHADOW_STACK
 
     DEBUG_ONLY(verify_oop(lhs));
     DEBUG_ONLY(verify_oop(rhs));
 
-    auto logical_result = false;
-    llvm::Value *op_result = nullptr;
-
-    if (!std::holds_alternative<ast::EqExpression>(expr._base))
-    {
-        auto *const lv = emit_load_int(lhs); // load real values
-        auto *const rv = emit_load_int(rhs);
-
-        op_result = std::visit(
-            ast::overloaded{[&](const ast::MinusExpression &minus) { return __ CreateSub(lv, rv); },
-                            [&](const ast::PlusExpression &plus) { return __ CreateAdd(lv, rv); },
-                            [&](const ast::DivExpression &div) { return __ CreateSDiv(lv, rv); },
-                            [&](const ast::MulExpression &mul) { return __ CreateMul(lv, rv); },
-                            [&](const ast::LTExpression &lt) {
-                                logical_result = true;
-                                return emit_ternary_operator(__ CreateICmpSLT(lv, rv), _true_obj, _false_obj);
-                            },
-                            [&](const ast::LEExpression &le) {
-                                logical_result = true;
-                                return emit_ternary_operator(__ CreateICmpSLE(lv, rv), _true_obj, _false_obj);
-                            },
-                            [&](const ast::EqExpression &le) { return static_cast<llvm::Value *>(nullptr); }},
-            expr._base);
-    }
-    else
-    {
-        logical_result = true;
-
-        // cast to void pointers for compare
-        auto *const raw_lhs = __ CreateBitCast(lhs, _runtime.heap_ptr_type());
-        auto *const raw_rhs = __ CreateBitCast(rhs, _runtime.heap_ptr_type());
+    // cast to void pointers for compare
+    auto *const raw_lhs = __ CreateBitCast(lhs, _runtime.heap_ptr_type());
+    auto *const raw_rhs = __ CreateBitCast(rhs, _runtime.heap_ptr_type());
 
-        auto *const is_same_ref = __ CreateICmpEQ(raw_lhs, raw_rhs);
+    auto *const is_same_ref = __ CreateICmpEQ(raw_lhs, raw_rhs);
 
-        // do control flow
-        auto *const func = __ GetInsertBlock()->getParent();
+    // do control flow
+    auto *const func = __ GetInsertBlock()->getParent();
 
-        llvm::BasicBlock *true_block = nullptr, *false_block = nullptr, *merge_block = nullptr;
-        make_control_flow(is_same_ref, true_block, false_block, merge_block);
+    llvm::BasicBlock *true_block = nullptr, *false_block = nullptr, *merge_block = nullptr;
+    make_control_flow(is_same_ref, true_block, false_block, merge_block);
 
-        // true branch - just jump to merge
-        __ SetInsertPoint(true_block);
-        __ CreateBr(merge_block);
+    // true branch - just jump to merge
+    __ SetInsertPoint(true_block);
+    __ CreateBr(merge_block);
 
-        // false branch - runtime call to equals
-        func->getBasicBlockList().push_back(false_block);
-        __ SetInsertPoint(false_block);
+    // false branch - runtime call to equals
+    func->getBasicBlockList().push_back(false_block);
+    __ SetInsertPoint(false_block);
 
-        auto *equals_func = _runtime.symbol_by_id(RuntimeLLVM::RuntimeLLVMSymbols::EQUALS)->_func;
-        auto *const eq_call_res = __ CreateCall(equals_func, {raw_lhs, raw_rhs});
+    auto *equals_func = _runtime.symbol_by_id(RuntimeLLVM::RuntimeLLVMSymbols::EQUALS)->_func;
+    auto *const eq_call_res = __ CreateCall(equals_func, {raw_lhs, raw_rhs});
 
-        auto *const false_branch_res = emit_ternary_operator(
-            __ CreateICmpEQ(eq_call_res, llvm::ConstantInt::get(equals_func->getReturnType(), TrueValue, true)),
-            _true_obj, _false_obj);
+    auto *const false_branch_res = emit_ternary_operator(
+        __ CreateICmpEQ(eq_call_res, llvm::ConstantInt::get(equals_func->getReturnType(), TrueValue, true)), _true_obj,
+        _false_obj);
 
-        false_block = __ GetInsertBlock(); // emit_ternary_operator changed cfg
-        __ CreateBr(merge_block);
+    false_block = __ GetInsertBlock(); // emit_ternary_operator changed cfg
+    __ CreateBr(merge_block);
 
-        // merge results
-        func->getBasicBlockList().push_back(merge_block);
-        __ SetInsertPoint(merge_block);
-        op_result = __ CreatePHI(_true_obj->getType(), 2);
-        static_cast<llvm::PHINode *>(op_result)->addIncoming(_true_obj, true_block);
-        static_cast<llvm::PHINode *>(op_result)->addIncoming(false_branch_res, false_block);
-    }
+    // merge results
+    func->getBasicBlockList().push_back(merge_block);
+    __ SetInsertPoint(merge_block);
+    auto *const op_result = __ CreatePHI(_true_obj->getType(), 2);
+    op_result->addIncoming(_true_obj, true_block);
+    op_result->addIncoming(false_branch_res, false_block);
 
 #ifdef LLVM_SHADOW_STACK
-    if (!ReduceGCSpills || expr._rhs->_can_allocate)
+    if (!ReduceGCSpills || can_allocate(expr._rhs))
     {
         pop_dead_value();
     }
 #endif // LLVM_SHADOW_STACK
 
-    return logical_result ? op_result : emit_allocate_int(op_result);
+    return op_result;
+}
+
+llvm::Value *CodeGenLLVM::emit_binary_value(const ast::BinaryExpression &expr)
+{
+    // Int and Bool objects are immutable, so lhs value can be loaded before rhs evaluation
+    auto *const lv = emit_value(expr._lhs);
+#ifdef LLVM_SHADOW_STACK
+    // semant counts the stack slot for lhs
+    DEBUG_ONLY(hold_raw_slots(1));
+#endif // LLVM_SHADOW_STACK
+    auto *const rv = emit_value(expr._rhs);
+#ifdef LLVM_SHADOW_STACK
+    DEBUG_ONLY(hold_raw_slots(-1));
+#endif // LLVM_SHADOW_STACK
+
+    return std::visit(
+        ast::overloaded{[&](const ast::MinusExpression &minus) { return __ CreateSub(lv, rv); },
+                        [&](const ast::PlusExpression &plus) { return __ CreateAdd(lv, rv); },
+                        [&](const ast::DivExpression &div) { return __ CreateSDiv(lv, rv); },
+                        [&](const ast::MulExpression &mul) { return __ CreateMul(lv, rv); },
+                        [&](const ast::LTExpression &lt) {
+                            return __ CreateSelect(__ CreateICmpSLT(lv, rv), _true_val, _false_val);
+                        },
+                        [&](const ast::LEExpression &le) {
+                            return __ CreateSelect(__ CreateICmpSLE(lv, rv), _true_val, _false_val);
+                        },
+                        [&](const ast::EqExpression &eq) {
+                            return __ CreateSelect(__ CreateICmpEQ(lv, rv), _true_val, _false_val);
+                        }},
+        expr._base);
 }
 
 llvm::Value *CodeGenLLVM::emit_unary_expr_inner(const ast::UnaryExpression &expr,
                                                 const std::shared_ptr<ast::Type> &expr_type)
 {
-    auto *const operand = emit_expr(expr._expr);
+    return emit_box(emit_unary_value(expr), expr_type);
+}
+
+llvm::Value *CodeGenLLVM::emit_unary_value(const ast::UnaryExpression &expr)
+{
+    return std::visit(
+        ast::overloaded{[&](const ast::IsVoidExpression &isvoid) {
+                            // Int and Bool are never void
+                            if (semant::Semant::is_int(expr._expr->_type) || semant::Semant::is_bool(expr._expr->_type))
+                            {
+                                emit_value(expr._expr);
+                                return _false_val;
+                            }
+
+                            auto *const operand = emit_expr(expr._expr);
+                            DEBUG_ONLY(verify_oop(operand));
+
+                            return __ CreateSelect(__ CreateIsNull(operand), _true_val, _false_val);
+                        },
+                        [&](const ast::NotExpression &) { return __ CreateXor(emit_value(expr._expr), _true_val); },
+                        [&](const ast::NegExpression &neg) { return __ CreateNeg(emit_value(expr._expr)); }},
+        expr._base);
+}
 
-    DEBUG_ONLY(verify_oop(operand));
+llvm::Value *CodeGenLLVM::emit_value(const std::shared_ptr<ast::Expression> &expr)
+{
+    GUARANTEE_DEBUG(semant::Semant::is_int(expr->_type) || semant::Semant::is_bool(expr->_type));
 
     return std::visit(
         ast::overloaded{
-            [&](const ast::IsVoidExpression &isvoid) {
-                return emit_ternary_operator(
-                    __ CreateICmpEQ(
-                        operand, llvm::ConstantPointerNull::get(static_cast<llvm::PointerType *>(operand->getType()))),
-                    _true_obj, _false_obj);
+            [&](const ast::IntExpression &number) -> llvm::Value * {
+                return llvm::ConstantInt::get(_runtime.default_int(), number._value, true);
+            },
+            [&](const ast::BoolExpression &boolean) -> llvm::Value * {
+                return boolean._value ? _true_val : _false_val;
+            },
+            [&](const ast::ObjectExpression &object) -> llvm::Value * {
+                const auto &symbol = _table.symbol(object._object);
+                if (symbol._type == Symbol::RAW_LOCAL)
+                {
+                    return __ CreateLoad(_runtime.default_int(), symbol._value._ptr);
+                }
+
+                return emit_unbox(emit_expr(expr), expr->_type);
             },
-            [&](const ast::NotExpression &) {
-                auto *const not_res_val = __ CreateXor(emit_load_bool(operand), _true_val);
+            [&](const ast::BinaryExpression &binary) -> llvm::Value * {
+                // equality of objects calls runtime
+                if (std::holds_alternative<ast::EqExpression>(binary._base) &&
+                    !semant::Semant::is_int(binary._lhs->_type) && !semant::Semant::is_bool(binary._lhs->_type))
+                {
+                    return emit_unbox(emit_expr(expr), expr->_type);
+                }
 
-                return emit_ternary_operator(__ CreateICmpEQ(not_res_val, _true_val), _true_obj, _false_obj);
+                return emit_binary_value(binary);
             },
-            [&](const ast::NegExpression &neg) { return emit_allocate_int(__ CreateNeg(emit_load_int(operand))); }},
-        expr._base);
+            [&](const ast::UnaryExpression &unary) -> llvm::Value * { return emit_unary_value(unary); },
+            [&](const ast::DispatchExpression &dispatch) -> llvm::Value * {
+                return emit_unbox(emit_dispatch(dispatch, expr->_type), expr->_type);
+            },
+            [&](const ast::IfExpression &branch) -> llvm::Value * { return emit_if(branch, expr->_type, true); },
+            [&](const ast::ListExpression &list) -> llvm::Value * {
+                for (auto e = list._exprs.begin(); e != list._exprs.end() - 1; e++)
+                {
+                    emit_unused_expr(*e);
+                }
+
+                return emit_value(list._exprs.back());
+            },
+            [&](const ast::LetExpression &let) -> llvm::Value * {
+                return emit_in_scope(let._object, let._type, let._body_expr, emit_let_initializer(let), true);
+            },
+            [&](const ast::AssignExpression &assign) -> llvm::Value * {
+                const auto &symbol = _table.symbol(assign._object->_object);
+                if (symbol._type == Symbol::RAW_LOCAL)
+                {
+                    auto *const value = emit_value(assign._expr);
+                    __ CreateStore(value, symbol._value._ptr);
+
+                    return value;
+                }
+
+                return emit_unbox(emit_expr(expr), expr->_type);
+            },
+            [&](const auto &) -> llvm::Value * { return emit_unbox(emit_expr(expr), expr->_type); }},
+        expr->_data);
+}
+
+void CodeGenLLVM::emit_unused_expr(const std::shared_ptr<ast::Expression> &expr)
+{
+    // don't box values that are not used
+    if (semant::Semant::is_int(expr->_type) || semant::Semant::is_bool(expr->_type))
+    {
+        emit_value(expr);
+    }
+    else
+    {
+        emit_expr(expr);
+    }
+}
+
+llvm::Value *CodeGenLLVM::emit_box(llvm::Value *value, const std::shared_ptr<ast::Type> &type)
+{
+    if (!value->getType()->isIntegerTy())
+    {
+        return value;
+    }
+
+    if (semant::Semant::is_bool(type))
+    {
+        return __ CreateSelect(__ CreateICmpEQ(value, _true_val), _true_obj, _false_obj);
+    }
+
+    GUARANTEE_DEBUG(semant::Semant::is_int(type));
+    if (auto *const constant = llvm::dyn_cast<llvm::ConstantInt>(value))
+    {
+        return _data.int_const(constant->getSExtValue());
+    }
+
+    // small values are taken from the table of constants, so boxing of the raw results doesn't allocate them
+    auto *const func = __ GetInsertBlock()->getParent();
+
+    auto *const cache = _data.int_cache();
+    auto *const cache_type = llvm::cast<llvm::ArrayType>(cache->getValueType());
+
+    llvm::BasicBlock *true_block = nullptr, *false_block = nullptr, *merge_block = nullptr;
+    make_control_flow(__ CreateICmpULT(value, llvm::ConstantInt::get(value->getType(), DataLLVM::INT_CACHE_SIZE)),
+                      true_block, false_block, merge_block);
+
+    auto *const cached_ptr = __ CreateInBoundsGEP(cache_type, cache, {_int0_64, value});
+    auto *const cached = __ CreateLoad(cache_type->getElementType(), cached_ptr);
+    __ CreateBr(merge_block);
+
+    func->getBasicBlockList().push_back(false_block);
+    __ SetInsertPoint(false_block);
+    auto *const allocated = maybe_cast(emit_allocate_int(value), cache_type->getElementType());
+    false_block = __ GetInsertBlock();
+    __ CreateBr(merge_block);
+
+    func->getBasicBlockList().push_back(merge_block);
+    __ SetInsertPoint(merge_block);
+
+    auto *const boxed = __ CreatePHI(cached->getType(), 2);
+    boxed->addIncoming(cached, true_block);
+    boxed->addIncoming(allocated, false_block);
+
+    return boxed;
+}
+
+llvm::Value *CodeGenLLVM::emit_unbox(llvm::Value *value, const std::shared_ptr<ast::Type> &type)
+{
+    if (value->getType()->isIntegerTy())
+    {
+        return value;
+    }
+
+    return semant::Semant::is_bool(type) ? emit_load_bool(value) : emit_load_int(value);
 }
 
 llvm::Value *CodeGenLLVM::emit_bool_expr(const ast::BoolExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
@@ -707,27 +1153,35 @@ llvm::Value *CodeGenLLVM::emit_object_expr_inner(const ast::ObjectExpression &ex
 {
     const auto &object = _table.symbol(expr._object);
 
-    auto *ptr = static_cast<llvm::Value *>(nullptr);
-    auto type = std::shared_ptr<ast::Type>(nullptr);
+    if (object._type == Symbol::RAW_LOCAL)
+    {
+        return emit_box(__ CreateLoad(_runtime.default_int(), object._value._ptr), object._value_type);
+    }
+
+    auto *local = static_cast<llvm::Value *>(nullptr);
 
     if (object._type == Symbol::FIELD)
     {
-        const auto &klass = _builder->klass(_current_class->_type->_string);
+        const auto &klass = _builder->klass(_current_class->_type);
         const auto &index = object._value._offset;
 
-        ptr = __ CreateStructGEP(_data.class_struct(klass), emit_load_self(), index);
-        type =
+        auto *const ptr = __ CreateStructGEP(_data.class_struct(klass), emit_load_self(), index);
+        const auto type =
             semant::Semant::exact_type(static_pointer_cast<KlassLLVM>(klass)->field_type(index), _current_class->_type);
+
+        auto *const field = __ CreateLoad(
+            _data.class_struct(_builder->klass(type))->getPointerTo(_runtime.HEAP_ADDR_SPACE), ptr);
+        mark_field_access(field, klass, index);
+
+        local = field;
     }
     else
     {
-        ptr = object._value._ptr;
-        type = object._value_type;
+        local = emit_load_slot(
+            object._value._ptr,
+            _data.class_struct(_builder->klass(object._value_type))->getPointerTo(_runtime.HEAP_ADDR_SPACE));
     }
 
-    auto *local =
-        __ CreateLoad(_data.class_struct(_builder->klass(type->_string))->getPointerTo(_runtime.HEAP_ADDR_SPACE), ptr);
-
     DEBUG_ONLY(verify_oop(local));
 
     return local;
@@ -737,9 +1191,9 @@ llvm::Value *CodeGenLLVM::emit_load_self()
 {
     const auto &self_val = _table.symbol(SelfObject);
 
-    auto *self = __ CreateLoad(
-        _data.class_struct(_builder->klass(self_val._value_type->_string))->getPointerTo(_runtime.HEAP_ADDR_SPACE),
-        self_val._value._ptr);
+    auto *self = emit_load_slot(
+        self_val._value._ptr,
+        _data.class_struct(_builder->klass(self_val._value_type))->getPointerTo(_runtime.HEAP_ADDR_SPACE));
 
     DEBUG_ONLY(verify_oop(self));
 
@@ -750,12 +1204,12 @@ llvm::Value *CodeGenLLVM::emit_new_inner_helper(const std::shared_ptr<ast::Type>
 {
     auto *const func = _runtime.symbol_by_id(RuntimeLLVM::RuntimeLLVMSymbols::GC_ALLOC)->_func;
 
-    const auto &klass = _builder->klass(klass_type->_string);
+    const auto &klass = _builder->klass(klass_type);
 
     // prepare tag, size and dispatch table
     auto *const tag = llvm::ConstantInt::get(_runtime.header_elem_type(HeaderLayout::Tag), klass->tag());
     auto *const size = llvm::ConstantInt::get(_runtime.header_elem_type(HeaderLayout::Size), klass->size());
-    auto *const disp_tab = __ CreateBitCast(_data.class_disp_tab(klass), _runtime.void_type()->getPointerTo());
+    auto *const disp_tab = __ CreateBitCast(_data.class_disp_tab(klass), _runtime.int8_type()->getPointerTo());
 
 #ifdef LLVM_STATEPOINT_EXAMPLE
     save_frame();
@@ -798,14 +1252,14 @@ llvm::Value *CodeGenLLVM::emit_new_inner(const std::shared_ptr<ast::Type> &klass
     }
 
     auto *const self_val = emit_load_self();
-    const auto &klass = _builder->klass(_current_class->_type->_string);
+    const auto &klass = _builder->klass(_current_class->_type);
     const auto &klass_struct = _data.class_struct(klass);
 
     // get info about this object
     auto *const tag = emit_load_tag(self_val, klass_struct);
     auto *const size = emit_load_size(self_val, klass_struct);
     auto *const disp_tab =
-        __ CreateBitCast(emit_load_dispatch_table(self_val, klass), _runtime.void_type()->getPointerTo());
+        __ CreateBitCast(emit_load_dispatch_table(self_val, klass), _runtime.int8_type()->getPointerTo());
 
 #ifdef LLVM_STATEPOINT_EXAMPLE
     save_frame();
@@ -828,10 +1282,10 @@ llvm::Value *CodeGenLLVM::emit_new_inner(const std::shared_ptr<ast::Type> &klass
     // load init method and call
     // init method has the same type as for Object class
     auto *const object_init = _module.getFunction(klass->init_method());
-    auto *const init_method = __ CreateLoad(object_init->getType(), init_method_ptr);
+    auto *const init_method = __ CreateLoad(init_method_ptr->getType()->getPointerElementType(), init_method_ptr);
 
     // call this init method
-    __ CreateCall(object_init->getFunctionType(), init_method,
+    __ CreateCall(object_init->getFunctionType(), maybe_cast(init_method, object_init->getType()),
                   {maybe_cast(raw_object, object_init->getArg(0)->getType())});
 
 #ifdef LLVM_SHADOW_STACK
@@ -852,14 +1306,20 @@ llvm::Value *CodeGenLLVM::emit_load_tag(llvm::Value *obj, llvm::Type *obj_type)
 {
     auto *const tag_ptr = __ CreateStructGEP(obj_type, obj, HeaderLayout::Tag);
 
-    return __ CreateLoad(_runtime.header_elem_type(HeaderLayout::Tag), tag_ptr);
+    auto *const tag = __ CreateLoad(_runtime.header_elem_type(HeaderLayout::Tag), tag_ptr);
+    mark_header_access(tag, HeaderLayout::Tag);
+
+    return tag;
 }
 
 llvm::Value *CodeGenLLVM::emit_load_size(llvm::Value *obj, llvm::Type *obj_type)
 {
     auto *const size_ptr = __ CreateStructGEP(obj_type, obj, HeaderLayout::Size);
 
-    return __ CreateLoad(_runtime.header_elem_type(HeaderLayout::Size), size_ptr);
+    auto *const size = __ CreateLoad(_runtime.header_elem_type(HeaderLayout::Size), size_ptr);
+    mark_header_access(size, HeaderLayout::Size);
+
+    return size;
 }
 
 llvm::Value *CodeGenLLVM::emit_load_dispatch_table(llvm::Value *obj, const std::shared_ptr<Klass> &klass)
@@ -867,21 +1327,34 @@ llvm::Value *CodeGenLLVM::emit_load_dispatch_table(llvm::Value *obj, const std::
     auto *const dispatch_table_ptr_ptr =
         __ CreateStructGEP(obj->getType()->getPointerElementType(), obj, HeaderLayout::DispatchTable);
 
-    return __ CreateLoad(_data.class_disp_tab(klass)->getType(), dispatch_table_ptr_ptr);
+    auto *const dispatch_table = __ CreateLoad(_data.class_disp_tab(klass)->getType(), dispatch_table_ptr_ptr);
+    mark_header_access(dispatch_table, HeaderLayout::DispatchTable);
+
+    return dispatch_table;
 }
 
-llvm::Value *CodeGenLLVM::emit_cases_expr_inner(const ast::CaseExpression &expr,
-                                                const std::shared_ptr<ast::Type> &expr_type)
+void CodeGenLLVM::mark_header_access(llvm::LoadInst *load, const HeaderLayout &elem)
 {
-    // TODO: maybe use SwitchInst?
-    auto *const pred = emit_expr(expr._expr);
+    load->setMetadata(llvm::LLVMContext::MD_tbaa, _data.header_tbaa(elem));
+    load->setMetadata(llvm::LLVMContext::MD_invariant_load, llvm::MDNode::get(_context, {}));
+}
 
-    DEBUG_ONLY(verify_oop(pred));
+void CodeGenLLVM::mark_field_access(llvm::Instruction *access, const std::shared_ptr<Klass> &klass, const int &index)
+{
+    access->setMetadata(llvm::LLVMContext::MD_tbaa, _data.field_tbaa(klass, index));
+}
+
+llvm::Value *CodeGenLLVM::emit_cases_expr_inner(const ast::CaseExpression &expr,
+                                                const std::shared_ptr<ast::Type> &expr_type)
+{
+    auto *const pred = emit_expr(expr._expr);
 
-    // we want to generate code for the the most precise cases first, so sort cases by tag
+    DEBUG_ONLY(verify_oop(pred));
+
+    // we want to find the most precise case for every tag, so sort cases by tag
     auto cases = expr._cases;
     std::sort(cases.begin(), cases.end(), [&](const auto &case_a, const auto &case_b) {
-        return _builder->tag(case_b->_type->_string) < _builder->tag(case_a->_type->_string);
+        return _builder->tag(case_b->_type) < _builder->tag(case_a->_type);
     });
 
     // save results and blocks for phi
@@ -889,56 +1362,92 @@ llvm::Value *CodeGenLLVM::emit_cases_expr_inner(const ast::CaseExpression &expr,
 
     auto *const func = __ GetInsertBlock()->getParent();
 
-    auto *const is_not_null = __ CreateIsNotNull(pred);
+    auto *const is_not_null = DoOpts && _nni.is_non_null(expr._expr) ? __ getTrue() : __ CreateIsNotNull(pred);
 
     llvm::BasicBlock *true_block = nullptr, *false_block = nullptr, *merge_block = nullptr;
     make_control_flow(is_not_null, true_block, false_block, merge_block);
 
-    auto *const tag =
-        emit_load_tag(pred, _data.class_struct(_builder->klass(
-                                semant::Semant::exact_type(expr._expr->_type, _current_class->_type)->_string)));
+    const auto &pred_klass =
+        _builder->klass(semant::Semant::exact_type(expr._expr->_type, _current_class->_type));
+
+    auto *const tag = emit_load_tag(pred, _data.class_struct(pred_klass));
+
+    // histogram of the object tags
+    const auto site = profile_site(pred_klass->child_max_tag() - pred_klass->tag() + 1);
+    if (ProfileGenerate)
+    {
+        emit_count(site, __ CreateSub(tag, llvm::ConstantInt::get(tag->getType(), pred_klass->tag())));
+    }
 
     auto *const res_ptr_type =
-        _data.class_struct(_builder->klass(semant::Semant::exact_type(expr_type, _current_class->_type)->_string))
+        _data.class_struct(_builder->klass(semant::Semant::exact_type(expr_type, _current_class->_type)))
             ->getPointerTo(_runtime.HEAP_ADDR_SPACE);
 
     // no, it is not void
-    // Last case is a special case: branch to abort
-    for (auto i = 0; i < cases.size(); i++)
-    {
-        const auto &klass = _builder->klass(cases[i]->_type->_string);
+    // tags are assigned in DFS order, so the branch for every possible tag of the object is known statically:
+    // it is the first case (the most precise) which range contains this tag.
+    // Tag without suitable branch jumps to abort
+    auto *const abort_block = llvm::BasicBlock::Create(_context, Names::comment(Names::Comment::FALSE_BRANCH));
 
-        auto *const tag_type = _runtime.header_elem_type(HeaderLayout::Tag);
+    auto *const switch_inst =
+        __ CreateSwitch(tag, abort_block, pred_klass->child_max_tag() - pred_klass->tag() + 1);
 
-        // if object tag lower than the lowest tag for this branch, jump to next case
-        auto *const less = __ CreateICmpSLT(tag, llvm::ConstantInt::get(tag_type, klass->tag()));
+    auto *const tag_type = llvm::cast<llvm::IntegerType>(_runtime.header_elem_type(HeaderLayout::Tag));
 
-        // if object tag higher that the highest tag for this branch, jump to next case
-        auto *const higher = __ CreateICmpSGT(tag, llvm::ConstantInt::get(tag_type, klass->child_max_tag()));
+    std::vector<llvm::BasicBlock *> match_blocks(cases.size(), nullptr);
+    for (auto obj_tag = pred_klass->tag(); obj_tag <= pred_klass->child_max_tag(); obj_tag++)
+    {
+        const auto match = std::find_if(cases.begin(), cases.end(), [&](const auto &branch) {
+            const auto &klass = _builder->klass(branch->_type);
+            return klass->tag() <= obj_tag && obj_tag <= klass->child_max_tag();
+        });
 
-        auto *const need_next = __ CreateOr(less, higher);
+        if (match != cases.end())
+        {
+            auto &match_block = match_blocks[match - cases.begin()];
+            if (!match_block)
+            {
+                match_block = llvm::BasicBlock::Create(_context, Names::comment(Names::Comment::TRUE_BRANCH));
+            }
 
-        auto *match_block = llvm::BasicBlock::Create(_context, Names::comment(Names::Comment::FALSE_BRANCH));
-        auto *const next_case = llvm::BasicBlock::Create(_context, Names::comment(Names::Comment::TRUE_BRANCH));
+            switch_inst->addCase(llvm::ConstantInt::get(tag_type, obj_tag), match_block);
+        }
+    }
 
-        // TODO: set weight?
-        __ CreateCondBr(need_next, next_case, match_block);
+    // abort is never taken, branches are weighted by the tags of the objects
+    std::vector<uint64_t> counts = {0};
+    for (const auto &tag_case : switch_inst->cases())
+    {
+        counts.push_back(profile_count(site + tag_case.getCaseValue()->getZExtValue() - pred_klass->tag()));
+    }
+
+    if (auto *const weights = branch_weights(counts))
+    {
+        switch_inst->setMetadata(llvm::LLVMContext::MD_prof, weights);
+    }
+
+    for (auto i = 0; i < cases.size(); i++)
+    {
+        // object of this static type never matches this branch
+        if (!match_blocks[i])
+        {
+            continue;
+        }
 
-        func->getBasicBlockList().push_back(match_block);
-        __ SetInsertPoint(match_block);
+        func->getBasicBlockList().push_back(match_blocks[i]);
+        __ SetInsertPoint(match_blocks[i]);
 
         // match branch
         auto *const result = emit_in_scope(cases[i]->_object, cases[i]->_type, cases[i]->_expr, pred);
         auto *const casted_res = __ CreateBitCast(result, res_ptr_type);
-        match_block = __ GetInsertBlock();
-        results.push_back({match_block, casted_res});
+        results.push_back({__ GetInsertBlock(), casted_res});
 
         __ CreateBr(merge_block);
-
-        func->getBasicBlockList().push_back(next_case);
-        __ SetInsertPoint(next_case);
     }
 
+    func->getBasicBlockList().push_back(abort_block);
+    __ SetInsertPoint(abort_block);
+
     auto *const null_result = llvm::ConstantPointerNull::get(res_ptr_type);
 
     // did not find suitable branch
@@ -975,7 +1484,18 @@ llvm::Value *CodeGenLLVM::emit_cases_expr_inner(const ast::CaseExpression &expr,
 llvm::Value *CodeGenLLVM::emit_let_expr_inner(const ast::LetExpression &expr,
                                               const std::shared_ptr<ast::Type> &expr_type)
 {
-    return emit_in_scope(expr._object, expr._type, expr._body_expr, expr._expr ? emit_expr(expr._expr) : nullptr);
+    return emit_in_scope(expr._object, expr._type, expr._body_expr, emit_let_initializer(expr));
+}
+
+llvm::Value *CodeGenLLVM::emit_let_initializer(const ast::LetExpression &expr)
+{
+    // Int and Bool locals are kept as raw values
+    if (DoOpts && (semant::Semant::is_int(expr._type) || semant::Semant::is_bool(expr._type)))
+    {
+        return expr._expr ? emit_value(expr._expr) : llvm::ConstantInt::get(_runtime.default_int(), 0);
+    }
+
+    return expr._expr ? emit_expr(expr._expr) : nullptr;
 }
 
 llvm::Value *CodeGenLLVM::emit_loop_expr_inner(const ast::WhileExpression &expr,
@@ -990,45 +1510,68 @@ llvm::Value *CodeGenLLVM::emit_loop_expr_inner(const ast::WhileExpression &expr,
     __ CreateBr(loop_header);
 
     __ SetInsertPoint(loop_header);
-    __ CreateCondBr(__ CreateICmpEQ(emit_load_bool(emit_expr(expr._predicate)), _true_val), loop_body, loop_tail);
+    auto *const pred = __ CreateICmpEQ(emit_value(expr._predicate), _true_val);
+
+    // iterations and exits of the loop
+    const auto site = profile_site(2);
+    __ CreateCondBr(pred, loop_body, loop_tail, branch_weights({profile_count(site), profile_count(site + 1)}));
     auto *const new_loop_header = __ GetInsertBlock();
 
     func->getBasicBlockList().push_back(loop_body);
     __ SetInsertPoint(loop_body);
-    emit_expr(expr._body_expr);
+    emit_count(site);
+    emit_unused_expr(expr._body_expr);
     __ CreateBr(loop_header);
     loop_body = __ GetInsertBlock();
 
     func->getBasicBlockList().push_back(loop_tail);
     __ SetInsertPoint(loop_tail);
+    emit_count(site + 1);
 
     return llvm::ConstantPointerNull::get(
-        _data.class_struct(_builder->klass(expr_type->_string))->getPointerTo(_runtime.HEAP_ADDR_SPACE));
+        _data.class_struct(_builder->klass(expr_type))->getPointerTo(_runtime.HEAP_ADDR_SPACE));
 }
 
 llvm::Value *CodeGenLLVM::emit_if_expr_inner(const ast::IfExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
+{
+    return emit_if(expr, expr_type, false);
+}
+
+llvm::Value *CodeGenLLVM::emit_if(const ast::IfExpression &expr, const std::shared_ptr<ast::Type> &expr_type,
+                                  bool raw_result)
 {
     // do control flow
     auto *const func = __ GetInsertBlock()->getParent();
 
     auto *const phi_type =
-        _data.class_struct(_builder->klass(semant::Semant::exact_type(expr_type, _current_class->_type)->_string))
-            ->getPointerTo(_runtime.HEAP_ADDR_SPACE);
+        raw_result
+            ? _runtime.default_int()
+            : _data.class_struct(_builder->klass(semant::Semant::exact_type(expr_type, _current_class->_type)))
+                  ->getPointerTo(_runtime.HEAP_ADDR_SPACE);
+    const auto emit_path = [&](const std::shared_ptr<ast::Expression> &path) {
+        return raw_result ? emit_value(path) : __ CreateBitCast(emit_expr(path), phi_type);
+    };
+
+    auto *const pred = __ CreateICmpEQ(emit_value(expr._predicate), _true_val);
 
-    auto *const pred = __ CreateICmpEQ(emit_load_bool(emit_expr(expr._predicate)), _true_val);
+    // taken and not taken branches
+    const auto site = profile_site(2);
 
     llvm::BasicBlock *true_block = nullptr, *false_block = nullptr, *merge_block = nullptr;
-    make_control_flow(pred, true_block, false_block, merge_block);
+    make_control_flow(pred, true_block, false_block, merge_block,
+                      branch_weights({profile_count(site), profile_count(site + 1)}));
 
     // true branch
-    auto *const true_bb_val = __ CreateBitCast(emit_expr(expr._true_path_expr), phi_type);
+    emit_count(site);
+    auto *const true_bb_val = emit_path(expr._true_path_expr);
     __ CreateBr(merge_block);
     true_block = __ GetInsertBlock(); // emit_expr can change cfg
 
     // false branch
     func->getBasicBlockList().push_back(false_block);
     __ SetInsertPoint(false_block);
-    auto *const false_bb_val = __ CreateBitCast(emit_expr(expr._false_path_expr), phi_type);
+    emit_count(site + 1);
+    auto *const false_bb_val = emit_path(expr._false_path_expr);
     __ CreateBr(merge_block);
     false_block = __ GetInsertBlock(); // emit_expr can change cfg
 
@@ -1046,9 +1589,42 @@ llvm::Value *CodeGenLLVM::emit_if_expr_inner(const ast::IfExpression &expr, cons
 
 llvm::Value *CodeGenLLVM::emit_dispatch_expr_inner(const ast::DispatchExpression &expr,
                                                    const std::shared_ptr<ast::Type> &expr_type)
+{
+    return emit_box(emit_dispatch(expr, expr_type), expr_type);
+}
+
+llvm::Value *CodeGenLLVM::emit_dispatch(const ast::DispatchExpression &expr,
+                                        const std::shared_ptr<ast::Type> &expr_type)
 {
     auto *const func = __ GetInsertBlock()->getParent();
 
+    const auto &method_name = *expr._object;
+
+    // find implementations that can be called
+    std::shared_ptr<Klass> target = nullptr;
+    std::vector<DispatchTarget> targets;
+    std::visit(ast::overloaded{[&](const ast::VirtualDispatchExpression &disp) {
+                                   if (DoOpts)
+                                   {
+                                       // CHA: call implementations directly if there are only a few of them
+                                       targets = _builder->dispatch_targets(
+                                           _builder->klass(
+                                               semant::Semant::exact_type(expr._expr->_type, _current_class->_type)),
+                                           method_name._symbol);
+                                       if (targets.size() == 1)
+                                       {
+                                           target = targets.front()._klass;
+                                       }
+                                   }
+                               },
+                               [&](const ast::StaticDispatchExpression &disp) {
+                                   target = _builder->klass(disp._type);
+                               }},
+               expr._base);
+
+    // the only implementation can be called with raw Int and Bool values
+    auto *const unboxed_func = target ? unboxed_method(target, method_name) : nullptr;
+
     int slots_num = 0;
     int expr_args_size = expr._args.size();
     bool cannot_allocate = false;
@@ -1058,6 +1634,16 @@ llvm::Value *CodeGenLLVM::emit_dispatch_expr_inner(const ast::DispatchExpression
     args.push_back(nullptr); // dummy for the first arg
     for (int i = 0; i < expr_args_size; i++)
     {
+        if (unboxed_func && unboxed_func->getArg(i + 1)->getType()->isIntegerTy())
+        {
+            args.push_back(emit_value(expr._args.at(i)));
+#ifdef LLVM_SHADOW_STACK
+            // semant counts the stack slot for every arg
+            DEBUG_ONLY(hold_raw_slots(1));
+#endif // LLVM_SHADOW_STACK
+            continue;
+        }
+
         args.push_back(emit_expr(expr._args.at(i)));
 
         DEBUG_ONLY(verify_oop(args.back()));
@@ -1079,22 +1665,27 @@ llvm::Value *CodeGenLLVM::emit_dispatch_expr_inner(const ast::DispatchExpression
     int n = reload_args(args, expr._expr, expr._args, slots_num);
 
     // pop stack slots now to reduce roots number for mark phase
-    assert(slots_num == expr_args_size);
+    assert(slots_num == std::count_if(args.begin() + 1, args.end(),
+                                      [](const auto *arg) { return !arg->getType()->isIntegerTy(); }));
     assert(n == slots_num);
     pop_dead_value(slots_num);
+    DEBUG_ONLY(hold_raw_slots(slots_num - expr_args_size));
 #endif // LLVM_SHADOW_STACK
 
     auto *const phi_type =
-        _data.class_struct(_builder->klass(semant::Semant::exact_type(expr_type, _current_class->_type)->_string))
-            ->getPointerTo(_runtime.HEAP_ADDR_SPACE);
+        unboxed_func && unboxed_func->getReturnType()->isIntegerTy()
+            ? unboxed_func->getReturnType()
+            : _data.class_struct(_builder->klass(semant::Semant::exact_type(expr_type, _current_class->_type)))
+                  ->getPointerTo(_runtime.HEAP_ADDR_SPACE);
 
-    // check if receiver is null
-    auto *const is_not_null = __ CreateIsNotNull(receiver);
+    // check if receiver is null. Receiver that is never void doesn't need it
+    const auto is_non_null = DoOpts && _nni.is_non_null(expr._expr);
 
     llvm::BasicBlock *true_block = nullptr, *false_block = nullptr, *merge_block = nullptr;
-    make_control_flow(is_not_null, true_block, false_block, merge_block);
-
-    const auto &method_name = expr._object->_object;
+    if (!is_non_null)
+    {
+        make_control_flow(__ CreateIsNotNull(receiver), true_block, false_block, merge_block);
+    }
 
 #ifdef LLVM_STATEPOINT_EXAMPLE
     // String_concat and IO_in_string can cause GC
@@ -1112,15 +1703,15 @@ llvm::Value *CodeGenLLVM::emit_dispatch_expr_inner(const ast::DispatchExpression
     }
 
     // first of all fast check on this methods:
-    if (method_name == StringMethodsNames[CONCAT] || method_name == StringMethodsNames[SUBSTR])
+    if (method_name._object == StringMethodsNames[CONCAT] || method_name._object == StringMethodsNames[SUBSTR])
     {
         // cannot inherit from String - easy check
         need_save = semant::Semant::is_string(disp_class);
     }
-    else if (method_name == IOMethodsNames[IN_STRING] || method_name == IOMethodsNames[IN_INT])
+    else if (method_name._object == IOMethodsNames[IN_STRING] || method_name._object == IOMethodsNames[IN_INT])
     {
         // this class can be inherited from IO - check this
-        auto disp_class_handle = _builder->klass(disp_class->_string);
+        auto disp_class_handle = _builder->klass(disp_class);
         while (disp_class_handle->parent() != nullptr && disp_class_handle->parent()->name() != BaseClassesNames[IO])
         {
             disp_class_handle = disp_class_handle->parent();
@@ -1139,40 +1730,109 @@ llvm::Value *CodeGenLLVM::emit_dispatch_expr_inner(const ast::DispatchExpression
     }
 #endif // LLVM_STATEPOINT_EXAMPLE
 
-    auto *const call = std::visit(
-        ast::overloaded{
-            [&](const ast::VirtualDispatchExpression &disp) {
-                const auto &klass =
-                    _builder->klass(semant::Semant::exact_type(expr._expr->_type, _current_class->_type)->_string);
-
-                auto *const dispatch_table_ptr = emit_load_dispatch_table(receiver, klass);
-
-                // get pointer on method address
-                // method has the same type as in this klass
-                auto *const base_method = _module.getFunction(klass->method_full_name(method_name));
-                auto *const method_ptr = __ CreateStructGEP(_data.class_disp_tab(klass)->getValueType(),
-                                                            dispatch_table_ptr, klass->method_index(method_name));
-
-                // load method
-                auto *const method = __ CreateLoad(base_method->getType(), method_ptr);
+    // args and receiver are evaluated, so only the call can be in tail position
+    _is_tail_call = _tail_calls.contains(&expr);
 
-                maybe_cast(args, base_method->getFunctionType());
-
-                // call
-                return __ CreateCall(base_method->getFunctionType(), method, args);
-            },
-            [&](const ast::StaticDispatchExpression &disp) {
-                auto *const method =
-                    _module.getFunction(_builder->klass(disp._type->_string)->method_full_name(method_name));
+    llvm::Value *call = nullptr;
+    if (unboxed_func)
+    {
+        maybe_cast(args, unboxed_func->getFunctionType());
+        call = emit_call(unboxed_func, args);
+    }
+    else
+    {
+        call = std::visit(
+            ast::overloaded{
+                [&](const ast::VirtualDispatchExpression &disp) -> llvm::Value * {
+                    const auto &klass =
+                        _builder->klass(semant::Semant::exact_type(expr._expr->_type, _current_class->_type));
+
+                    if (target)
+                    {
+                        return emit_direct_call(target, method_name, args, phi_type);
+                    }
+
+                    // histogram of the receiver tags
+                    const auto site = profile_site(klass->child_max_tag() - klass->tag() + 1);
+                    if (ProfileGenerate)
+                    {
+                        auto *const tag = emit_load_tag(receiver, _data.class_struct(klass));
+                        emit_count(site, __ CreateSub(tag, llvm::ConstantInt::get(tag->getType(), klass->tag())));
+                    }
+
+                    // calls of every implementation
+                    std::vector<uint64_t> counts;
+                    for (const auto &impl : targets)
+                    {
+                        uint64_t count = 0;
+                        for (const auto &range : impl._tags)
+                        {
+                            for (auto tag = range.first; tag <= range.second; tag++)
+                            {
+                                count += profile_count(site + tag - klass->tag());
+                            }
+                        }
+                        counts.push_back(count);
+                    }
+
+                    if (DoOpts && targets.size() <= MAX_GUARDED_TARGETS)
+                    {
+                        return emit_guarded_dispatch(klass, targets, true, counts, method_name, args, phi_type);
+                    }
+
+                    if (DoOpts)
+                    {
+                        // speculative devirtualization: hot implementations are called directly, the rest virtually
+                        std::vector<int> order(targets.size());
+                        std::iota(order.begin(), order.end(), 0);
+                        std::stable_sort(order.begin(), order.end(), [&](int l, int r) { return counts[l] > counts[r]; });
+
+                        auto remaining = std::accumulate(counts.begin(), counts.end(), (uint64_t)0);
+
+                        std::vector<DispatchTarget> hot_targets;
+                        std::vector<uint64_t> hot_counts;
+                        for (const auto i : order)
+                        {
+                            if (hot_targets.size() == MAX_GUARDED_TARGETS || !counts[i] ||
+                                counts[i] * 100 < remaining * HOT_TARGET_PERCENT)
+                            {
+                                break;
+                            }
+
+                            hot_targets.push_back(targets[i]);
+                            hot_counts.push_back(counts[i]);
+                            remaining -= counts[i];
+                        }
+
+                        if (!hot_targets.empty())
+                        {
+                            hot_counts.push_back(remaining);
+                            return emit_guarded_dispatch(klass, hot_targets, false, hot_counts, method_name, args,
+                                                         phi_type);
+                        }
+                    }
+
+                    return emit_virtual_call(klass, method_name, args);
+                },
+                [&](const ast::StaticDispatchExpression &disp) -> llvm::Value * {
+                    return emit_direct_call(target, method_name, args, phi_type);
+                }},
+            expr._base);
+    }
+    _is_tail_call = false;
 
-                GUARANTEE_DEBUG(method);
+    auto *const casted_call = maybe_cast(call, phi_type);
+    if (is_non_null)
+    {
+        if (!phi_type->isIntegerTy())
+        {
+            DEBUG_ONLY(verify_oop(casted_call));
+        }
 
-                maybe_cast(args, method->getFunctionType());
+        return casted_call;
+    }
 
-                return __ CreateCall(method, args);
-            }},
-        expr._base);
-    auto *const casted_call = __ CreateBitCast(call, phi_type);
+    true_block = __ GetInsertBlock(); // guarded dispatch creates new blocks
     __ CreateBr(merge_block);
 
     // it is null
@@ -1191,9 +1851,155 @@ llvm::Value *CodeGenLLVM::emit_dispatch_expr_inner(const ast::DispatchExpression
     auto *const phi = __ CreatePHI(phi_type, 2);
 
     phi->addIncoming(casted_call, true_block);
-    phi->addIncoming(llvm::ConstantPointerNull::get(phi_type), false_block);
+    phi->addIncoming(llvm::Constant::getNullValue(phi_type), false_block);
 
-    DEBUG_ONLY(verify_oop(phi));
+    if (!phi_type->isIntegerTy())
+    {
+        DEBUG_ONLY(verify_oop(phi));
+    }
+
+    return phi;
+}
+
+llvm::Value *CodeGenLLVM::emit_direct_call(const std::shared_ptr<Klass> &klass,
+                                           const ast::ObjectExpression &method_name, std::vector<llvm::Value *> args,
+                                           llvm::Type *res_type)
+{
+    // args are boxed, but unboxed method avoids boxing inside of the callee
+    if (auto *const unboxed_func = unboxed_method(klass, method_name))
+    {
+        const auto &method = (klass->methods_begin() + klass->method_index(method_name._symbol))->second;
+        const auto &formals = std::get<ast::MethodFeature>(method->_base)._formals;
+
+        for (auto i = 0; i < formals.size(); i++)
+        {
+            if (unboxed_func->getArg(i + 1)->getType()->isIntegerTy())
+            {
+                args[i + 1] = emit_unbox(args[i + 1], formals[i]->_type);
+            }
+        }
+
+        maybe_cast(args, unboxed_func->getFunctionType());
+
+        return maybe_cast(emit_box(emit_call(unboxed_func, args), method->_type), res_type);
+    }
+
+    auto *const method = _module.getFunction(klass->method_full_name(method_name._object));
+    GUARANTEE_DEBUG(method);
+
+    maybe_cast(args, method->getFunctionType());
+
+    return __ CreateBitCast(emit_call(method, args), res_type);
+}
+
+llvm::Value *CodeGenLLVM::emit_virtual_call(const std::shared_ptr<Klass> &klass,
+                                            const ast::ObjectExpression &method_name, std::vector<llvm::Value *> args)
+{
+    auto *const dispatch_table_ptr = emit_load_dispatch_table(args.front(), klass);
+
+    // get pointer on method address
+    // method has the same type as in this klass
+    auto *const base_method = _module.getFunction(klass->method_full_name(method_name._object));
+    auto *const method_ptr = __ CreateStructGEP(_data.class_disp_tab(klass)->getValueType(), dispatch_table_ptr,
+                                                klass->method_index(method_name._symbol));
+
+    // load method
+    // dispatch tables are constant
+    auto *const method = __ CreateLoad(method_ptr->getType()->getPointerElementType(), method_ptr);
+    method->setMetadata(llvm::LLVMContext::MD_tbaa, _data.disp_tab_tbaa());
+    method->setMetadata(llvm::LLVMContext::MD_invariant_load, llvm::MDNode::get(_context, {}));
+
+    maybe_cast(args, base_method->getFunctionType());
+
+    // call
+    return __ CreateCall(base_method->getFunctionType(), maybe_cast(method, base_method->getType()), args);
+}
+
+llvm::Value *CodeGenLLVM::emit_guarded_dispatch(const std::shared_ptr<Klass> &klass,
+                                                std::vector<DispatchTarget> targets, bool all_targets,
+                                                const std::vector<uint64_t> &counts,
+                                                const ast::ObjectExpression &method_name,
+                                                const std::vector<llvm::Value *> &args, llvm::Type *res_type)
+{
+    auto *const func = __ GetInsertBlock()->getParent();
+
+    const auto tags_num = [](const DispatchTarget &target) {
+        int num = 0;
+        for (const auto &range : target._tags)
+        {
+            num += range.second - range.first + 1;
+        }
+        return num;
+    };
+
+    // the hottest implementation is checked first. Without profile implementation that covers the most tags is
+    // called without a guard
+    std::vector<int> order(targets.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (std::any_of(counts.begin(), counts.end(), [](const auto &count) { return count; }))
+    {
+        std::stable_sort(order.begin(), order.end(), [&](int l, int r) { return counts[l] > counts[r]; });
+    }
+    else
+    {
+        std::stable_sort(order.begin(), order.end(),
+                         [&](int l, int r) { return tags_num(targets[l]) < tags_num(targets[r]); });
+    }
+
+    // calls that are not checked yet: the rest of the targets and the virtual call
+    auto remaining = std::accumulate(counts.begin(), counts.end(), (uint64_t)0);
+
+    auto *const tag_type = _runtime.header_elem_type(HeaderLayout::Tag);
+    auto *const tag = emit_load_tag(args.front(), _data.class_struct(klass));
+
+    auto *const merge_block = llvm::BasicBlock::Create(_context, Names::comment(Names::Comment::MERGE_BLOCK));
+
+    std::vector<std::pair<llvm::BasicBlock *, llvm::Value *>> results;
+    for (auto i = 0; i < targets.size() - all_targets; i++)
+    {
+        const auto &target = targets[order[i]];
+
+        // tag in [first, last] is the same as (tag - first) <= (last - first) for unsigned values
+        llvm::Value *is_target = nullptr;
+        for (const auto &range : target._tags)
+        {
+            auto *const in_range =
+                __ CreateICmpULE(__ CreateSub(tag, llvm::ConstantInt::get(tag_type, range.first)),
+                                 llvm::ConstantInt::get(tag_type, range.second - range.first));
+
+            is_target = is_target ? __ CreateOr(is_target, in_range) : in_range;
+        }
+
+        auto *const call_block = llvm::BasicBlock::Create(_context, Names::comment(Names::Comment::TRUE_BRANCH), func);
+        auto *const next_block = llvm::BasicBlock::Create(_context, Names::comment(Names::Comment::FALSE_BRANCH));
+
+        remaining -= counts[order[i]];
+        __ CreateCondBr(is_target, call_block, next_block, branch_weights({counts[order[i]], remaining}));
+
+        __ SetInsertPoint(call_block);
+        auto *const result = emit_direct_call(target._klass, method_name, args, res_type);
+        results.push_back({__ GetInsertBlock(), result});
+        __ CreateBr(merge_block);
+
+        func->getBasicBlockList().push_back(next_block);
+        __ SetInsertPoint(next_block);
+    }
+
+    // receiver always has a tag from the range of the static type, so the last implementation needs no guard
+    auto *const result = all_targets
+                             ? emit_direct_call(targets[order.back()]._klass, method_name, args, res_type)
+                             : maybe_cast(emit_virtual_call(klass, method_name, args), res_type);
+    results.push_back({__ GetInsertBlock(), result});
+    __ CreateBr(merge_block);
+
+    func->getBasicBlockList().push_back(merge_block);
+    __ SetInsertPoint(merge_block);
+
+    auto *const phi = __ CreatePHI(res_type, results.size());
+    for (const auto &res : results)
+    {
+        phi->addIncoming(res.second, res.first);
+    }
 
     return phi;
 }
@@ -1201,9 +2007,18 @@ llvm::Value *CodeGenLLVM::emit_dispatch_expr_inner(const ast::DispatchExpression
 llvm::Value *CodeGenLLVM::emit_assign_expr_inner(const ast::AssignExpression &expr,
                                                  const std::shared_ptr<ast::Type> &expr_type)
 {
-    auto *const value = emit_expr(expr._expr);
     const auto &symbol = _table.symbol(expr._object->_object);
 
+    if (symbol._type == Symbol::RAW_LOCAL)
+    {
+        auto *const value = emit_value(expr._expr);
+        __ CreateStore(value, symbol._value._ptr);
+
+        return emit_box(value, symbol._value_type);
+    }
+
+    auto *const value = emit_expr(expr._expr);
+
     DEBUG_ONLY(verify_oop(value));
 
     llvm::Type *cast_type = nullptr;
@@ -1217,7 +2032,7 @@ llvm::Value *CodeGenLLVM::emit_assign_expr_inner(const ast::AssignExpression &ex
         }
         else
         {
-            cast_type = _data.class_struct(_builder->klass(symbol._value_type->_string))
+            cast_type = _data.class_struct(_builder->klass(symbol._value_type))
                             ->getPointerTo(_runtime.HEAP_ADDR_SPACE);
         }
 
@@ -1225,28 +2040,35 @@ llvm::Value *CodeGenLLVM::emit_assign_expr_inner(const ast::AssignExpression &ex
     }
     else
     {
-        auto *const klass_struct = _data.class_struct(_builder->klass(_current_class->_type->_string));
+        auto *const klass_struct = _data.class_struct(_builder->klass(_current_class->_type));
 
         cast_type = klass_struct->getElementType(symbol._value._offset);
         store_dst = __ CreateStructGEP(klass_struct, emit_load_self(), symbol._value._offset);
     }
 
-    __ CreateStore(maybe_cast(value, cast_type), store_dst);
+    auto *const store = __ CreateStore(maybe_cast(value, cast_type), store_dst);
+    if (symbol._type == Symbol::FIELD)
+    {
+        mark_field_access(store, _builder->klass(_current_class->_type), symbol._value._offset);
+    }
 
     return value;
 }
 
 llvm::Value *CodeGenLLVM::emit_load_int(llvm::Value *int_obj)
 {
-    return emit_load_primitive(int_obj, _data.class_struct(_builder->klass(BaseClassesNames[BaseClasses::INT])));
+    return emit_load_primitive(int_obj, _builder->klass(BaseClassesNames[BaseClasses::INT]));
 }
 
-llvm::Value *CodeGenLLVM::emit_load_primitive(llvm::Value *obj, llvm::Type *obj_type)
+llvm::Value *CodeGenLLVM::emit_load_primitive(llvm::Value *obj, const std::shared_ptr<Klass> &klass)
 {
+    auto *const obj_type = _data.class_struct(klass);
     const auto &value_ptr = __ CreateStructGEP(obj_type, obj, HeaderLayout::DispatchTable + 1);
 
-    return __ CreateLoad(static_cast<llvm::StructType *>(obj_type)->getElementType(HeaderLayout::DispatchTable + 1),
-                         value_ptr);
+    auto *const value = __ CreateLoad(obj_type->getElementType(HeaderLayout::DispatchTable + 1), value_ptr);
+    mark_field_access(value, klass, HeaderLayout::DispatchTable + 1);
+
+    return value;
 }
 
 llvm::Value *CodeGenLLVM::emit_allocate_primitive(llvm::Value *val, const std::shared_ptr<Klass> &klass)
@@ -1257,7 +2079,7 @@ llvm::Value *CodeGenLLVM::emit_allocate_primitive(llvm::Value *val, const std::s
 
     // record value
     auto *const val_ptr = __ CreateStructGEP(_data.class_struct(klass), obj, HeaderLayout::DispatchTable + 1);
-    __ CreateStore(val, val_ptr);
+    mark_field_access(__ CreateStore(val, val_ptr), klass, HeaderLayout::DispatchTable + 1);
 
     return obj;
 }
@@ -1269,18 +2091,51 @@ llvm::Value *CodeGenLLVM::emit_allocate_int(llvm::Value *val)
 
 llvm::Value *CodeGenLLVM::emit_load_bool(llvm::Value *bool_obj)
 {
-    return emit_load_primitive(bool_obj, _data.class_struct(_builder->klass(BaseClassesNames[BaseClasses::BOOL])));
+    return emit_load_primitive(bool_obj, _builder->klass(BaseClassesNames[BaseClasses::BOOL]));
 }
 
 llvm::Value *CodeGenLLVM::emit_in_scope(const std::shared_ptr<ast::ObjectExpression> &object,
                                         const std::shared_ptr<ast::Type> &object_type,
-                                        const std::shared_ptr<ast::Expression> &expr, llvm::Value *initializer)
+                                        const std::shared_ptr<ast::Expression> &expr, llvm::Value *initializer,
+                                        bool raw_result)
 {
     _table.push_scope();
 
+    if (initializer && initializer->getType()->isIntegerTy())
+    {
+        // raw local lives in the entry block slot, that is not a GC root
+        auto *const func = __ GetInsertBlock()->getParent();
+        llvm::IRBuilder<> entry_builder(&func->getEntryBlock(), func->getEntryBlock().begin());
+
+        auto *const local_val = entry_builder.CreateAlloca(_runtime.default_int());
+        __ CreateStore(initializer, local_val);
+
+        _table.add_symbol(object->_object, Symbol(local_val, object_type, Symbol::RAW_LOCAL));
+
+        // unlike the slots of binary operands and args, semant counts the let slot for any GC
+        DEBUG_ONLY(hold_raw_slots(1));
+
+#ifdef LLVM_SHADOW_STACK
+        const auto has_raw_locals = _has_raw_locals;
+        _has_raw_locals = true;
+#endif // LLVM_SHADOW_STACK
+
+        auto *const result = raw_result ? emit_value(expr) : emit_expr(expr);
+
+#ifdef LLVM_SHADOW_STACK
+        _has_raw_locals = has_raw_locals;
+#endif // LLVM_SHADOW_STACK
+
+        DEBUG_ONLY(hold_raw_slots(-1));
+
+        _table.pop_scope();
+
+        return result;
+    }
+
     const auto local_type = semant::Semant::exact_type(object_type, _current_class->_type);
     auto *const object_ptr_type =
-        _data.class_struct(_builder->klass(local_type->_string))->getPointerTo(_runtime.HEAP_ADDR_SPACE);
+        _data.class_struct(_builder->klass(local_type))->getPointerTo(_runtime.HEAP_ADDR_SPACE);
 
     if (!initializer)
     {
@@ -1301,10 +2156,13 @@ llvm::Value *CodeGenLLVM::emit_in_scope(const std::shared_ptr<ast::ObjectExpress
 
     _table.add_symbol(object->_object, Symbol(local_val, local_type));
 
-    auto *const result = emit_expr(expr);
+    auto *const result = raw_result ? emit_value(expr) : emit_expr(expr);
     _table.pop_scope();
 
-    DEBUG_ONLY(verify_oop(result));
+    if (!raw_result)
+    {
+        DEBUG_ONLY(verify_oop(result));
+    }
 
 #ifdef LLVM_SHADOW_STACK
     pop_dead_value();
@@ -1355,6 +2213,11 @@ void CodeGenLLVM::emit_runtime_main()
     auto *const init_rt = _runtime.symbol_by_id(RuntimeLLVM::INIT_RUNTIME)->_func;
     __ CreateCall(init_rt, {runtime_main->getArg(0), runtime_main->getArg(1)});
 
+    if (ProfileGenerate)
+    {
+        emit_profile_init();
+    }
+
     const auto main_klass = _builder->klass(MainClassName);
 
     // this objects will be preserved in a callee frame
@@ -1368,13 +2231,196 @@ void CodeGenLLVM::emit_runtime_main()
 
     __ CreateRet(_int0_32);
 
-    _optimizer.run(*runtime_main);
-
 #ifdef DEBUG
     verify(runtime_main);
 #endif // DEBUG
 }
 
+void CodeGenLLVM::profile_function_begin(llvm::Function *func)
+{
+    _next_counter = 0;
+    const auto entry = profile_site(1);
+
+    if (ProfileGenerate)
+    {
+        // size of the counters is known only when all functions are emitted
+        if (!_profile_counters)
+        {
+            _profile_counters =
+                new llvm::GlobalVariable(_module, _runtime.int64_type(), false, llvm::GlobalValue::InternalLinkage,
+                                         llvm::ConstantInt::get(_runtime.int64_type(), 0));
+        }
+
+        emit_count(entry);
+    }
+
+    if (_profile)
+    {
+        _function_profile = _profile->counters(func->getName().str());
+        if (_function_profile)
+        {
+            func->setEntryCount(profile_count(entry));
+        }
+    }
+}
+
+void CodeGenLLVM::profile_function_end(llvm::Function *func)
+{
+    if (ProfileGenerate)
+    {
+        _profiled_functions.push_back({func->getName().str(), _next_counter});
+        _function_counters += _next_counter;
+    }
+
+    // function was changed after the profile was collected, so its counts are meaningless
+    if (_function_profile && _function_profile->size() != (size_t)_next_counter)
+    {
+        func->setMetadata(llvm::LLVMContext::MD_prof, nullptr);
+        for (auto &inst : llvm::instructions(func))
+        {
+            inst.setMetadata(llvm::LLVMContext::MD_prof, nullptr);
+        }
+    }
+
+    _function_profile = nullptr;
+}
+
+int CodeGenLLVM::profile_site(int counters_num)
+{
+    const auto counter = _next_counter;
+    _next_counter += counters_num;
+    return counter;
+}
+
+void CodeGenLLVM::emit_count(int counter, llvm::Value *offset)
+{
+    if (!ProfileGenerate)
+    {
+        return;
+    }
+
+    auto *const int64_type = _runtime.int64_type();
+
+    llvm::Value *index = llvm::ConstantInt::get(int64_type, _function_counters + counter);
+    if (offset)
+    {
+        index = __ CreateAdd(index, __ CreateZExt(offset, int64_type));
+    }
+
+    auto *const counter_ptr = __ CreateGEP(int64_type, _profile_counters, index);
+    __ CreateStore(__ CreateAdd(__ CreateLoad(int64_type, counter_ptr), llvm::ConstantInt::get(int64_type, 1)),
+                   counter_ptr);
+}
+
+uint64_t CodeGenLLVM::profile_count(int counter) const
+{
+    return _function_profile && (size_t)counter < _function_profile->size() ? (*_function_profile)[counter] : 0;
+}
+
+llvm::MDNode *CodeGenLLVM::branch_weights(const std::vector<uint64_t> &counts)
+{
+    const auto max = *std::max_element(counts.begin(), counts.end());
+    if (!max)
+    {
+        return nullptr;
+    }
+
+    // weights are 32-bit
+    const auto scale = max / std::numeric_limits<uint32_t>::max() + 1;
+
+    std::vector<uint32_t> weights;
+    for (const auto &count : counts)
+    {
+        weights.push_back(count / scale);
+    }
+
+    return llvm::MDBuilder(_context).createBranchWeights(weights);
+}
+
+void CodeGenLLVM::emit_profile_init()
+{
+    auto *const int64_type = _runtime.int64_type();
+
+    // all functions are emitted, so the counters can be allocated
+    auto *const counters_type = llvm::ArrayType::get(int64_type, _function_counters);
+    auto *const counters =
+        new llvm::GlobalVariable(_module, counters_type, false, llvm::GlobalValue::InternalLinkage,
+                                 llvm::ConstantAggregateZero::get(counters_type), PROFILE_COUNTERS_NAME);
+
+    _profile_counters->replaceAllUsesWith(llvm::ConstantExpr::getBitCast(counters, _profile_counters->getType()));
+    _profile_counters->eraseFromParent();
+    _profile_counters = counters;
+
+    // names of the functions for the profile
+    auto *const func_type = llvm::StructType::get(_runtime.int8_type()->getPointerTo(), int64_type);
+
+    std::vector<llvm::Constant *> funcs;
+    for (const auto &[name, num] : _profiled_functions)
+    {
+        funcs.push_back(llvm::ConstantStruct::get(
+            func_type, {__ CreateGlobalStringPtr(name), llvm::ConstantInt::get(int64_type, num)}));
+    }
+
+    auto *const funcs_type = llvm::ArrayType::get(func_type, funcs.size());
+    auto *const funcs_table =
+        new llvm::GlobalVariable(_module, funcs_type, true, llvm::GlobalValue::InternalLinkage,
+                                 llvm::ConstantArray::get(funcs_type, funcs), PROFILE_FUNCTIONS_NAME);
+
+    auto *const init_profile = _runtime.symbol_by_id(RuntimeLLVM::INIT_PROFILE)->_func;
+    __ CreateCall(init_profile, {__ CreateBitCast(funcs_table, _runtime.int8_type()->getPointerTo()),
+                                 llvm::ConstantInt::get(_runtime.int32_type(), funcs.size()),
+                                 __ CreateBitCast(counters, int64_type->getPointerTo())});
+}
+
+void CodeGenLLVM::emit_runtime_fast_paths()
+{
+    // available_externally bodies are visible only to the optimizer: they are not emitted into the object file,
+    // so calls that were not inlined and dispatch tables still refer to the runtime library
+    const auto define_body = [this](const std::string &name) -> llvm::Function * {
+        auto *const func = _module.getFunction(name);
+        if (!func || !func->isDeclaration())
+        {
+            return nullptr;
+        }
+
+        func->setLinkage(llvm::GlobalValue::AvailableExternallyLinkage);
+        __ SetInsertPoint(llvm::BasicBlock::Create(_context, Names::comment(Names::Comment::ENTRY_BLOCK), func));
+
+        return func;
+    };
+
+    // Object_type_name: class_nameTab[tag - 1], because tag 0 is reserved
+    const auto &object_klass = _builder->klass(BaseClassesNames[BaseClasses::OBJECT]);
+    if (auto *const func = define_body(object_klass->method_full_name(ObjectMethodsNames[ObjectMethods::TYPE_NAME])))
+    {
+        auto *const name_tab =
+            _module.getGlobalVariable(_runtime.symbol_name(RuntimeLLVM::RuntimeLLVMSymbols::CLASS_NAME_TAB));
+        GUARANTEE_DEBUG(name_tab);
+
+        auto *const tag = emit_load_tag(func->getArg(0), _data.class_struct(object_klass));
+        auto *const index = __ CreateSub(tag, llvm::ConstantInt::get(tag->getType(), 1));
+
+        auto *const name_tab_type = llvm::cast<llvm::ArrayType>(name_tab->getValueType());
+        auto *const name_ptr =
+            __ CreateInBoundsGEP(name_tab_type, name_tab, {llvm::ConstantInt::get(tag->getType(), 0), index});
+
+        __ CreateRet(maybe_cast(__ CreateLoad(name_tab_type->getElementType(), name_ptr), func->getReturnType()));
+    }
+
+    // String_length: just a length field
+    const auto &string_klass = _builder->klass(BaseClassesNames[BaseClasses::STRING]);
+    if (auto *const func = define_body(string_klass->method_full_name(StringMethodsNames[StringMethods::LENGTH])))
+    {
+        auto *const string_struct = _data.class_struct(string_klass);
+        auto *const length_ptr = __ CreateStructGEP(string_struct, func->getArg(0), HeaderLayout::DispatchTable + 1);
+
+        auto *const length = __ CreateLoad(string_struct->getElementType(HeaderLayout::DispatchTable + 1), length_ptr);
+        mark_field_access(length, string_klass, HeaderLayout::DispatchTable + 1);
+
+        __ CreateRet(maybe_cast(length, func->getReturnType()));
+    }
+}
+
 #define EXIT_ON_ERROR(cond, error)                                                                                     \
     if (!cond)                                                                                                         \
     {                                                                                                                  \
@@ -1382,52 +2428,379 @@ void CodeGenLLVM::emit_runtime_main()
         exit(-1);                                                                                                      \
     }
 
-void CodeGenLLVM::execute_linker(const std::string &object_file_name, const std::string &out_file_name)
+llvm::TargetMachine *CodeGenLLVM::make_target_machine(const llvm::Target *target, const std::string &target_triple,
+                                                      const std::pair<std::string, std::string> &arch_spec)
 {
-    CODEGEN_VERBOSE_ONLY(LOG("Run linker for " + object_file_name + "."));
+    static const llvm::CodeGenOpt::Level codegen_levels[] = {llvm::CodeGenOpt::None, llvm::CodeGenOpt::Less,
+                                                             llvm::CodeGenOpt::Default, llvm::CodeGenOpt::Aggressive};
 
-    const auto coolc_path = boost::dll::program_location().parent_path().string();
-    const auto rt_lib_path =
-        coolc_path + boost::filesystem::path::preferred_separator + static_cast<std::string>(RUNTIME_LIB_NAME);
-    CODEGEN_VERBOSE_ONLY(LOG("Runtime library path: " + rt_lib_path));
+    auto *const target_machine = target->createTargetMachine(
+        target_triple, arch_spec.second, arch_spec.first, llvm::TargetOptions(),
+        llvm::Optional<llvm::Reloc::Model>(llvm::Reloc::Model::PIC_), llvm::None, codegen_levels[OptLevel]);
+    if (target_machine && OptLevel == 0)
+    {
+        // quick builds: prefer compile time over code quality
+        target_machine->setFastISel(true);
+    }
 
-    std::string error;
+    return target_machine;
+}
+
+llvm::Error CodeGenLLVM::emit_object(llvm::Module &module, llvm::TargetMachine *target_machine,
+                                     llvm::SmallVectorImpl<char> &obj)
+{
+    // object is patched before it gets to the disk or JIT, so emit it in memory
+    llvm::raw_svector_ostream os(obj);
+
+    llvm::legacy::PassManager pass;
+    if (target_machine->addPassesToEmitFile(pass, os, nullptr, llvm::CGFT_ObjectFile))
+    {
+        return llvm::createStringError(llvm::inconvertibleErrorCode(), "TargetMachine can't emit a file of this type!");
+    }
+
+    pass.run(module);
+
+#ifdef LLVM_STATEPOINT_EXAMPLE
+    return rename_stackmap_section(obj);
+#else
+    return llvm::Error::success();
+#endif // LLVM_STATEPOINT_EXAMPLE
+}
+
+llvm::Error CodeGenLLVM::emit_object(llvm::Module &module, llvm::TargetMachine *target_machine,
+                                     const std::string &obj_file)
+{
+    CODEGEN_VERBOSE_ONLY(LOG("Run llvm emitter for " + obj_file + "."));
+
+    llvm::SmallVector<char, 0> obj;
+    if (auto err = emit_object(module, target_machine, obj))
+    {
+        return err;
+    }
+
+    // open object file
+    std::error_code ec;
+    llvm::raw_fd_ostream dest(obj_file, ec);
+    if (ec)
+    {
+        return llvm::createStringError(ec, "Could not open file: " + ec.message());
+    }
+
+    dest.write(obj.data(), obj.size());
+    dest.close();
+    if (dest.has_error())
+    {
+        return llvm::createStringError(dest.error(), "Could not write file: " + dest.error().message());
+    }
+
+    CODEGEN_VERBOSE_ONLY(LOG("Finished llvm emitter for " + obj_file + "."));
+
+    return llvm::Error::success();
+}
+
+#ifdef LLVM_STATEPOINT_EXAMPLE
+template <class ELFT> static llvm::Error rename_elf_section(llvm::SmallVectorImpl<char> &obj, llvm::StringRef from,
+                                                            llvm::StringRef to)
+{
+    // new name is a suffix of the old one, so section can point to the middle of the same string in string table
+    GUARANTEE_DEBUG(from.endswith(to));
+
+    auto file = llvm::object::ELFFile<ELFT>::create(llvm::StringRef(obj.data(), obj.size()));
+    if (!file)
+    {
+        return file.takeError();
+    }
+
+    auto sections = file->sections();
+    if (!sections)
+    {
+        return sections.takeError();
+    }
+
+    for (const auto &section : *sections)
+    {
+        auto name = file->getSectionName(section);
+        if (!name)
+        {
+            return name.takeError();
+        }
+
+        if (*name == from)
+        {
+            // section headers are in obj
+            auto &header = const_cast<typename ELFT::Shdr &>(section);
+            header.sh_name = header.sh_name + (from.size() - to.size());
+        }
+    }
+
+    return llvm::Error::success();
+}
+
+llvm::Error CodeGenLLVM::rename_stackmap_section(llvm::SmallVectorImpl<char> &obj)
+{
+    const auto from = static_cast<llvm::StringRef>(STACKMAP_SECTION_NAME);
+    const auto to = static_cast<llvm::StringRef>(STACKMAP_LINKER_SECTION_NAME);
+
+    const auto type = llvm::object::getElfArchType(llvm::StringRef(obj.data(), obj.size()));
+
+    if (type.first == llvm::ELF::ELFCLASS64 && type.second == llvm::ELF::ELFDATA2LSB)
+    {
+        return rename_elf_section<llvm::object::ELF64LE>(obj, from, to);
+    }
+    else if (type.first == llvm::ELF::ELFCLASS64 && type.second == llvm::ELF::ELFDATA2MSB)
+    {
+        return rename_elf_section<llvm::object::ELF64BE>(obj, from, to);
+    }
+    else if (type.first == llvm::ELF::ELFCLASS32 && type.second == llvm::ELF::ELFDATA2LSB)
+    {
+        return rename_elf_section<llvm::object::ELF32LE>(obj, from, to);
+    }
+    else if (type.first == llvm::ELF::ELFCLASS32 && type.second == llvm::ELF::ELFDATA2MSB)
+    {
+        return rename_elf_section<llvm::object::ELF32BE>(obj, from, to);
+    }
 
-    // TODO: are you serious?
-    // TODO: here is the problem of MacOS with M1 processor support...
+    return llvm::createStringError(llvm::inconvertibleErrorCode(), "Only ELF object files are supported!");
+}
+#endif // LLVM_STATEPOINT_EXAMPLE
+
+std::vector<std::string> CodeGenLLVM::emit_partitions(const llvm::Target *target, const std::string &target_triple,
+                                                      const std::pair<std::string, std::string> &arch_spec,
+                                                      const std::string &out_file)
+{
+    std::vector<std::string> obj_files;
+    llvm::ThreadPool pool(llvm::hardware_concurrency(CodeGenThreads));
+    // the tasks must not exit the process under the feet of each other, so they return the error message
+    std::vector<std::shared_future<std::string>> statuses;
+
+    std::optional<ObjectCache> cache;
+    if (!ObjectCacheDir.empty())
+    {
+        cache.emplace(ObjectCacheDir);
+    }
+    auto target_desc = target_triple + " " + arch_spec.second + " " + arch_spec.first + " " + std::to_string(OptLevel);
 #ifdef LLVM_STATEPOINT_EXAMPLE
-    CODEGEN_VERBOSE_ONLY(
-        LOG("Globalize " + static_cast<std::string>(STACKMAP_NAME) + " for " + object_file_name + "."));
-    const auto objcopy_path = llvm::sys::findProgramByName(static_cast<std::string>(OBJCOPY_EXE_NAME));
-    EXIT_ON_ERROR(objcopy_path, "Can't find " + static_cast<std::string>(OBJCOPY_EXE_NAME));
-    CODEGEN_VERBOSE_ONLY(LOG(static_cast<std::string>(OBJCOPY_EXE_NAME) + " library path: " + objcopy_path.get()));
-    EXIT_ON_ERROR(
-        (llvm::sys::ExecuteAndWait(objcopy_path.get(),
-                                   {objcopy_path.get(), "--globalize-symbol=" + static_cast<std::string>(STACKMAP_NAME),
-                                    object_file_name, object_file_name}, // first arg is file name
-                                   llvm::None, {}, 0, 0, &error) == 0),
-        error);
+    // cached objects already have the linker name of stack maps section
+    target_desc += " " + static_cast<std::string>(STACKMAP_LINKER_SECTION_NAME);
 #endif // LLVM_STATEPOINT_EXAMPLE
 
+    const auto emit_partition = [&](std::unique_ptr<llvm::Module> partition) {
+        // local names don't get to object file, so drop them: partitions of the unchanged classes are the same then
+        for (auto &func : *partition)
+        {
+            for (auto &arg : func.args())
+            {
+                arg.setName("");
+            }
+            for (auto &block : func)
+            {
+                block.setName("");
+                for (auto &inst : block)
+                {
+                    inst.setName("");
+                }
+            }
+        }
+
+        llvm::SmallString<0> bitcode;
+        llvm::raw_svector_ostream os(bitcode);
+        llvm::WriteBitcodeToFile(*partition, os);
+
+        obj_files.push_back(out_file + "." + std::to_string(obj_files.size()) + static_cast<std::string>(EXT));
+
+        const auto key = cache ? ObjectCache::key(bitcode.str(), target_desc) : std::string();
+        if (cache && cache->load(key, obj_files.back()))
+        {
+            CODEGEN_VERBOSE_ONLY(LOG("Found " + obj_files.back() + " in cache."));
+            return;
+        }
+
+        statuses.push_back(pool.async(
+            [target, &target_triple, &arch_spec, &cache](const llvm::SmallString<0> &bitcode,
+                                                         const std::string &obj_file,
+                                                         const std::string &key) -> std::string {
+                llvm::LLVMContext context;
+                auto module = llvm::parseBitcodeFile(llvm::MemoryBufferRef(bitcode.str(), obj_file), context);
+                if (!module)
+                {
+                    return llvm::toString(module.takeError());
+                }
+
+                const std::unique_ptr<llvm::TargetMachine> target_machine(
+                    make_target_machine(target, target_triple, arch_spec));
+                if (!target_machine)
+                {
+                    return "Can't create target machine!";
+                }
+
+                if (auto err = emit_object(**module, target_machine.get(), obj_file))
+                {
+                    return llvm::toString(std::move(err));
+                }
+
+                if (cache)
+                {
+                    cache->store(key, obj_file);
+                }
+
+                return std::string();
+            },
+            std::move(bitcode), obj_files.back(), key));
+    };
+
+    // LLVMContext is not thread safe, so every partition is passed as a bitcode to its own context
+    if (cache)
+    {
+        split_by_classes(emit_partition);
+    }
+    else
+    {
+        llvm::SplitModule(_module, CodeGenThreads, emit_partition,
+                          false /* externalize local symbols, so partitions are balanced */);
+    }
+
+    pool.wait();
+
+    for (const auto &status : statuses)
+    {
+        EXIT_ON_ERROR(status.get().empty(), status.get());
+    }
+
+    return obj_files;
+}
+
+void CodeGenLLVM::split_by_classes(const std::function<void(std::unique_ptr<llvm::Module>)> &callback)
+{
+    // partitions refer to symbols of each other by names
+    for (auto &global : _module.global_values())
+    {
+        if (!global.hasName())
+        {
+            global.setName("unnamed");
+        }
+    }
+
+    const auto klass_of = [this](const llvm::GlobalValue *global) -> std::string {
+        const auto klass = _function_klass.find(global->getName().str());
+        return klass != _function_klass.end() ? klass->second : std::string();
+    };
+
+    // the first one is the data partition
+    std::vector<std::string> partitions = {std::string()};
+    for (const auto &klass : _builder->klasses())
+    {
+        partitions.push_back(klass->name());
+    }
+
+    // local symbols of the module, that are used by other partitions than their own
+    std::unordered_set<std::string> shared_locals;
+    std::vector<std::unique_ptr<llvm::Module>> modules;
+
+    for (const auto &partition_klass : partitions)
+    {
+        const auto has_code = std::any_of(_module.begin(), _module.end(), [&](const llvm::Function &func) {
+            return !func.isDeclaration() && klass_of(&func) == partition_klass;
+        });
+        if (!has_code && !partition_klass.empty())
+        {
+            continue;
+        }
+
+        llvm::ValueToValueMapTy vmap;
+        auto partition = llvm::CloneModule(_module, vmap, [&](const llvm::GlobalValue *global) {
+            return klass_of(global) == partition_klass;
+        });
+
+        // partition depends only on symbols it uses
+        for (auto func = partition->begin(); func != partition->end();)
+        {
+            auto &this_func = *func++;
+            if (this_func.isDeclaration() && this_func.use_empty())
+            {
+                this_func.eraseFromParent();
+            }
+        }
+
+        for (auto global = partition->global_begin(); global != partition->global_end();)
+        {
+            auto &this_global = *global++;
+            if (this_global.isDeclaration() && this_global.use_empty())
+            {
+                this_global.eraseFromParent();
+            }
+        }
+
+        // CloneModule declares symbols of other partitions as external
+        for (const auto &global : partition->global_values())
+        {
+            if (global.isDeclaration() && _module.getNamedValue(global.getName())->hasLocalLinkage())
+            {
+                shared_locals.insert(global.getName().str());
+            }
+        }
+
+        modules.push_back(std::move(partition));
+    }
+
+    // only partitions see the promoted symbols: the optimized module is unchanged and local symbols, that are used by one
+    // partition, stay local in it
+    for (auto &partition : modules)
+    {
+        for (auto &global : partition->global_values())
+        {
+            if (shared_locals.contains(global.getName().str()))
+            {
+                global.setLinkage(llvm::GlobalValue::ExternalLinkage);
+                global.setVisibility(llvm::GlobalValue::HiddenVisibility);
+            }
+        }
+
+        callback(std::move(partition));
+    }
+}
+
+std::string CodeGenLLVM::runtime_lib_path(const std::string_view &name)
+{
+    const auto coolc_path = boost::dll::program_location().parent_path().string();
+    return coolc_path + boost::filesystem::path::preferred_separator + static_cast<std::string>(name);
+}
+
+void CodeGenLLVM::execute_linker(const std::vector<std::string> &object_files, const std::string &out_file_name)
+{
+    CODEGEN_VERBOSE_ONLY(LOG("Run linker for " + out_file_name + "."));
+
+    // static runtime saves dynamic symbols resolution at startup and PLT calls
+    const auto rt_lib_path = runtime_lib_path(StaticRuntime ? RUNTIME_STATIC_LIB_NAME : RUNTIME_LIB_NAME);
+    CODEGEN_VERBOSE_ONLY(LOG("Runtime library path: " + rt_lib_path));
+
+    std::string error;
+
     const auto clang_path = llvm::sys::findProgramByName(static_cast<std::string>(CLANG_EXE_NAME));
     EXIT_ON_ERROR(clang_path, "Can't find " + static_cast<std::string>(CLANG_EXE_NAME));
     CODEGEN_VERBOSE_ONLY(LOG(static_cast<std::string>(CLANG_EXE_NAME) + " library path: " + clang_path.get()));
 
     // create executable
-    EXIT_ON_ERROR((llvm::sys::ExecuteAndWait(clang_path.get(),
-                                             {clang_path.get(), object_file_name, rt_lib_path,
+    std::vector<llvm::StringRef> linker_args = {clang_path.get()}; // first arg is file name
+    linker_args.insert(linker_args.end(), object_files.begin(), object_files.end());
+    linker_args.insert(linker_args.end(), {rt_lib_path,
 #ifdef ASAN
-                                              "-fsanitize=address", "-fno-omit-frame-pointer",
+                                           "-fsanitize=address", "-fno-omit-frame-pointer",
 #elif UBSAN
-                                              "-fsanitize=undefined", "-fno-omit-frame-pointer",
+                                           "-fsanitize=undefined", "-fno-omit-frame-pointer",
 #endif // UBSAN
+                                           "-o", out_file_name});
 
-                                              "-o", out_file_name}, // first arg is file name
-                                             llvm::None, {}, 0, 0, &error) == 0),
-                  error);
+    {
+        PhaseTimer timer("link");
+        EXIT_ON_ERROR((llvm::sys::ExecuteAndWait(clang_path.get(), linker_args, llvm::None, {}, 0, 0, &error) == 0),
+                      error);
+    }
 
-    // delete object file
-    std::filesystem::remove(object_file_name);
+    // delete object files
+    for (const auto &object_file_name : object_files)
+    {
+        std::filesystem::remove(object_file_name);
+    }
 
     CODEGEN_VERBOSE_ONLY(LOG("Finish linker for " + out_file_name + "."));
 }
@@ -1469,18 +2842,34 @@ void CodeGenLLVM::emit(const std::string &out_file)
 {
     const std::string obj_file = out_file + static_cast<std::string>(EXT);
 
-    _data.emit(obj_file);
+    if (!ProfileUseFile.empty())
+    {
+        _profile = Profile::load(ProfileUseFile);
+        EXIT_ON_ERROR(_profile, "Can't read profile " + ProfileUseFile + "!");
 
-    emit_class_code(_builder->root()); // emit
-    emit_runtime_main();
+        // optimizer finds hot and cold code by the summary
+        _module.setProfileSummary(_profile->summary()->getMD(_context), llvm::ProfileSummary::PSK_Instr);
+    }
 
-    CODEGEN_VERBOSE_ONLY(_module.print(llvm::errs(), nullptr););
+    {
+        PhaseTimer timer("data");
+        _data.emit(obj_file);
+    }
 
-#ifdef LLVM_STATEPOINT_EXAMPLE
-    llvm::legacy::PassManager rwstpts;
-    rwstpts.add(llvm::createRewriteStatepointsForGCLegacyPass());
-    rwstpts.run(_module);
-#endif // LLVM_STATEPOINT_EXAMPLE
+    if (DoOpts)
+    {
+        PhaseTimer timer("nni");
+        _nni.run();
+    }
+
+    {
+        PhaseTimer timer("emit class code");
+        emit_class_code(_builder->root()); // emit
+        emit_runtime_main();
+        emit_runtime_fast_paths();
+    }
+
+    CODEGEN_VERBOSE_ONLY(_module.print(llvm::errs(), nullptr););
 
     const auto target_triple = llvm::sys::getDefaultTargetTriple();
     CODEGEN_VERBOSE_ONLY(LOG("Target arch: " + target_triple));
@@ -1490,11 +2879,10 @@ void CodeGenLLVM::emit(const std::string &out_file)
     CODEGEN_VERBOSE_ONLY(LOG("Target CPU: " + arch_spec.second));
     CODEGEN_VERBOSE_ONLY(LOG("Target Features: " + arch_spec.first));
 
-    llvm::InitializeAllTargetInfos();
-    llvm::InitializeAllTargets();
-    llvm::InitializeAllTargetMCs();
-    llvm::InitializeAllAsmParsers();
-    llvm::InitializeAllAsmPrinters();
+    // code is generated for the host only
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmParser();
+    llvm::InitializeNativeTargetAsmPrinter();
 
     CODEGEN_VERBOSE_ONLY(LOG("Initialized llvm emitter."));
 
@@ -1504,9 +2892,7 @@ void CodeGenLLVM::emit(const std::string &out_file)
 
     CODEGEN_VERBOSE_ONLY(LOG("Found target: " + std::string(target->getName())));
 
-    auto *const target_machine =
-        target->createTargetMachine(target_triple, arch_spec.second, arch_spec.first, llvm::TargetOptions(),
-                                    llvm::Optional<llvm::Reloc::Model>(llvm::Reloc::Model::PIC_));
+    auto *const target_machine = make_target_machine(target, target_triple, arch_spec);
     EXIT_ON_ERROR(target_machine, "Can't create target machine!");
 
     _module.setDataLayout(target_machine->createDataLayout());
@@ -1514,24 +2900,84 @@ void CodeGenLLVM::emit(const std::string &out_file)
 
     CODEGEN_VERBOSE_ONLY(LOG("Initialized target machine."));
 
-    // open object file
-    std::error_code ec;
-    llvm::raw_fd_ostream dest(obj_file, ec);
-    EXIT_ON_ERROR(!ec, "Could not open file: " + ec.message());
+    // pass managers time every pass themselves
+    llvm::TimePassesIsEnabled = TimePhases;
 
-    llvm::legacy::PassManager pass;
-    EXIT_ON_ERROR(!target_machine->addPassesToEmitFile(pass, dest, nullptr, llvm::CGFT_ObjectFile),
-                  "TargetMachine can't emit a file of this type!");
+    {
+        PhaseTimer timer("optimizer");
+        optimize(target_machine);
+    }
 
-    CODEGEN_VERBOSE_ONLY(LOG("Run llvm emitter."));
+    CODEGEN_VERBOSE_ONLY(LOG("Finished optimizer."));
 
-    pass.run(_module);
-    dest.flush();
-    dest.close();
+    if (RunInJit)
+    {
+        llvm::SmallVector<char, 0> obj;
+        {
+            PhaseTimer timer("object emission");
+            auto err = emit_object(_module, target_machine, obj);
+            EXIT_ON_ERROR(!err, llvm::toString(std::move(err)));
+        }
 
-    CODEGEN_VERBOSE_ONLY(LOG("Finished llvm emitter."));
+        PhaseTimer timer("jit link");
+#ifdef LLVM_STATEPOINT_EXAMPLE
+        const auto stackmaps_section = static_cast<std::string>(STACKMAP_LINKER_SECTION_NAME);
+#else
+        const std::string stackmaps_section;
+#endif // LLVM_STATEPOINT_EXAMPLE
+        _jit = std::make_unique<Jit>(runtime_lib_path(RUNTIME_JIT_LIB_NAME), stackmaps_section);
+        _jit->link(std::make_unique<llvm::SmallVectorMemoryBuffer>(std::move(obj), out_file, false));
 
-    execute_linker(obj_file, out_file);
+        delete target_machine;
+        return;
+    }
+
+    // the whole program is optimized at once, so inliner and IPO passes see all classes
+    std::vector<std::string> obj_files;
+    {
+        PhaseTimer timer("object emission");
+        if (CodeGenThreads > 1 || !ObjectCacheDir.empty())
+        {
+            obj_files = emit_partitions(target, target_triple, arch_spec, out_file);
+        }
+        else
+        {
+            auto err = emit_object(_module, target_machine, obj_file);
+            EXIT_ON_ERROR(!err, llvm::toString(std::move(err)));
+            obj_files = {obj_file};
+        }
+    }
+
+    if (TimePhases)
+    {
+        PhaseTimer::add_report("codegen passes", pass_timings());
+    }
+
+    execute_linker(obj_files, out_file);
 
     delete target_machine;
 }
+
+int CodeGenLLVM::run(const std::vector<std::string> &args)
+{
+    assert(_jit);
+    return _jit->run(args);
+}
+
+std::string CodeGenLLVM::pass_timings()
+{
+    std::string timings;
+    llvm::raw_string_ostream os(timings);
+
+    if (TimePhasesJSON)
+    {
+        os << "{";
+        llvm::TimerGroup::printAllJSONValues(os, "");
+        os << "}";
+    }
+
+    // legacy pass manager of the machine code generation collects timings of all threads in one place
+    llvm::reportAndResetTimings(TimePhasesJSON ? &llvm::nulls() : &os);
+
+    return os.str();
+}
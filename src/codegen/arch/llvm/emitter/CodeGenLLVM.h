@@ -1,9 +1,15 @@
+#include "codegen/arch/llvm/emitter/cache/ObjectCache.h"
 #include "codegen/arch/llvm/emitter/data/DataLLVM.h"
+#include "codegen/arch/llvm/emitter/jit/Jit.h"
+#include "codegen/arch/llvm/emitter/opt/nni/NNI.hpp"
+#include "codegen/arch/llvm/emitter/pgo/Profile.h"
 #include "codegen/arch/llvm/klass/KlassLLVM.h"
 #include "codegen/arch/llvm/symtab/SymbolTableLLVM.h"
 #include "codegen/emitter/CodeGen.h"
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/LegacyPassManager.h>
+#include <llvm/Target/TargetMachine.h>
+#include <unordered_set>
 
 namespace codegen
 {
@@ -13,11 +19,24 @@ class CodeGenLLVM : public CodeGen<llvm::Value *, Symbol>
     static constexpr std::string_view RUNTIME_MAIN_FUNC = "main";
     static constexpr std::string_view EXT = ".o";
     static constexpr std::string_view RUNTIME_LIB_NAME = "libcool-rt.so";
+    static constexpr std::string_view RUNTIME_STATIC_LIB_NAME = "libcool-rt.a";
+    static constexpr std::string_view RUNTIME_JIT_LIB_NAME = "libcool-rt-jit.a";
     static constexpr std::string_view CLANG_EXE_NAME = "clang++";
 
+    // max number of implementations for the virtual call that are called directly under the tag guards
+    static constexpr int MAX_GUARDED_TARGETS = 3;
+
+    // PGO: implementation of the virtual call is called directly if it gets this percent of the remaining calls
+    static constexpr int HOT_TARGET_PERCENT = 30;
+
+    static constexpr std::string_view PROFILE_COUNTERS_NAME = "_profile_counters";
+    static constexpr std::string_view PROFILE_FUNCTIONS_NAME = "_profile_functions";
+
 #ifdef LLVM_STATEPOINT_EXAMPLE
-    static constexpr std::string_view OBJCOPY_EXE_NAME = "objcopy";
-    static constexpr std::string_view STACKMAP_NAME = "__LLVM_StackMaps";
+    // linker defines __start_/__stop_ symbols for sections with C identifier names, so runtime finds stack maps of all
+    // object files
+    static constexpr std::string_view STACKMAP_SECTION_NAME = ".llvm_stackmaps";
+    static constexpr std::string_view STACKMAP_LINKER_SECTION_NAME = "llvm_stackmaps";
 #endif // LLVM_STATEPOINT_EXAMPLE
 
     // llvm related stuff
@@ -29,8 +48,37 @@ class CodeGenLLVM : public CodeGen<llvm::Value *, Symbol>
     DataLLVM _data;
 
     // optimizations
-    llvm::legacy::FunctionPassManager _optimizer;
-    void init_optimizer();
+    opt::NNI _nni;
+    void optimize(llvm::TargetMachine *target_machine);
+
+    // PGO: -profile-generate counts executions of the sites, -profile-use optimizes the program with these counts.
+    // Every function has the entry counter and counters of its sites in the order of emission
+    std::unique_ptr<Profile> _profile;
+    llvm::GlobalVariable *_profile_counters;                      // counters of all functions
+    std::vector<std::pair<std::string, int>> _profiled_functions; // name and number of counters
+    const std::vector<uint64_t> *_function_profile;               // -profile-use counters of the current function
+    int _function_counters;                                       // first counter of the current function
+    int _next_counter;
+
+    void profile_function_begin(llvm::Function *func);
+    void profile_function_end(llvm::Function *func);
+    // reserve counters for the site, returns the first one
+    int profile_site(int counters_num);
+    // increment the counter. Histogram counter is selected by offset
+    void emit_count(int counter, llvm::Value *offset = nullptr);
+    uint64_t profile_count(int counter) const;
+    llvm::MDNode *branch_weights(const std::vector<uint64_t> &counts);
+    // register counters of the instrumented program in runtime
+    void emit_profile_init();
+
+    // Self-recursive calls in tail position reuse the frame: new args are stored to the args slots of the method and
+    // control jumps to the beginning of its body. musttail is not used, because both GC schemes have work after calls
+    bool _is_tail_call;                     // the current dispatch is in _tail_calls
+    std::vector<llvm::Value *> _args_slots; // args slots of the current method
+    llvm::BasicBlock *_method_body;         // target of the self tail calls
+
+    // direct call of the function or a jump if it is a self tail call
+    llvm::Value *emit_call(llvm::Function *callee, const std::vector<llvm::Value *> &args);
 
     // helper values
     llvm::Value *const _true_obj;
@@ -51,7 +99,9 @@ class CodeGenLLVM : public CodeGen<llvm::Value *, Symbol>
     int _current_stack_size;
 #ifdef DEBUG
     int _max_stack_size;
+    int _raw_slots; // raw values don't take the stack slots that semant counts for them
 
+    void hold_raw_slots(int slots);
     void verify_oop(llvm::Value *object);
 #endif // DEBUG
 
@@ -59,6 +109,12 @@ class CodeGenLLVM : public CodeGen<llvm::Value *, Symbol>
 
     void emit_class_method_inner(const std::shared_ptr<ast::Feature> &method) override;
 
+    // methods with Int or Bool formals or result have a clone that passes them as raw values
+    llvm::Function *unboxed_method(const std::shared_ptr<Klass> &klass, const ast::ObjectExpression &method_name);
+    void emit_method_body(llvm::Function *func, const std::shared_ptr<ast::Feature> &method);
+    void emit_boxed_wrapper(llvm::Function *func, llvm::Function *unboxed_func,
+                            const std::shared_ptr<ast::Feature> &method);
+
     void emit_class_init_method_inner() override;
 
 #ifdef LLVM_SHADOW_STACK
@@ -74,6 +130,10 @@ class CodeGenLLVM : public CodeGen<llvm::Value *, Symbol>
 
     bool _need_reload;
     void set_need_reload(bool need_reload);
+
+    // raw locals are boxed on every use as an object, so any expression in their scope can allocate
+    bool _has_raw_locals;
+    bool can_allocate(const std::shared_ptr<ast::Expression> &expr) const;
 #else
     void allocate_stack(int max_stack);
     void init_stack();
@@ -89,6 +149,8 @@ class CodeGenLLVM : public CodeGen<llvm::Value *, Symbol>
     // cast values helpers
     llvm::Value *maybe_cast(llvm::Value *val, llvm::Type *type);
     void maybe_cast(std::vector<llvm::Value *> &args, llvm::FunctionType *func);
+    // slots of locals are untyped
+    llvm::Value *emit_load_slot(llvm::Value *slot, llvm::Type *type);
 
     llvm::Value *emit_binary_expr_inner(const ast::BinaryExpression &expr,
                                         const std::shared_ptr<ast::Type> &expr_type) override;
@@ -127,36 +189,101 @@ class CodeGenLLVM : public CodeGen<llvm::Value *, Symbol>
     llvm::Value *emit_assign_expr_inner(const ast::AssignExpression &expr,
                                         const std::shared_ptr<ast::Type> &expr_type) override;
 
+    void emit_unused_expr(const std::shared_ptr<ast::Expression> &expr) override;
+
+    // raw initializer makes a raw local, raw_result makes a raw result of the expr
     llvm::Value *emit_in_scope(const std::shared_ptr<ast::ObjectExpression> &object,
                                const std::shared_ptr<ast::Type> &object_type,
-                               const std::shared_ptr<ast::Expression> &expr, llvm::Value *initializer);
+                               const std::shared_ptr<ast::Expression> &expr, llvm::Value *initializer,
+                               bool raw_result = false);
+    llvm::Value *emit_let_initializer(const ast::LetExpression &expr);
+    llvm::Value *emit_if(const ast::IfExpression &expr, const std::shared_ptr<ast::Type> &expr_type, bool raw_result);
 
     // load/allocate basic values
-    llvm::Value *emit_load_primitive(llvm::Value *obj, llvm::Type *obj_type);
+    llvm::Value *emit_load_primitive(llvm::Value *obj, const std::shared_ptr<Klass> &klass);
     llvm::Value *emit_allocate_primitive(llvm::Value *obj, const std::shared_ptr<Klass> &klass);
     llvm::Value *emit_load_int(llvm::Value *int_obj);
     llvm::Value *emit_allocate_int(llvm::Value *val);
     llvm::Value *emit_load_bool(llvm::Value *bool_obj);
 
+    // raw Int and Bool values
+    llvm::Value *emit_value(const std::shared_ptr<ast::Expression> &expr);
+    llvm::Value *emit_binary_value(const ast::BinaryExpression &expr);
+    llvm::Value *emit_unary_value(const ast::UnaryExpression &expr);
+    llvm::Value *emit_box(llvm::Value *value, const std::shared_ptr<ast::Type> &type);
+    llvm::Value *emit_unbox(llvm::Value *value, const std::shared_ptr<ast::Type> &type);
+
+    // returns raw value if the callee is an unboxed method
+    llvm::Value *emit_dispatch(const ast::DispatchExpression &expr, const std::shared_ptr<ast::Type> &expr_type);
+
     // void emit_gc_update(const Register &obj, const int &offset);
 
     // Main func that allocate Main object and call Main_main
     void emit_runtime_main();
 
+    // IR bodies of the trivial runtime methods, so optimizer can inline them
+    void emit_runtime_fast_paths();
+
     // helpers
     llvm::Value *emit_new_inner(const std::shared_ptr<ast::Type> &klass);
     llvm::Value *emit_new_inner_helper(const std::shared_ptr<ast::Type> &klass, bool preserve_before_init = true);
     llvm::Value *emit_load_self();
     llvm::Value *emit_ternary_operator(llvm::Value *pred, llvm::Value *true_val, llvm::Value *false_val);
     void make_control_flow(llvm::Value *pred, llvm::BasicBlock *&true_block, llvm::BasicBlock *&false_block,
-                           llvm::BasicBlock *&merge_block);
+                           llvm::BasicBlock *&merge_block, llvm::MDNode *weights = nullptr);
 
     // header helpers
     llvm::Value *emit_load_tag(llvm::Value *obj, llvm::Type *obj_type);
     llvm::Value *emit_load_size(llvm::Value *objv, llvm::Type *obj_type);
     llvm::Value *emit_load_dispatch_table(llvm::Value *obj, const std::shared_ptr<Klass> &klass);
 
-    void execute_linker(const std::string &object_file_name, const std::string &out_file_name);
+    // alias info: header is written only by runtime during allocation, so header loads are invariant
+    void mark_header_access(llvm::LoadInst *load, const HeaderLayout &elem);
+    void mark_field_access(llvm::Instruction *access, const std::shared_ptr<Klass> &klass, const int &index);
+
+    // devirtualization helpers
+    llvm::Value *emit_direct_call(const std::shared_ptr<Klass> &klass, const ast::ObjectExpression &method_name,
+                                  std::vector<llvm::Value *> args, llvm::Type *res_type);
+    llvm::Value *emit_virtual_call(const std::shared_ptr<Klass> &klass, const ast::ObjectExpression &method_name,
+                                   std::vector<llvm::Value *> args);
+    // targets are called under the tag guards. If they are not all implementations, the rest are called virtually.
+    // Profile counts of the targets (and then of the virtual call) order the guards
+    llvm::Value *emit_guarded_dispatch(const std::shared_ptr<Klass> &klass, std::vector<DispatchTarget> targets,
+                                       bool all_targets, const std::vector<uint64_t> &counts,
+                                       const ast::ObjectExpression &method_name, const std::vector<llvm::Value *> &args,
+                                       llvm::Type *res_type);
+
+    // machine code generation. It also runs in the threads of emit_partitions, so errors are returned to the caller
+    static llvm::TargetMachine *make_target_machine(const llvm::Target *target, const std::string &target_triple,
+                                                    const std::pair<std::string, std::string> &arch_spec);
+    static llvm::Error emit_object(llvm::Module &module, llvm::TargetMachine *target_machine,
+                                   llvm::SmallVectorImpl<char> &obj);
+    static llvm::Error emit_object(llvm::Module &module, llvm::TargetMachine *target_machine,
+                                   const std::string &obj_file);
+#ifdef LLVM_STATEPOINT_EXAMPLE
+    // give stack maps section of the object file in memory the linker section name
+    static llvm::Error rename_stackmap_section(llvm::SmallVectorImpl<char> &obj);
+#endif // LLVM_STATEPOINT_EXAMPLE
+
+    // split module into partitions and emit them in parallel: by classes if object cache is used, otherwise into
+    // CodeGenThreads partitions
+    std::vector<std::string> emit_partitions(const llvm::Target *target, const std::string &target_triple,
+                                             const std::pair<std::string, std::string> &arch_spec,
+                                             const std::string &out_file);
+
+    // functions of the class, other functions and data go to the separate partition
+    std::unordered_map<std::string, std::string> _function_klass;
+    void split_by_classes(const std::function<void(std::unique_ptr<llvm::Module>)> &callback);
+
+    // report of the machine code passes for -time-phases
+    static std::string pass_timings();
+
+    // runtime libraries are located near coolc
+    static std::string runtime_lib_path(const std::string_view &name);
+    void execute_linker(const std::vector<std::string> &object_files, const std::string &out_file_name);
+
+    // coolc --run: program is linked into the compiler process
+    std::unique_ptr<Jit> _jit;
     std::pair<std::string, std::string> find_best_vec_ext();
 
 #ifdef DEBUG
@@ -166,5 +293,13 @@ class CodeGenLLVM : public CodeGen<llvm::Value *, Symbol>
     explicit CodeGenLLVM(const std::shared_ptr<semant::ClassNode> &root);
 
     void emit(const std::string &out_file) override;
+
+    /**
+     * @brief Run the program that was compiled with --run
+     *
+     * @param args Program arguments starting from its name
+     * @return Exit code of the program
+     */
+    int run(const std::vector<std::string> &args);
 };
 }; // namespace codegen
@@ -0,0 +1,54 @@
+#include "ObjectCache.h"
+#include <filesystem>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/Process.h>
+#include <thread>
+
+using namespace codegen;
+
+ObjectCache::ObjectCache(const std::string &dir) : _dir(dir)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(_dir, ec);
+}
+
+std::string ObjectCache::path(const std::string &key) const
+{
+    return (std::filesystem::path(_dir) / (key + static_cast<std::string>(EXT))).string();
+}
+
+std::string ObjectCache::key(llvm::StringRef bitcode, const std::string &target)
+{
+    llvm::MD5 hash;
+    hash.update(LLVM_VERSION_STRING);
+    hash.update(target);
+    hash.update(bitcode);
+
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+
+    return result.digest().str().str();
+}
+
+bool ObjectCache::load(const std::string &key, const std::string &obj_file) const
+{
+    std::error_code ec;
+    std::filesystem::copy_file(path(key), obj_file, std::filesystem::copy_options::overwrite_existing, ec);
+
+    return !ec;
+}
+
+void ObjectCache::store(const std::string &key, const std::string &obj_file) const
+{
+    // other compiler instances can use the same cache, so they must not see partially written files
+    const auto tmp = path(key) + "." + std::to_string(llvm::sys::Process::getProcessId()) + "." +
+                     std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+    std::error_code ec;
+    std::filesystem::copy_file(obj_file, tmp, std::filesystem::copy_options::overwrite_existing, ec);
+    if (!ec)
+    {
+        std::filesystem::rename(tmp, path(key), ec);
+    }
+}
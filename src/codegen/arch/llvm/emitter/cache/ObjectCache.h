@@ -0,0 +1,60 @@
+#pragma once
+
+#include <llvm/ADT/StringRef.h>
+#include <string>
+
+namespace codegen
+{
+
+/**
+ * @brief Content-addressed cache of object files
+ *
+ * Object file of a module is stored under the hash of the module's bitcode and the target options, so unchanged parts
+ * of the program are not emitted again.
+ *
+ */
+class ObjectCache
+{
+  private:
+    static constexpr std::string_view EXT = ".o";
+
+    const std::string _dir;
+
+    std::string path(const std::string &key) const;
+
+  public:
+    /**
+     * @brief Construct a new ObjectCache
+     *
+     * @param dir Cache directory. It is created if doesn't exist
+     */
+    explicit ObjectCache(const std::string &dir);
+
+    /**
+     * @brief Get the key for the module
+     *
+     * @param bitcode Bitcode of the module
+     * @param target Description of the target machine and its options
+     * @return Key of the module
+     */
+    static std::string key(llvm::StringRef bitcode, const std::string &target);
+
+    /**
+     * @brief Copy cached object file
+     *
+     * @param key Key of the module
+     * @param obj_file Destination object file
+     * @return True if the object file was found in cache
+     */
+    bool load(const std::string &key, const std::string &obj_file) const;
+
+    /**
+     * @brief Save object file in cache
+     *
+     * @param key Key of the module
+     * @param obj_file Object file
+     */
+    void store(const std::string &key, const std::string &obj_file) const;
+};
+
+}; // namespace codegen
@@ -2,12 +2,28 @@
 #include "codegen/emitter/data/Data.inline.h"
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/DerivedTypes.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/IR/MDBuilder.h>
+#include <llvm/Support/xxhash.h>
 
 using namespace codegen;
 
 DataLLVM::DataLLVM(const std::shared_ptr<KlassBuilder> &builder, llvm::Module &module, const RuntimeLLVM &runtime)
-    : Data(builder), _module(module), _runtime(runtime)
+    : Data(builder), _module(module), _runtime(runtime), _int_cache(nullptr)
 {
+    // alias info should be ready before the first init method is declared
+    _tbaa_root = llvm::MDBuilder(_module.getContext()).createTBAARoot("COOL TBAA");
+    _tbaa_fields_root = llvm::MDBuilder(_module.getContext()).createTBAAScalarTypeNode("fields", _tbaa_root);
+
+    auto *const header_root = llvm::MDBuilder(_module.getContext()).createTBAAScalarTypeNode("header", _tbaa_root);
+    const char *const header_names[] = {"mark", "tag", "size", "dispatch table"};
+    for (auto i = static_cast<int>(HeaderLayout::Mark); i < HeaderLayout::HeaderLayoutElemets; i++)
+    {
+        _tbaa_header[i] = make_tbaa_tag(header_names[i], header_root);
+    }
+
+    _tbaa_disp_tab = make_tbaa_tag("methods", _tbaa_root);
+
     // publish basic classes structures
     for (auto i = static_cast<int>(BaseClasses::OBJECT); i < BaseClasses::SELF_TYPE; i++)
     {
@@ -69,7 +85,14 @@ llvm::GlobalVariable *DataLLVM::make_constant_array(const std::string &name, llv
     auto *const constant = static_cast<llvm::GlobalVariable *>(_module.getOrInsertGlobal(name, type));
     GUARANTEE_DEBUG(constant);
 
-    constant->setInitializer(llvm::ConstantArray::get(type, elements));
+    // elements can have types of subclasses, e.g. every string constant has its own type
+    std::vector<llvm::Constant *> casted_elements;
+    std::transform(elements.begin(), elements.end(), std::back_inserter(casted_elements),
+                   [type](llvm::Constant *element) {
+                       return llvm::ConstantExpr::getPointerCast(element, type->getElementType());
+                   });
+
+    constant->setInitializer(llvm::ConstantArray::get(type, casted_elements));
     constant->setLinkage(llvm::GlobalValue::ExternalLinkage);
     constant->setConstant(true);
 
@@ -95,6 +118,42 @@ void DataLLVM::make_init_method(const std::shared_ptr<Klass> &klass)
 
     // set receiver name
     init_method->getArg(0)->setName(SelfObject);
+    set_receiver_attrs(init_method, klass);
+}
+
+void DataLLVM::set_receiver_attrs(llvm::Function *func, const std::shared_ptr<Klass> &klass)
+{
+    // receiver is never void and has at least all fields of its class
+    func->addParamAttr(0, llvm::Attribute::NonNull);
+    func->addDereferenceableParamAttr(0, klass->size());
+}
+
+llvm::MDNode *DataLLVM::make_tbaa_tag(const std::string &name, llvm::MDNode *parent)
+{
+    llvm::MDBuilder builder(_module.getContext());
+    auto *const type = builder.createTBAAScalarTypeNode(name, parent);
+
+    return builder.createTBAAStructTagNode(type, type, 0);
+}
+
+llvm::MDNode *DataLLVM::field_tbaa(const std::shared_ptr<Klass> &klass, const int &index)
+{
+    GUARANTEE_DEBUG(index > HeaderLayout::DispatchTable);
+
+    // find the class that declares this field
+    auto declaring_klass = klass;
+    while (declaring_klass->parent() && class_struct(declaring_klass->parent())->getNumElements() > index)
+    {
+        declaring_klass = declaring_klass->parent();
+    }
+
+    const auto name = declaring_klass->name() + "." + std::to_string(index);
+    if (_tbaa_fields.find(name) == _tbaa_fields.end())
+    {
+        _tbaa_fields.insert({name, make_tbaa_tag(name, _tbaa_fields_root)});
+    }
+
+    return _tbaa_fields.at(name);
 }
 
 void DataLLVM::make_base_class(const std::shared_ptr<Klass> &klass, const std::vector<llvm::Type *> &additional_fields)
@@ -136,7 +195,7 @@ void DataLLVM::class_struct_inner(const std::shared_ptr<Klass> &klass)
     // add fields
     std::for_each(klass->fields_begin(), klass->fields_end(), [&fields, klass, this](const auto &field) {
         fields.push_back(
-            class_struct(_builder->klass(semant::Semant::exact_type(field->_type, klass->klass())->_string))
+            class_struct(_builder->klass(semant::Semant::exact_type(field->_type, klass->klass())))
                 ->getPointerTo(_runtime.HEAP_ADDR_SPACE));
     });
 
@@ -163,7 +222,7 @@ void DataLLVM::class_disp_tab_inner(const std::shared_ptr<Klass> &klass)
         {
             std::vector<llvm::Type *> args;
             args.push_back(
-                class_struct(_builder->klass(method.first->_string))->getPointerTo(_runtime.HEAP_ADDR_SPACE)); // this
+                class_struct(_builder->klass(method.first))->getPointerTo(_runtime.HEAP_ADDR_SPACE)); // this
 
             // formals
             const auto &method_formals = std::get<ast::MethodFeature>(method.second->_base);
@@ -171,13 +230,14 @@ void DataLLVM::class_disp_tab_inner(const std::shared_ptr<Klass> &klass)
             {
                 const auto &formal_type = formal->_type->_string;
                 CODEGEN_VERBOSE_ONLY(LOG("Formal of type \"" + formal_type + "\""));
-                args.push_back(class_struct(_builder->klass(formal_type))->getPointerTo(_runtime.HEAP_ADDR_SPACE));
+                args.push_back(
+                    class_struct(_builder->klass(formal->_type))->getPointerTo(_runtime.HEAP_ADDR_SPACE));
             }
 
             CODEGEN_VERBOSE_ONLY(LOG("Return type: \"" + return_type->_string + "\""));
 
             const auto return_klass_struct =
-                class_struct(_builder->klass(semant::Semant::exact_type(return_type, klass->klass())->_string))
+                class_struct(_builder->klass(semant::Semant::exact_type(return_type, klass->klass())))
                     ->getPointerTo(_runtime.HEAP_ADDR_SPACE);
 
             // maybe we already created this method in recursive call of class_struct
@@ -196,6 +256,7 @@ void DataLLVM::class_disp_tab_inner(const std::shared_ptr<Klass> &klass)
 
                 // set names for args
                 func->arg_begin()->setName(SelfObject);
+                set_receiver_attrs(func, _builder->klass(method.first));
                 for (auto *arg = func->arg_begin() + 1; arg != func->arg_end(); arg++)
                 {
                     arg->setName(method_formals._formals[arg - func->arg_begin() - 1]->_object->_object);
@@ -225,7 +286,7 @@ void DataLLVM::int_const_inner(const int64_t &value)
     auto *const int_struct = _classes.at(klass_name);
 
     auto *const constant_int = make_constant_struct(
-        Names::int_constant(), int_struct,
+        Names::name(Names::Comment::CONST_INT, std::to_string(value)), int_struct,
         {llvm::ConstantInt::get(_runtime.header_elem_type(HeaderLayout::Mark), MarkWordSetValue, true),
          llvm::ConstantInt::get(_runtime.header_elem_type(HeaderLayout::Tag), klass->tag(), true),
          llvm::ConstantInt::get(_runtime.header_elem_type(HeaderLayout::Size), klass->size()),
@@ -237,6 +298,28 @@ void DataLLVM::int_const_inner(const int64_t &value)
     _int_constants.insert({value, constant_int});
 }
 
+llvm::GlobalVariable *DataLLVM::int_cache()
+{
+    if (_int_cache)
+    {
+        return _int_cache;
+    }
+
+    std::vector<llvm::Constant *> ints;
+    for (auto i = 0; i < INT_CACHE_SIZE; i++)
+    {
+        ints.push_back(int_const(i));
+    }
+
+    _int_cache = make_constant_array(
+        static_cast<std::string>(INT_CACHE_NAME),
+        llvm::ArrayType::get(_classes.at(BaseClassesNames[BaseClasses::INT])->getPointerTo(_runtime.HEAP_ADDR_SPACE),
+                             ints.size()),
+        ints);
+
+    return _int_cache;
+}
+
 void DataLLVM::string_const_inner(const std::string &str)
 {
     const auto &klass_name = BaseClassesNames[BaseClasses::STRING];
@@ -274,8 +357,14 @@ void DataLLVM::string_const_inner(const std::string &str)
     auto *const string_class = llvm::StructType::create(_module.getContext(), std::string(klass_name) + "_" + str);
     string_class->setBody(fields);
 
-    auto *const constant_str =
-        make_constant_struct(Names::string_constant(), string_class, elements, _runtime.HEAP_ADDR_SPACE);
+    // name depends only on the string, so code of the class doesn't change when other classes add strings
+    auto name = Names::name(Names::Comment::CONST_STRING, llvm::utohexstr(llvm::xxHash64(str), false, 16));
+    if (_module.getNamedGlobal(name))
+    {
+        name = Names::string_constant();
+    }
+
+    auto *const constant_str = make_constant_struct(name, string_class, elements, _runtime.HEAP_ADDR_SPACE);
 
     _string_constants.insert({str, constant_str});
 }
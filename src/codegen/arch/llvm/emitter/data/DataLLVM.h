@@ -2,6 +2,7 @@
 
 #include "codegen/arch/llvm/runtime/RuntimeLLVM.h"
 #include "codegen/emitter/data/Data.h"
+#include <llvm/IR/Metadata.h>
 
 namespace codegen
 {
@@ -9,9 +10,22 @@ namespace codegen
 class DataLLVM : public Data<llvm::GlobalVariable *, llvm::StructType *>
 {
   private:
+    static constexpr std::string_view INT_CACHE_NAME = "int_cache";
+
     llvm::Module &_module;
     const RuntimeLLVM &_runtime;
 
+    llvm::GlobalVariable *_int_cache;
+
+    // TBAA type hierarchy: header elements, fields of different classes and dispatch tables never alias
+    llvm::MDNode *_tbaa_root;
+    llvm::MDNode *_tbaa_fields_root;
+    llvm::MDNode *_tbaa_header[HeaderLayoutElemets];
+    llvm::MDNode *_tbaa_disp_tab;
+    std::unordered_map<std::string, llvm::MDNode *> _tbaa_fields;
+
+    llvm::MDNode *make_tbaa_tag(const std::string &name, llvm::MDNode *parent);
+
     void string_const_inner(const std::string &str) override;
     void bool_const_inner(const bool &value) override;
     void int_const_inner(const int64_t &value) override;
@@ -32,6 +46,7 @@ class DataLLVM : public Data<llvm::GlobalVariable *, llvm::StructType *>
                                               const std::vector<llvm::Constant *> &elemets);
     llvm::GlobalVariable *make_constant(const std::string &name, llvm::Type *type, llvm::Constant *element);
     void make_init_method(const std::shared_ptr<Klass> &klass);
+    void set_receiver_attrs(llvm::Function *func, const std::shared_ptr<Klass> &klass);
 
   public:
     /**
@@ -42,6 +57,39 @@ class DataLLVM : public Data<llvm::GlobalVariable *, llvm::StructType *>
      * @param runtime Runtime methods
      */
     DataLLVM(const std::shared_ptr<KlassBuilder> &builder, llvm::Module &module, const RuntimeLLVM &runtime);
+
+    static constexpr int INT_CACHE_SIZE = 128;
+
+    /**
+     * @brief Declare table of small integer constants
+     *
+     * @return Array of pointers to Int constants from 0 to INT_CACHE_SIZE - 1
+     */
+    llvm::GlobalVariable *int_cache();
+
+    /**
+     * @brief Get TBAA access tag for the header element
+     *
+     * @param elem Header element
+     * @return Access tag
+     */
+    inline llvm::MDNode *header_tbaa(const HeaderLayout &elem) const { return _tbaa_header[elem]; }
+
+    /**
+     * @brief Get TBAA access tag for the field. Fields are distinguished by the class that declares them
+     *
+     * @param klass Class of the object
+     * @param index Index of the field in the class structure
+     * @return Access tag
+     */
+    llvm::MDNode *field_tbaa(const std::shared_ptr<Klass> &klass, const int &index);
+
+    /**
+     * @brief Get TBAA access tag for the dispatch table entries
+     *
+     * @return Access tag
+     */
+    inline llvm::MDNode *disp_tab_tbaa() const { return _tbaa_disp_tab; }
 };
 
 }; // namespace codegen
@@ -0,0 +1,123 @@
+#include "Jit.h"
+#include <algorithm>
+#include <cassert>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h>
+#include <llvm/ExecutionEngine/SectionMemoryManager.h>
+#include <llvm/Support/Error.h>
+
+using namespace codegen;
+
+static llvm::ExitOnError ExitOnErr("coolc --run: "); // NOLINT
+
+// records sections, that runtime needs, before the linker writes them
+class Jit::MemoryManager : public llvm::SectionMemoryManager
+{
+  private:
+    Jit &_jit;
+
+  public:
+    explicit MemoryManager(Jit &jit) : _jit(jit) {}
+
+    uint8_t *allocateDataSection(uintptr_t size, unsigned alignment, unsigned section_id,
+                                 llvm::StringRef section_name, bool is_read_only) override
+    {
+        auto *const start =
+            SectionMemoryManager::allocateDataSection(size, alignment, section_id, section_name, is_read_only);
+        _jit.record_section(start, size, section_name);
+        return start;
+    }
+};
+
+Jit::Jit(const std::string &runtime_lib, const std::string &stackmaps_section_name)
+    : _stackmaps_section_name(stackmaps_section_name)
+{
+    _jit = ExitOnErr(
+        llvm::orc::LLJITBuilder()
+            .setObjectLinkingLayerCreator([this](llvm::orc::ExecutionSession &session, const llvm::Triple &triple)
+                                              -> llvm::Expected<std::unique_ptr<llvm::orc::ObjectLayer>> {
+                return std::make_unique<llvm::orc::RTDyldObjectLinkingLayer>(
+                    session, [this]() { return std::make_unique<MemoryManager>(*this); });
+            })
+            .create());
+
+    // runtime objects are linked only if program uses them, everything else comes from the compiler process
+    auto &dylib = _jit->getMainJITDylib();
+    dylib.addGenerator(
+        ExitOnErr(llvm::orc::StaticLibraryDefinitionGenerator::Load(_jit->getObjLinkingLayer(), runtime_lib.c_str())));
+    dylib.addGenerator(ExitOnErr(
+        llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(_jit->getDataLayout().getGlobalPrefix())));
+}
+
+void Jit::record_section(uint8_t *start, size_t size, llvm::StringRef name)
+{
+    if (name == _stackmaps_section_name)
+    {
+        _stackmaps.push_back({start, size, 0});
+    }
+    else if (name.consume_front(".init_array"))
+    {
+        // .init_array.<priority> or .init_array that runs the last
+        int priority = 65535;
+        if (name.consume_front("."))
+        {
+            name.getAsInteger(10, priority);
+        }
+        _init_arrays.push_back({start, size, priority});
+    }
+}
+
+uint64_t Jit::lookup(const std::string &name)
+{
+    return ExitOnErr(_jit->lookup(name)).getAddress();
+}
+
+void Jit::link(std::unique_ptr<llvm::MemoryBuffer> obj)
+{
+    ExitOnErr(_jit->addObjectFile(std::move(obj)));
+
+    // link the program and everything it depends on
+    lookup("main");
+}
+
+int Jit::run(const std::vector<std::string> &args)
+{
+#ifdef LLVM_STATEPOINT_EXAMPLE
+    // program is a single object file
+    assert(_stackmaps.size() <= 1);
+    if (!_stackmaps.empty())
+    {
+        *(uint8_t **)lookup("_stackmaps_start") = _stackmaps.front()._start;
+        *(uint8_t **)lookup("_stackmaps_end") = _stackmaps.front()._start + _stackmaps.front()._size;
+    }
+#endif // LLVM_STATEPOINT_EXAMPLE
+
+    // static initializers of the runtime
+    std::stable_sort(_init_arrays.begin(), _init_arrays.end(),
+                     [](const Section &a, const Section &b) { return a._priority < b._priority; });
+    for (const auto &init_array : _init_arrays)
+    {
+        using Initializer = void (*)();
+        for (auto *init = (Initializer *)init_array._start;
+             init < (Initializer *)(init_array._start + init_array._size); init++)
+        {
+            (*init)();
+        }
+    }
+
+    std::vector<char *> argv;
+    for (const auto &arg : args)
+    {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    auto *const main = (int (*)(int, char **))lookup("main");
+    return main(args.size(), argv.data());
+}
+
+Jit::~Jit()
+{
+    // runtime registers destructors of its globals with atexit, so its code must stay in memory until the exit
+    (void)_jit.release();
+}
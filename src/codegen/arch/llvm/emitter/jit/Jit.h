@@ -0,0 +1,69 @@
+#pragma once
+
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace codegen
+{
+
+/**
+ * @brief In-process execution of the program for coolc --run
+ *
+ * Program object file and the runtime library are linked by ORC JIT. JIT linker doesn't run static initializers of the
+ * object files and doesn't define bounds of the sections, so it tracks the sections itself.
+ *
+ */
+class Jit
+{
+  private:
+    // section of the linked object file
+    struct Section
+    {
+        uint8_t *_start;
+        size_t _size;
+        int _priority; // order of the initializers
+    };
+
+    class MemoryManager;
+
+    std::unique_ptr<llvm::orc::LLJIT> _jit;
+
+    const std::string _stackmaps_section_name;
+    std::vector<Section> _stackmaps;
+    std::vector<Section> _init_arrays;
+
+    void record_section(uint8_t *start, size_t size, llvm::StringRef name);
+
+    uint64_t lookup(const std::string &name);
+
+  public:
+    /**
+     * @brief Construct a new Jit
+     *
+     * @param runtime_lib Static runtime library
+     * @param stackmaps_section_name Name of the stack maps section for the runtime
+     */
+    Jit(const std::string &runtime_lib, const std::string &stackmaps_section_name);
+
+    /**
+     * @brief Link program and the runtime into the process
+     *
+     * @param obj Object file of the program
+     */
+    void link(std::unique_ptr<llvm::MemoryBuffer> obj);
+
+    /**
+     * @brief Run the program
+     *
+     * @param args Program arguments starting from its name
+     * @return Exit code of the program
+     */
+    int run(const std::vector<std::string> &args);
+
+    ~Jit();
+};
+
+}; // namespace codegen
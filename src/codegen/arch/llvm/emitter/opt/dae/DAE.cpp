@@ -4,9 +4,12 @@
 
 using namespace opt;
 
-char DAE::ID = 0;
+PreservedAnalyses DAE::run(Function &f, FunctionAnalysisManager &am)
+{
+    return run_on_function(f) ? PreservedAnalyses::none() : PreservedAnalyses::all();
+}
 
-bool DAE::runOnFunction(Function &f)
+bool DAE::run_on_function(Function &f)
 {
     OPT_VERBOSE_ONLY(LOG("DAE: runOnFunction: " + (std::string)f.getName()));
 
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "codegen/arch/llvm/runtime/RuntimeLLVM.h"
-#include <llvm/Pass.h>
+#include <llvm/IR/PassManager.h>
 
 using namespace llvm;
 
@@ -12,24 +12,25 @@ namespace opt
  * @brief Dead Allocation Elimination
  *
  */
-struct DAE : public FunctionPass
+struct DAE : public PassInfoMixin<DAE>
 {
-    static char ID;
-
     const codegen::RuntimeLLVM &_runtime;
 
     /**
-     * @brief Construct a LVN Pass
+     * @brief Construct a DAE Pass
      *
      * @param rt Runtime methods
+     * @param int_tag Tag of the Int class
      */
-    DAE(const codegen::RuntimeLLVM &rt, int int_tag) : FunctionPass(ID), _runtime(rt), _int_tag(int_tag) {}
+    DAE(const codegen::RuntimeLLVM &rt, int int_tag) : _runtime(rt), _int_tag(int_tag) {}
 
-    bool runOnFunction(Function &f) override;
+    PreservedAnalyses run(Function &f, FunctionAnalysisManager &am);
 
   private:
     int _int_tag;
 
+    bool run_on_function(Function &f);
+
 #ifdef DEBUG
     void print(const Instruction *inst, const std::string &msg);
 #endif // DEBUG
@@ -4,9 +4,12 @@
 
 using namespace opt;
 
-char NCE::ID = 0;
+PreservedAnalyses NCE::run(Function &f, FunctionAnalysisManager &am)
+{
+    return run_on_function(f) ? PreservedAnalyses::none() : PreservedAnalyses::all();
+}
 
-bool NCE::runOnFunction(Function &f)
+bool NCE::run_on_function(Function &f)
 {
     OPT_VERBOSE_ONLY(LOG("NCE: runOnFunction: " + (std::string)f.getName()));
 
@@ -47,19 +50,25 @@ bool NCE::runOnFunction(Function &f)
 
 Instruction *NCE::null_check(BasicBlock *bb)
 {
-    for (auto inst = bb->rbegin(); inst != bb->rend(); inst++)
+    // null check of the receiver is the predicate of the block terminator.
+    // Other comparisons with null (e.g. isvoid) are not null checks
+    const auto *const branch = dyn_cast<BranchInst>(bb->getTerminator());
+    if (!branch || !branch->isConditional())
     {
-        if (isa<ICmpInst>(*inst))
-        {
-            bool has_null_use = false;
+        return nullptr;
+    }
 
-            for (const auto *use = inst->op_begin(); use != inst->op_end(); use++)
-            {
-                if (isa<llvm::ConstantPointerNull>(*use))
-                {
-                    return &*inst;
-                }
-            }
+    auto *const inst = dyn_cast<ICmpInst>(branch->getCondition());
+    if (!inst || inst->getPredicate() != CmpInst::ICMP_NE || inst->getNextNode() != branch)
+    {
+        return nullptr;
+    }
+
+    for (const auto *use = inst->op_begin(); use != inst->op_end(); use++)
+    {
+        if (isa<llvm::ConstantPointerNull>(*use))
+        {
+            return inst;
         }
     }
 
@@ -71,6 +80,7 @@ bool NCE::can_be_eliminated(Instruction *nce_inst)
     // if value that we check is:
     // 1) self
     // 2) result of allocation
+    // 3) result of the method that never returns void
     // we can eliminate null check
 
     auto *const self = nce_inst->getFunction()->getArg(0);
@@ -136,6 +146,15 @@ bool NCE::can_be_eliminated(Instruction *nce_inst)
         }
     }
 
+    // 3. Val is result of the nonnull method
+    if (const auto *call = dyn_cast<CallBase>(val))
+    {
+        if (call->hasRetAttr(Attribute::NonNull))
+        {
+            return true;
+        }
+    }
+
     return false;
 }
 
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "codegen/arch/llvm/runtime/RuntimeLLVM.h"
-#include <llvm/Pass.h>
+#include <llvm/IR/PassManager.h>
 
 using namespace llvm;
 
@@ -12,10 +12,8 @@ namespace opt
  * @brief Null Check Elimination
  *
  */
-struct NCE : public FunctionPass
+struct NCE : public PassInfoMixin<NCE>
 {
-    static char ID;
-
     const codegen::RuntimeLLVM &_runtime;
 
     /**
@@ -23,11 +21,12 @@ struct NCE : public FunctionPass
      *
      * @param rt Runtime methods
      */
-    NCE(const codegen::RuntimeLLVM &rt) : FunctionPass(ID), _runtime(rt) {}
+    NCE(const codegen::RuntimeLLVM &rt) : _runtime(rt) {}
 
-    bool runOnFunction(Function &f) override;
+    PreservedAnalyses run(Function &f, FunctionAnalysisManager &am);
 
   private:
+    bool run_on_function(Function &f);
     Instruction *null_check(BasicBlock *bb);
     bool can_be_eliminated(Instruction *nce_inst);
     bool eliminate_null_check(Instruction *nce_inst);
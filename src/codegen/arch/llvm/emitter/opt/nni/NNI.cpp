@@ -0,0 +1,269 @@
+#include "NNI.hpp"
+#include "utils/logger/Logger.h"
+#include <algorithm>
+
+using namespace opt;
+
+void NNI::run()
+{
+    // formals can be void
+    for (const auto &klass : _builder->klasses())
+    {
+        for (auto method = klass->methods_begin(); method != klass->methods_end(); method++)
+        {
+            for (const auto &formal : std::get<ast::MethodFeature>(method->second->_base)._formals)
+            {
+                _nullable_vars.insert(formal->_object.get());
+            }
+        }
+    }
+
+    // expressions are recorded on every iteration, so the last one gives the result for the fixed point
+    do
+    {
+        _changed = false;
+        _non_null_exprs.clear();
+
+        run_on_class(_builder->root(), false);
+    } while (_changed);
+
+    OPT_VERBOSE_ONLY(LOG("NNI: found " + std::to_string(_non_null_exprs.size()) + " non-null expressions and " +
+                         std::to_string(_nullable_methods.size()) + " nullable methods."));
+}
+
+void NNI::run_on_class(const std::shared_ptr<semant::ClassNode> &node, bool unsafe_init)
+{
+    const auto &klass = node->_class;
+
+    // methods of the basic classes never return void
+    if (!semant::Semant::is_basic_type(klass->_type))
+    {
+        _current_class = klass->_type;
+
+        const auto &k = _builder->klass(klass->_type);
+        for (auto field = k->fields_begin(); field != k->fields_end(); field++)
+        {
+            _scope.push_back({(*field)->_object->_object, (*field)->_object.get()});
+        }
+
+        // attributes are initialized in order of declaration after the attributes of the parent
+        for (const auto &feature : klass->_features)
+        {
+            if (std::holds_alternative<ast::AttrFeature>(feature->_base))
+            {
+                _uninitialized.insert(feature->_object.get());
+            }
+        }
+
+        for (const auto &feature : klass->_features)
+        {
+            if (std::holds_alternative<ast::AttrFeature>(feature->_base))
+            {
+                unsafe_init |= feature->_expr && has_dispatch(feature->_expr);
+
+                // attribute is void before initialization, so it is safe only if nobody can see it before
+                if (!(feature->_expr && visit(feature->_expr)) || unsafe_init)
+                {
+                    mark_nullable(feature->_object.get());
+                }
+
+                _uninitialized.erase(feature->_object.get());
+            }
+        }
+
+        for (const auto &feature : klass->_features)
+        {
+            if (std::holds_alternative<ast::MethodFeature>(feature->_base))
+            {
+                const auto &formals = std::get<ast::MethodFeature>(feature->_base)._formals;
+                for (const auto &formal : formals)
+                {
+                    _scope.push_back({formal->_object->_object, formal->_object.get()});
+                }
+
+                if (!visit(feature->_expr))
+                {
+                    mark_nullable(feature.get());
+                }
+
+                _scope.resize(_scope.size() - formals.size());
+            }
+        }
+
+        _scope.clear();
+    }
+
+    for (const auto &child : node->_children)
+    {
+        run_on_class(child, unsafe_init);
+    }
+}
+
+bool NNI::visit(const std::shared_ptr<ast::Expression> &expr)
+{
+    const auto non_null = std::visit(
+        ast::overloaded{[&](const ast::AssignExpression &assign) {
+                            const auto value = visit(assign._expr);
+                            if (!value)
+                            {
+                                mark_nullable(lookup(assign._object->_object));
+                            }
+                            return value;
+                        },
+                        [&](const ast::DispatchExpression &dispatch) { return visit_dispatch(dispatch); },
+                        [&](const ast::BinaryExpression &binary) {
+                            visit(binary._lhs);
+                            visit(binary._rhs);
+                            return true;
+                        },
+                        [&](const ast::UnaryExpression &unary) {
+                            visit(unary._expr);
+                            return true;
+                        },
+                        [&](const ast::IfExpression &branch) {
+                            visit(branch._predicate);
+                            const auto true_path = visit(branch._true_path_expr);
+                            const auto false_path = visit(branch._false_path_expr);
+                            return true_path && false_path;
+                        },
+                        [&](const ast::WhileExpression &loop) {
+                            visit(loop._predicate);
+                            visit(loop._body_expr);
+                            return false; // loop returns void
+                        },
+                        [&](const ast::ListExpression &list) {
+                            auto last = false;
+                            for (const auto &e : list._exprs)
+                            {
+                                last = visit(e);
+                            }
+                            return last;
+                        },
+                        [&](const ast::LetExpression &let) {
+                            // Int, Bool and String are initialized by default values
+                            const auto init =
+                                let._expr ? visit(let._expr) : semant::Semant::is_trivial_type(let._type);
+
+                            _scope.push_back({let._object->_object, let._object.get()});
+                            if (!init)
+                            {
+                                mark_nullable(let._object.get());
+                            }
+
+                            const auto body = visit(let._body_expr);
+                            _scope.pop_back();
+
+                            return body;
+                        },
+                        [&](const ast::CaseExpression &branch) {
+                            visit(branch._expr);
+
+                            // case on void aborts, so variable of the branch is never void
+                            auto all = true;
+                            for (const auto &c : branch._cases)
+                            {
+                                _scope.push_back({c->_object->_object, c->_object.get()});
+                                all &= visit(c->_expr);
+                                _scope.pop_back();
+                            }
+
+                            return all;
+                        },
+                        [&](const ast::ObjectExpression &object) {
+                            if (object._object == SelfObject)
+                            {
+                                return true;
+                            }
+
+                            const auto *const var = lookup(object._object);
+                            return !_nullable_vars.contains(var) && !_uninitialized.contains(var);
+                        },
+                        [&](const auto &) { return true; }}, // new and constants
+        expr->_data);
+
+    // Int, Bool and String objects are never void
+    const auto result = non_null || semant::Semant::is_trivial_type(expr->_type);
+    if (result)
+    {
+        _non_null_exprs.insert(expr.get());
+    }
+
+    return result;
+}
+
+bool NNI::visit_dispatch(const ast::DispatchExpression &dispatch)
+{
+    visit(dispatch._expr);
+    for (const auto &arg : dispatch._args)
+    {
+        visit(arg);
+    }
+
+    const auto &method_symbol = dispatch._object->_symbol;
+
+    std::vector<codegen::DispatchTarget> targets;
+    std::visit(ast::overloaded{[&](const ast::VirtualDispatchExpression &disp) {
+                                   targets = _builder->dispatch_targets(
+                                       _builder->klass(
+                                           semant::Semant::exact_type(dispatch._expr->_type, _current_class)),
+                                       method_symbol);
+                               },
+                               [&](const ast::StaticDispatchExpression &disp) {
+                                   targets.push_back({_builder->klass(disp._type), {}});
+                               }},
+               dispatch._base);
+
+    return std::all_of(targets.begin(), targets.end(), [&](const auto &target) {
+        const auto &method = (target._klass->methods_begin() + target._klass->method_index(method_symbol))->second;
+        return !_nullable_methods.contains(method.get());
+    });
+}
+
+const ast::ObjectExpression *NNI::lookup(const std::string &name) const
+{
+    const auto var = std::find_if(_scope.rbegin(), _scope.rend(), [&](const auto &v) { return v.first == name; });
+    GUARANTEE_DEBUG(var != _scope.rend());
+
+    return var->second;
+}
+
+void NNI::mark_nullable(const ast::ObjectExpression *var)
+{
+    _changed |= _nullable_vars.insert(var).second;
+}
+
+void NNI::mark_nullable(const ast::Feature *method)
+{
+    _changed |= _nullable_methods.insert(method).second;
+}
+
+bool NNI::has_dispatch(const std::shared_ptr<ast::Expression> &expr)
+{
+    return std::visit(
+        ast::overloaded{
+            [&](const ast::AssignExpression &assign) { return has_dispatch(assign._expr); },
+            [&](const ast::DispatchExpression &dispatch) { return true; },
+            [&](const ast::BinaryExpression &binary) { return has_dispatch(binary._lhs) || has_dispatch(binary._rhs); },
+            [&](const ast::UnaryExpression &unary) { return has_dispatch(unary._expr); },
+            [&](const ast::IfExpression &branch) {
+                return has_dispatch(branch._predicate) || has_dispatch(branch._true_path_expr) ||
+                       has_dispatch(branch._false_path_expr);
+            },
+            [&](const ast::WhileExpression &loop) {
+                return has_dispatch(loop._predicate) || has_dispatch(loop._body_expr);
+            },
+            [&](const ast::ListExpression &list) {
+                return std::any_of(list._exprs.begin(), list._exprs.end(),
+                                   [](const auto &e) { return has_dispatch(e); });
+            },
+            [&](const ast::LetExpression &let) {
+                return (let._expr && has_dispatch(let._expr)) || has_dispatch(let._body_expr);
+            },
+            [&](const ast::CaseExpression &branch) {
+                return has_dispatch(branch._expr) ||
+                       std::any_of(branch._cases.begin(), branch._cases.end(),
+                                   [](const auto &c) { return has_dispatch(c->_expr); });
+            },
+            [&](const auto &) { return false; }},
+        expr->_data);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "codegen/klass/Klass.h"
+#include <unordered_set>
+
+namespace opt
+{
+
+/**
+ * @brief Non-Null Inference
+ *
+ * Interprocedural analysis of the AST that finds expressions that are never void: results of new, self, constants,
+ * Int, Bool and String values, variables that are never assigned void and calls of methods that never return void.
+ * Starts from the assumption that all variables and methods are non-null and drops it until a fixed point.
+ *
+ */
+class NNI
+{
+  private:
+    const std::shared_ptr<codegen::KlassBuilder> _builder;
+
+    // variables and methods that can be void
+    std::unordered_set<const ast::ObjectExpression *> _nullable_vars;
+    std::unordered_set<const ast::Feature *> _nullable_methods;
+
+    // expressions that are never void
+    std::unordered_set<const ast::Expression *> _non_null_exprs;
+
+    // current class and visible variables
+    std::shared_ptr<ast::Type> _current_class;
+    std::vector<std::pair<std::string, const ast::ObjectExpression *>> _scope;
+
+    // attributes that are not initialized yet in init method
+    std::unordered_set<const ast::ObjectExpression *> _uninitialized;
+
+    bool _changed;
+
+    void run_on_class(const std::shared_ptr<semant::ClassNode> &node, bool unsafe_init);
+    bool visit(const std::shared_ptr<ast::Expression> &expr);
+    bool visit_dispatch(const ast::DispatchExpression &dispatch);
+
+    const ast::ObjectExpression *lookup(const std::string &name) const;
+    void mark_nullable(const ast::ObjectExpression *var);
+    void mark_nullable(const ast::Feature *method);
+
+    // dispatch can call the method that reads attributes that are not initialized yet
+    static bool has_dispatch(const std::shared_ptr<ast::Expression> &expr);
+
+  public:
+    /**
+     * @brief Construct a new NNI
+     *
+     * @param builder Klasses
+     */
+    explicit NNI(const std::shared_ptr<codegen::KlassBuilder> &builder) : _builder(builder), _changed(false) {}
+
+    /**
+     * @brief Analyse all classes
+     *
+     */
+    void run();
+
+    /**
+     * @brief Check if expression is never void
+     *
+     * @param expr Expression
+     * @return True if expression is never void
+     */
+    inline bool is_non_null(const std::shared_ptr<ast::Expression> &expr) const
+    {
+        return _non_null_exprs.contains(expr.get());
+    }
+
+    /**
+     * @brief Check if method never returns void
+     *
+     * @param method Method
+     * @return True if method never returns void
+     */
+    inline bool is_non_null(const std::shared_ptr<ast::Feature> &method) const
+    {
+        return !_nullable_methods.contains(method.get());
+    }
+};
+} // namespace opt
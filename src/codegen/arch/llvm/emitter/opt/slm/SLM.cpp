@@ -0,0 +1,205 @@
+#include "SLM.hpp"
+#include "utils/Utils.h"
+#include "utils/logger/Logger.h"
+#include <llvm/ADT/SetVector.h>
+#include <llvm/Analysis/ValueTracking.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
+
+using namespace opt;
+
+PreservedAnalyses SLM::run(Function &f, FunctionAnalysisManager &am)
+{
+    return run_on_function(f) ? PreservedAnalyses::none() : PreservedAnalyses::all();
+}
+
+bool SLM::run_on_function(Function &f)
+{
+    OPT_VERBOSE_ONLY(LOG("SLM: runOnFunction: " + (std::string)f.getName()));
+
+    // only one of them is used by the GC
+    return merge_stack_maps(f) | merge_gc_roots(f);
+}
+
+bool SLM::merge_stack_maps(Function &f)
+{
+    // stack maps that report locals have id 0
+    std::vector<CallInst *> stackmaps;
+    for (auto &inst : instructions(f))
+    {
+        if (auto *const call = dyn_cast<CallInst>(&inst))
+        {
+            if (call->getIntrinsicID() == Intrinsic::experimental_stackmap &&
+                dyn_cast<ConstantInt>(call->getArgOperand(0))->isZero())
+            {
+                stackmaps.push_back(call);
+            }
+        }
+    }
+
+    if (stackmaps.size() <= 1)
+    {
+        return false;
+    }
+
+    OPT_VERBOSE_ONLY(LOG(" Merge " + std::to_string(stackmaps.size()) + " stack maps."));
+
+    auto &entry = f.getEntryBlock();
+
+    // the own stack map of the method is in the entry block, all others come from the inlined methods
+    const auto own = std::find_if(stackmaps.begin(), stackmaps.end(),
+                                  [&entry](const auto *stackmap) { return stackmap->getParent() == &entry; });
+    Instruction *const insert_point = own != stackmaps.end() ? *own : &*entry.getFirstInsertionPt();
+
+    SmallSetVector<AllocaInst *, 16> locals;
+    SmallPtrSet<AllocaInst *, 16> initialized;
+    std::vector<Value *> args(stackmaps.front()->arg_begin(), stackmaps.front()->arg_begin() + 2);
+    for (auto *const stackmap : stackmaps)
+    {
+        for (auto arg = stackmap->arg_begin() + 2; arg != stackmap->arg_end(); arg++)
+        {
+            SmallVector<const Value *, 4> objects;
+            getUnderlyingObjects(arg->get(), objects);
+
+            for (const auto *const object : objects)
+            {
+                auto *const alloca = const_cast<AllocaInst *>(dyn_cast<AllocaInst>(object));
+                GUARANTEE_DEBUG(alloca);
+
+                if (alloca && locals.insert(alloca))
+                {
+                    args.push_back(alloca);
+                }
+
+                // method initializes own slots before the stack map
+                if (alloca && stackmap == insert_point)
+                {
+                    initialized.insert(alloca);
+                }
+            }
+        }
+    }
+
+    IRBuilder<> builder(insert_point);
+
+    // slots of the inlined methods have to be valid at every safepoint
+    for (auto *const local : locals)
+    {
+        if (!initialized.contains(local))
+        {
+            builder.CreateStore(Constant::getNullValue(local->getAllocatedType()), local);
+        }
+    }
+
+    builder.CreateCall(stackmaps.front()->getCalledFunction(), args);
+
+    for (auto *const stackmap : stackmaps)
+    {
+        stackmap->eraseFromParent();
+    }
+
+    // stack coloring can share slots with disjoint lifetimes, but every slot is reported as root for whole method
+    clear_dead_slots(f, SmallPtrSet<AllocaInst *, 16>(locals.begin(), locals.end()));
+
+    return true;
+}
+
+bool SLM::merge_gc_roots(Function &f)
+{
+    auto &entry = f.getEntryBlock();
+
+    // shadow stack lowering expects every root in the entry block and only once
+    std::vector<IntrinsicInst *> roots;
+    bool inlined = false;
+    for (auto &inst : instructions(f))
+    {
+        if (auto *const intrinsic = dyn_cast<IntrinsicInst>(&inst))
+        {
+            if (intrinsic->getIntrinsicID() == Intrinsic::gcroot)
+            {
+                roots.push_back(intrinsic);
+                inlined |= intrinsic->getParent() != &entry;
+            }
+        }
+    }
+
+    if (!inlined)
+    {
+        return false;
+    }
+
+    OPT_VERBOSE_ONLY(LOG(" Merge " + std::to_string(roots.size()) + " gc roots."));
+
+    // own roots of the method
+    SmallPtrSet<AllocaInst *, 16> locals;
+    for (auto *const root : roots)
+    {
+        if (root->getParent() == &entry)
+        {
+            locals.insert(cast<AllocaInst>(root->getArgOperand(0)->stripPointerCasts()));
+        }
+    }
+
+    IRBuilder<> builder(&*entry.getFirstInsertionPt());
+    while (isa<AllocaInst>(*builder.GetInsertPoint()))
+    {
+        builder.SetInsertPoint(builder.GetInsertPoint()->getNextNode());
+    }
+
+    // roots of the inlined methods have to be valid at every safepoint
+    SmallPtrSet<AllocaInst *, 16> moved;
+    for (auto *const root : roots)
+    {
+        if (root->getParent() == &entry)
+        {
+            continue;
+        }
+
+        auto *const alloca = cast<AllocaInst>(root->getArgOperand(0)->stripPointerCasts());
+        if (locals.insert(alloca).second)
+        {
+            builder.CreateStore(Constant::getNullValue(alloca->getAllocatedType()), alloca);
+            builder.CreateCall(root->getCalledFunction(),
+                               {builder.CreateBitCast(alloca, root->getArgOperand(0)->getType()),
+                                root->getArgOperand(1)});
+            moved.insert(alloca);
+        }
+
+        root->eraseFromParent();
+    }
+
+    // every root is alive for whole method
+    clear_dead_slots(f, moved);
+
+    return true;
+}
+
+void SLM::clear_dead_slots(Function &f, const SmallPtrSetImpl<AllocaInst *> &slots)
+{
+    std::vector<IntrinsicInst *> lifetime_markers;
+    for (auto &inst : instructions(f))
+    {
+        if (auto *const intrinsic = dyn_cast<IntrinsicInst>(&inst))
+        {
+            if (intrinsic->isLifetimeStartOrEnd() &&
+                slots.contains(dyn_cast<AllocaInst>(intrinsic->getArgOperand(1)->stripPointerCasts())))
+            {
+                lifetime_markers.push_back(intrinsic);
+            }
+        }
+    }
+
+    for (auto *const marker : lifetime_markers)
+    {
+        // inliner marks the end of the callee's slots, they must not keep objects alive till the end of the caller
+        if (marker->getIntrinsicID() == Intrinsic::lifetime_end)
+        {
+            auto *const slot = cast<AllocaInst>(marker->getArgOperand(1)->stripPointerCasts());
+            new StoreInst(Constant::getNullValue(slot->getAllocatedType()), slot, marker);
+        }
+
+        marker->eraseFromParent();
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/PassManager.h>
+
+using namespace llvm;
+
+namespace opt
+{
+
+/**
+ * @brief Stack Locals Merge
+ *
+ * Every method reports its stack slots for GC by the stack map with id 0 in the entry block. Inliner moves these slots
+ * of the callee to the entry block of the caller, but leaves the stack map and the slots initialization at the call
+ * site, so the slots contain garbage at the safepoints before the inlined code. Merge all stack maps of the function
+ * into the one in the entry block, initialize all slots there and keep them from being shared with other slots.
+ * Shadow stack has the same problem with gcroot intrinsics: they are moved to the entry block and deduplicated, because
+ * loop passes can copy the inlined code. Merged slots are cleared where the inliner ends their lifetime, so the objects
+ * of the inlined method don't stay alive till the end of the caller.
+ *
+ */
+struct SLM : public PassInfoMixin<SLM>
+{
+    PreservedAnalyses run(Function &f, FunctionAnalysisManager &am);
+
+  private:
+    bool run_on_function(Function &f);
+
+    bool merge_stack_maps(Function &f);
+    bool merge_gc_roots(Function &f);
+
+    void clear_dead_slots(Function &f, const SmallPtrSetImpl<AllocaInst *> &slots);
+};
+} // namespace opt
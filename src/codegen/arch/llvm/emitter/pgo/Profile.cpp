@@ -0,0 +1,65 @@
+#include "Profile.h"
+#include <fstream>
+#include <sstream>
+#include <llvm/ProfileData/InstrProf.h>
+#include <llvm/ProfileData/ProfileCommon.h>
+
+using namespace codegen;
+
+std::unique_ptr<Profile> Profile::load(const std::string &file)
+{
+    std::ifstream in(file);
+    if (!in)
+    {
+        return nullptr;
+    }
+
+    // line is a function name, number of counters and the counters
+    std::unique_ptr<Profile> profile(new Profile());
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::istringstream fields(line);
+        std::string name;
+        size_t counters_num = 0;
+        if (!(fields >> name >> counters_num))
+        {
+            return nullptr;
+        }
+
+        auto &counters = profile->_counters[name];
+        uint64_t counter = 0;
+        while (fields >> counter)
+        {
+            counters.push_back(counter);
+        }
+
+        // truncated or corrupted line
+        if (!fields.eof() || counters.size() != counters_num)
+        {
+            return nullptr;
+        }
+    }
+
+    return profile;
+}
+
+const std::vector<uint64_t> *Profile::counters(const std::string &func) const
+{
+    const auto counters = _counters.find(func);
+    return counters != _counters.end() && !counters->second.empty() ? &counters->second : nullptr;
+}
+
+std::unique_ptr<llvm::ProfileSummary> Profile::summary() const
+{
+    llvm::InstrProfSummaryBuilder builder(llvm::ProfileSummaryBuilder::DefaultCutoffs);
+    for (const auto &[name, counters] : _counters)
+    {
+        if (!counters.empty())
+        {
+            builder.addRecord(llvm::InstrProfRecord(counters));
+        }
+    }
+
+    return builder.getSummary();
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <llvm/IR/ProfileSummary.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace codegen
+{
+
+/**
+ * @brief Profile of the program that was collected by the executable compiled with -profile-generate
+ *
+ * Counters of a function are its entry count and then counters of the sites in the order of emission: taken and not
+ * taken branches of if and while, histograms of the object tags for case and virtual dispatch.
+ *
+ */
+class Profile
+{
+  private:
+    std::unordered_map<std::string, std::vector<uint64_t>> _counters;
+
+    Profile() = default;
+
+  public:
+    /**
+     * @brief Read the profile
+     *
+     * @param file Profile written by the runtime
+     * @return Profile or nullptr if the file cannot be read or is corrupted
+     */
+    static std::unique_ptr<Profile> load(const std::string &file);
+
+    /**
+     * @brief Get counters of the function
+     *
+     * @param func Function name
+     * @return Counters or nullptr if the function was not profiled
+     */
+    const std::vector<uint64_t> *counters(const std::string &func) const;
+
+    /**
+     * @brief Get summary of the counts, so optimizer can find hot and cold code
+     *
+     * @return Profile summary
+     */
+    std::unique_ptr<llvm::ProfileSummary> summary() const;
+};
+
+}; // namespace codegen
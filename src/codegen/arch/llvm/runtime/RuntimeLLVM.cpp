@@ -1,6 +1,7 @@
 #include "RuntimeLLVM.h"
 #include "codegen/arch/llvm/klass/KlassLLVM.h"
 #include "llvm/IR/Constants.h"
+#include "utils/Utils.h"
 
 using namespace codegen;
 
@@ -24,32 +25,37 @@ RuntimeLLVM::RuntimeLLVM(llvm::Module &module)
       _int64_type(llvm::Type::getInt64Ty(module.getContext())), _void_type(llvm::Type::getVoidTy(module.getContext())),
       _int8_type(llvm::Type::getInt8Ty(module.getContext())), _default_int(_int64_type),
       _stack_slot_type(_int8_type->getPointerTo(HEAP_ADDR_SPACE)),
-      _heap_ptr_type(_void_type->getPointerTo(HEAP_ADDR_SPACE)),
+      _heap_ptr_type(_int8_type->getPointerTo(HEAP_ADDR_SPACE)),
 
       _equals(module, SYMBOLS[RuntimeLLVMSymbols::EQUALS], _int32_type,
-              {_void_type->getPointerTo(HEAP_ADDR_SPACE), _void_type->getPointerTo(HEAP_ADDR_SPACE)}, true, *this),
-      _gc_alloc(module, SYMBOLS[RuntimeLLVMSymbols::GC_ALLOC], _void_type->getPointerTo(HEAP_ADDR_SPACE),
-                {_int32_type, _int64_type, _void_type->getPointerTo()}, true, *this),
+              {_int8_type->getPointerTo(HEAP_ADDR_SPACE), _int8_type->getPointerTo(HEAP_ADDR_SPACE)}, true, *this),
+      _gc_alloc(module, SYMBOLS[RuntimeLLVMSymbols::GC_ALLOC], _int8_type->getPointerTo(HEAP_ADDR_SPACE),
+                {_int32_type, _int64_type, _int8_type->getPointerTo()}, true, *this),
       _case_abort(module, SYMBOLS[RuntimeLLVMSymbols::CASE_ABORT], _void_type, {_int32_type}, false, *this),
       _dispatch_abort(module, SYMBOLS[RuntimeLLVMSymbols::DISPATCH_ABORT], _void_type,
-                      {_void_type->getPointerTo(HEAP_ADDR_SPACE), _int32_type}, true, *this),
+                      {_int8_type->getPointerTo(HEAP_ADDR_SPACE), _int32_type}, true, *this),
       _case_abort_2(module, SYMBOLS[RuntimeLLVMSymbols::CASE_ABORT_2], _void_type,
-                    {_void_type->getPointerTo(HEAP_ADDR_SPACE), _int32_type}, true, *this),
+                    {_int8_type->getPointerTo(HEAP_ADDR_SPACE), _int32_type}, true, *this),
       _init_runtime(module, SYMBOLS[RuntimeLLVMSymbols::INIT_RUNTIME], _void_type,
                     {_int32_type, _int8_type->getPointerTo()->getPointerTo()}, false, *this),
-      _finish_runtime(module, SYMBOLS[RuntimeLLVMSymbols::FINISH_RUNTIME], _void_type, {}, false, *this)
+      _finish_runtime(module, SYMBOLS[RuntimeLLVMSymbols::FINISH_RUNTIME], _void_type, {}, false, *this),
+      _init_profile(module, SYMBOLS[RuntimeLLVMSymbols::INIT_PROFILE], _void_type,
+                    {_int8_type->getPointerTo(), _int32_type, _int64_type->getPointerTo()}, false, *this)
 #ifdef DEBUG
       ,
       _verify_oop(module, SYMBOLS[RuntimeLLVMSymbols::VERIFY_OOP], _void_type, {_heap_ptr_type}, false, *this)
 #endif // DEBUG
 #ifdef LLVM_STATEPOINT_EXAMPLE
       ,
+      // JIT can't link thread local variables
       _stack_pointer(new llvm::GlobalVariable(
           module, _int64_type, false, llvm::GlobalValue::ExternalLinkage, llvm::ConstantInt::get(_int64_type, 0, true),
-          SYMBOLS[RuntimeLLVMSymbols::STACK_POINTER], nullptr, llvm::GlobalValue::GeneralDynamicTLSModel)),
+          SYMBOLS[RuntimeLLVMSymbols::STACK_POINTER], nullptr,
+          RunInJit ? llvm::GlobalValue::NotThreadLocal : llvm::GlobalValue::GeneralDynamicTLSModel)),
       _frame_pointer(new llvm::GlobalVariable(
           module, _int64_type, false, llvm::GlobalValue::ExternalLinkage, llvm::ConstantInt::get(_int64_type, 0, true),
-          SYMBOLS[RuntimeLLVMSymbols::FRAME_POINTER], nullptr, llvm::GlobalValue::GeneralDynamicTLSModel))
+          SYMBOLS[RuntimeLLVMSymbols::FRAME_POINTER], nullptr,
+          RunInJit ? llvm::GlobalValue::NotThreadLocal : llvm::GlobalValue::GeneralDynamicTLSModel))
 #endif // LLVM_STATEPOINT_EXAMPLE
 {
     _header_layout_types[HeaderLayout::Mark] =
@@ -58,7 +64,7 @@ RuntimeLLVM::RuntimeLLVM(llvm::Module &module)
         llvm::IntegerType::get(module.getContext(), HeaderLayoutSizes::TagSize * BITS_PER_BYTE);
     _header_layout_types[HeaderLayout::Size] =
         llvm::IntegerType::get(module.getContext(), HeaderLayoutSizes::SizeSize * BITS_PER_BYTE);
-    _header_layout_types[HeaderLayout::DispatchTable] = _void_type->getPointerTo();
+    _header_layout_types[HeaderLayout::DispatchTable] = _int8_type->getPointerTo();
 
 #ifdef LLVM_STATEPOINT_EXAMPLE
 #ifdef __x86_64__
@@ -85,6 +91,7 @@ const std::string RuntimeLLVM::SYMBOLS[RuntimeLLVMSymbolsSize] = {"_equals",
                                                                   "_dispatch_abort",
                                                                   "_init_runtime",
                                                                   "_finish_runtime",
+                                                                  "_init_profile",
 #ifdef DEBUG
                                                                   "_verify_oop",
 #endif // DEBUG
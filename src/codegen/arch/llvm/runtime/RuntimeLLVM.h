@@ -68,6 +68,8 @@ class RuntimeLLVM : public Runtime<RuntimeMethod>
         INIT_RUNTIME,
         FINISH_RUNTIME,
 
+        INIT_PROFILE,
+
 #ifdef DEBUG
         VERIFY_OOP,
 #endif // DEBUG
@@ -125,6 +127,9 @@ class RuntimeLLVM : public Runtime<RuntimeMethod>
     const RuntimeMethod _init_runtime;
     const RuntimeMethod _finish_runtime;
 
+    // PGO
+    const RuntimeMethod _init_profile;
+
 #ifdef DEBUG
     const RuntimeMethod _verify_oop;
 #endif // DEBUG
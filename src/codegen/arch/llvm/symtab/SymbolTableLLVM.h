@@ -11,7 +11,8 @@ struct Symbol
     enum SymbolType
     {
         FIELD,
-        LOCAL
+        LOCAL,
+        RAW_LOCAL // unboxed Int or Bool value
     };
 
     const SymbolType _type;
@@ -38,15 +39,18 @@ struct Symbol
      *
      * @param val Value
      * @param type Value type
+     * @param kind LOCAL for object pointer or RAW_LOCAL for unboxed value
      */
-    Symbol(llvm::Value *val, const std::shared_ptr<ast::Type> &type) : _type(SymbolType::LOCAL), _value_type(type)
+    Symbol(llvm::Value *val, const std::shared_ptr<ast::Type> &type, const SymbolType &kind = SymbolType::LOCAL)
+        : _type(kind), _value_type(type)
     {
         _value._ptr = val;
     }
 
     operator std::string() const
     {
-        return _type == SymbolType::FIELD ? "FIELD with index " + std::to_string(_value._offset) : "LOCAL";
+        return _type == SymbolType::FIELD ? "FIELD with index " + std::to_string(_value._offset)
+                                          : (_type == SymbolType::LOCAL ? "LOCAL" : "RAW_LOCAL");
     }
 };
 }; // namespace codegen
@@ -45,7 +45,7 @@ void CodeGenMips::emit(const std::string &out_file_name)
 
 void CodeGenMips::add_fields()
 {
-    const auto &this_klass = _builder->klass(_current_class->_type->_string);
+    const auto &this_klass = _builder->klass(_current_class->_type);
     for (auto field = this_klass->fields_begin(); field != this_klass->fields_end(); field++)
     {
         const auto &name = (*field)->_object->_object;
@@ -228,13 +228,13 @@ void CodeGenMips::emit_method_epilogue(const int &params_num)
 
 void CodeGenMips::emit_class_init_method_inner()
 {
-    const AssemblerMarkSection mark(_asm, Label(_builder->klass(_current_class->_type->_string)->init_method()));
+    const AssemblerMarkSection mark(_asm, Label(_builder->klass(_current_class->_type)->init_method()));
 
     emit_method_prologue();
 
     if (!semant::Semant::is_empty_type(_current_class->_parent)) // Object moment
     {
-        __ jal(Label(_builder->klass(_current_class->_parent->_string)
+        __ jal(Label(_builder->klass(_current_class->_parent)
                          ->init_method())); // receiver already is in acc, call parent constructor
     }
 
@@ -260,17 +260,17 @@ void CodeGenMips::emit_class_init_method_inner()
 
 void CodeGenMips::emit_class_method_inner(const std::shared_ptr<ast::Feature> &method)
 {
-    const auto &class_name = _current_class->_type->_string;
     const auto &method_name = method->_object->_object;
 
     // it is dummies for basic classes. There are external symbols
     if (semant::Semant::is_basic_type(_current_class->_type))
     {
-        Label(_builder->klass(class_name)->method_full_name(method_name), Label::ALLOW_NO_BIND);
+        Label(_builder->klass(_current_class->_type)->method_full_name(method_name), Label::ALLOW_NO_BIND);
         return;
     }
 
-    const AssemblerMarkSection mark(_asm, Label(_builder->klass(class_name)->method_full_name(method_name)));
+    const AssemblerMarkSection mark(_asm,
+                                    Label(_builder->klass(_current_class->_type)->method_full_name(method_name)));
 
     emit_method_prologue();
 
@@ -309,7 +309,7 @@ void CodeGenMips::emit_string_expr(const ast::StringExpression &expr, const std:
 
 void CodeGenMips::emit_object_expr_inner(const ast::ObjectExpression &expr, const std::shared_ptr<ast::Type> &expr_type)
 {
-    if (!semant::Scope::can_assign(expr._object))
+    if (expr._object == SelfObject)
     {
         __ move(_a0, _s0); // self object: just copy to acc
         return;
@@ -331,7 +331,7 @@ void CodeGenMips::emit_new_expr_inner(const ast::NewExpression &expr, const std:
     // we know the type
     if (!semant::Semant::is_self_type(expr._type))
     {
-        const auto &klass = _builder->klass(expr._type->_string);
+        const auto &klass = _builder->klass(expr._type);
 
         __ la(_a0, Label(klass->prototype()));
         __ jal(*_runtime.symbol_by_id(RuntimeMips::RuntimeMipsSymbols::OBJECT_COPY)); // result in acc
@@ -410,7 +410,7 @@ void CodeGenMips::emit_cases_expr_inner(const ast::CaseExpression &expr, const s
     // we want to generate code for the the most precise cases first, so sort cases by tag
     auto cases = expr._cases;
     std::sort(cases.begin(), cases.end(), [&](const auto &case_a, const auto &case_b) {
-        return _builder->tag(case_b->_type->_string) < _builder->tag(case_a->_type->_string);
+        return _builder->tag(case_b->_type) < _builder->tag(case_a->_type);
     });
 
     // no, it is not void
@@ -425,7 +425,7 @@ void CodeGenMips::emit_cases_expr_inner(const ast::CaseExpression &expr, const s
 
             case_branch_name = (i < cases.size() - 1 ? Names::name(Names::Comment::TRUE_BRANCH) : no_branch_name);
 
-            const auto &klass = _builder->klass(cases[i]->_type->_string);
+            const auto &klass = _builder->klass(cases[i]->_type);
 
             __ blt(
                 t1, klass->tag(),
@@ -531,14 +531,14 @@ void CodeGenMips::emit_dispatch_expr_inner(const ast::DispatchExpression &expr,
             [&](const ast::VirtualDispatchExpression &disp) {
                 __ lw(t1, _a0, DISPATCH_TABLE_OFFSET); // load dispatch table
                 __ lw(t1, t1,
-                      _builder->klass(semant::Semant::exact_type(expr._expr->_type, _current_class->_type)->_string)
-                              ->method_index(method_name) *
+                      _builder->klass(semant::Semant::exact_type(expr._expr->_type, _current_class->_type))
+                              ->method_index(expr._object->_symbol) *
                           WORD_SIZE); // load method label
                 __ jalr(t1);          // jump to method
             },
             [&](const ast::StaticDispatchExpression &disp) {
                 // we know exactly method name
-                __ jal(Label(_builder->klass(disp._type->_string)->method_full_name(method_name)));
+                __ jal(Label(_builder->klass(disp._type)->method_full_name(method_name)));
             }},
         expr._base);
     const Label continue_label(Names::name(Names::Comment::MERGE_BLOCK));
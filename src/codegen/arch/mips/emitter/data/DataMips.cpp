@@ -98,17 +98,17 @@ void DataMips::gen_prototypes()
     int_const(DefaultValue);
     string_const("");
 
-    for (const auto &klass_iter : *_builder)
+    for (const auto &klass : *_builder)
     {
-        class_struct(klass_iter.second);
+        class_struct(klass);
     }
 }
 
 void DataMips::gen_dispatch_tabs()
 {
-    for (const auto &klass_iter : *_builder)
+    for (const auto &klass : *_builder)
     {
-        class_disp_tab(klass_iter.second);
+        class_disp_tab(klass);
     }
 }
 
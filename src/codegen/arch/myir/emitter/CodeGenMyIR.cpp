@@ -1,13 +1,21 @@
 #include "CodeGenMyIR.hpp"
+#include "codegen/arch/myir/emitter/llvm/EmitterLLVM.hpp"
+#include "codegen/arch/myir/emitter/x86/EmitterX86.hpp"
 #include "codegen/arch/myir/ir/IR.inline.hpp"
 #include "codegen/arch/myir/ir/pass/CP/CP.hpp"
 #include "codegen/arch/myir/ir/pass/DIE/DIE.hpp"
 #include "codegen/arch/myir/ir/pass/NCE/NCE.hpp"
 #include "codegen/arch/myir/ir/pass/PassManager.hpp"
 #include "codegen/arch/myir/ir/pass/ssa_construction/SSAConstruction.hpp"
+#include "codegen/arch/myir/ir/pass/ssa_destruction/SSADestruction.hpp"
 #include "codegen/arch/myir/ir/pass/unboxing/Unboxing.hpp"
 #include "codegen/emitter/CodeGen.inline.h"
 #include "codegen/emitter/data/Data.inline.h"
+#include "utils/timer/PhaseTimer.h"
+#include <filesystem>
+#include <fstream>
+#include <spawn.h>
+#include <sys/wait.h>
 
 using namespace codegen;
 
@@ -18,7 +26,7 @@ CodeGenMyIR::CodeGenMyIR(const std::shared_ptr<semant::ClassNode> &root)
       _runtime(_module), _data(_builder, _module, _runtime), _ir_builder(_module),
       _true_val(new myir::Constant(TrueValue, myir::INT8)), _false_val(new myir::Constant(FalseValue, myir::INT8)),
       _true_obj(_data.bool_const(true)), _false_obj(_data.bool_const(false)),
-      _null_val(new myir::Constant(0, myir::POINTER))
+      _null_val(new myir::Constant(0, myir::POINTER)), _current_func(nullptr), _method_body(nullptr)
 {
     DEBUG_ONLY(_table.set_printer([](const std::string &name, const Symbol &s) {
         LOG("Added symbol \"" + name + "\": " + static_cast<std::string>(s))
@@ -33,7 +41,7 @@ myir::Operand *CodeGenMyIR::pointer_offset(myir::Operand *val)
 
 void CodeGenMyIR::add_fields()
 {
-    auto &this_klass = _builder->klass(_current_class->_type->_string);
+    auto &this_klass = _builder->klass(_current_class->_type);
 
     for (auto field = this_klass->fields_begin(); field != this_klass->fields_end(); field++)
     {
@@ -52,7 +60,7 @@ void CodeGenMyIR::emit_class_method_inner(const std::shared_ptr<ast::Feature> &m
     }
 
     auto *func = _module.get<myir::Function>(
-        _builder->klass(_current_class->_type->_string)->method_full_name(method->_object->_object));
+        _builder->klass(_current_class->_type)->method_full_name(method->_object->_object));
 
     assert(func);
 
@@ -70,18 +78,42 @@ void CodeGenMyIR::emit_class_method_inner(const std::shared_ptr<ast::Feature> &m
 
     auto &formals = std::get<ast::MethodFeature>(method->_base)._formals;
 
+    _tail_calls.clear();
+    find_tail_calls(method->_expr);
+    _current_func = func;
+    _formals.clear();
+
     for (auto i = 0; i < func->params_size(); i++)
     {
-        auto *arg = func->param(i);
+        myir::Operand *arg = func->param(i);
         auto name = i != 0 ? formals[i - 1]->_object->_object : SelfObject;
 
+        DEBUG_ONLY(verify_oop(arg));
+
+        if (!_tail_calls.empty())
+        {
+            auto *formal = new myir::Variable(name, arg->type());
+            __ move(arg, formal);
+            _formals.push_back(formal);
+            arg = formal;
+        }
+
         _table.add_symbol(name, Symbol(arg, i != 0 ? formals[i - 1]->_type : _current_class->_type));
+    }
 
-        DEBUG_ONLY(verify_oop(arg));
+    // self tail calls jump here
+    _method_body = nullptr;
+    if (!_tail_calls.empty())
+    {
+        _method_body = __ new_block(Names::name(Names::LOOP_HEADER));
+        __ br(_method_body);
+        __ set_current_block(_method_body);
     }
 
     __ ret(emit_expr(method->_expr));
 
+    _tail_calls.clear();
+    _method_body = nullptr;
     _table.pop_scope();
 }
 
@@ -98,7 +130,7 @@ void CodeGenMyIR::verify_oop(myir::Operand *object)
 
 void CodeGenMyIR::emit_class_init_method_inner()
 {
-    auto &klass = _builder->klass(_current_class->_type->_string);
+    auto &klass = _builder->klass(_current_class->_type);
 
     // Note, that init method don't init header
     auto *func = _module.get<myir::Function>(klass->init_method());
@@ -164,7 +196,7 @@ void CodeGenMyIR::emit_class_init_method_inner()
     // call parent constructor
     if (!semant::Semant::is_empty_type(_current_class->_parent)) // Object moment
     {
-        auto parent = _builder->klass(_current_class->_parent->_string);
+        auto parent = _builder->klass(_current_class->_parent);
 
         __ call(_module.get<myir::Function>(parent->init_method()), {func->param(0)});
     }
@@ -387,7 +419,7 @@ myir::Operand *CodeGenMyIR::emit_new_inner_helper(const std::shared_ptr<ast::Typ
 {
     auto *func = _runtime.symbol_by_id(RuntimeMyIR::RuntimeMyIRSymbols::GC_ALLOC)->_func;
 
-    auto &klass = _builder->klass(klass_type->_string);
+    auto &klass = _builder->klass(klass_type);
 
     // prepare tag, size and dispatch table
     auto *tag = new myir::Constant(klass->tag(), _runtime.header_elem_type(HeaderLayout::Tag));
@@ -417,7 +449,7 @@ myir::Operand *CodeGenMyIR::emit_new_inner(const std::shared_ptr<ast::Type> &kla
     }
 
     auto *self_val = emit_load_self();
-    auto &klass = _builder->klass(_current_class->_type->_string);
+    auto &klass = _builder->klass(_current_class->_type);
 
     // get info about this object
     auto *tag = emit_load_tag(self_val);
@@ -475,7 +507,7 @@ myir::Operand *CodeGenMyIR::emit_cases_expr_inner(const ast::CaseExpression &exp
     // we want to generate code for the the most precise cases first, so sort cases by tag
     auto cases = expr._cases;
     std::sort(cases.begin(), cases.end(), [&](const auto &case_a, const auto &case_b) {
-        return _builder->tag(case_b->_type->_string) < _builder->tag(case_a->_type->_string);
+        return _builder->tag(case_b->_type) < _builder->tag(case_a->_type);
     });
 
     auto *result = new myir::Variable(_data.ast_to_ir_type(expr_type));
@@ -491,7 +523,7 @@ myir::Operand *CodeGenMyIR::emit_cases_expr_inner(const ast::CaseExpression &exp
     // Last case is a special case: branch to abort
     for (auto i = 0; i < cases.size(); i++)
     {
-        auto &klass = _builder->klass(cases[i]->_type->_string);
+        auto &klass = _builder->klass(cases[i]->_type);
 
         auto tag_type = _runtime.header_elem_type(HeaderLayout::Tag);
 
@@ -624,50 +656,77 @@ myir::Operand *CodeGenMyIR::emit_dispatch_expr_inner(const ast::DispatchExpressi
 
     auto &method_name = expr._object->_object;
 
-    auto *call = std::visit(
-        ast::overloaded{
-            [&](const ast::VirtualDispatchExpression &disp) {
-                auto &klass =
-                    _builder->klass(semant::Semant::exact_type(expr._expr->_type, _current_class->_type)->_string);
-
-                auto *offset = pointer_offset(new myir::Constant(klass->method_index(method_name), myir::UINT32));
-
-                // optimize accesses to virtual methods of the leaf classes
-                if (klass->is_leaf() && myir::Operand::isa<myir::Constant>(offset))
-                {
-                    const int offsetv = myir::Operand::as<myir::Constant>(offset)->value();
-                    auto *disptab = myir::Operand::as<myir::GlobalConstant>(_data.class_disp_tab(klass));
-
-                    auto *callee = myir::Operand::as<myir::Function>(disptab->word(offsetv));
+    auto &klass = _builder->klass(semant::Semant::exact_type(expr._expr->_type, _current_class->_type));
+    myir::Operand *offset = nullptr;
+
+    // the callee is known for the static dispatch and for the virtual dispatch on the leaf class
+    auto *callee = std::visit(
+        ast::overloaded{[&](const ast::VirtualDispatchExpression &disp) -> myir::Function * {
+                            offset = pointer_offset(
+                                new myir::Constant(klass->method_index(expr._object->_symbol), myir::UINT32));
+
+                            // optimize accesses to virtual methods of the leaf classes
+                            if (klass->is_leaf() && myir::Operand::isa<myir::Constant>(offset))
+                            {
+                                const int offsetv = myir::Operand::as<myir::Constant>(offset)->value();
+                                auto *disptab = myir::Operand::as<myir::GlobalConstant>(_data.class_disp_tab(klass));
+
+                                return myir::Operand::as<myir::Function>(disptab->word(offsetv));
+                            }
+
+                            return nullptr;
+                        },
+                        [&](const ast::StaticDispatchExpression &disp) -> myir::Function * {
+                            return _module.get<myir::Function>(
+                                _builder->klass(disp._type)->method_full_name(method_name));
+                        }},
+        expr._base);
 
-                    // call
-                    return __ call(callee, args);
-                }
+    assert(callee || offset);
 
-                // load dispatch table
-                auto *dispatch_table_ptr = emit_load_dispatch_table(receiver);
+    if (_method_body && callee == _current_func && _tail_calls.contains(&expr))
+    {
+        // args can use the formals, so they are copied before the formals are changed
+        std::vector<myir::Operand *> values;
+        for (auto *arg : args)
+        {
+            auto *value = new myir::Variable(arg->type());
+            __ move(arg, value);
+            values.push_back(value);
+        }
 
-                // method has the same type as in this klass
-                auto *base_method = _module.get<myir::Function>(klass->method_full_name(method_name));
+        for (auto i = 0; i < values.size(); i++)
+        {
+            __ move(values[i], _formals[i]);
+        }
 
-                // load method
-                auto *method = __ ld<myir::POINTER>(dispatch_table_ptr, offset);
+        __ br(_method_body);
+    }
+    else
+    {
+        myir::Operand *call = nullptr;
+        if (callee)
+        {
+            call = __ call(callee, args);
+        }
+        else
+        {
+            // load dispatch table
+            auto *dispatch_table_ptr = emit_load_dispatch_table(receiver);
 
-                // call
-                return __ call(base_method, method, args);
-            },
-            [&](const ast::StaticDispatchExpression &disp) {
-                auto *method =
-                    _module.get<myir::Function>(_builder->klass(disp._type->_string)->method_full_name(method_name));
+            // method has the same type as in this klass
+            auto *base_method = _module.get<myir::Function>(klass->method_full_name(method_name));
 
-                assert(method);
+            // load method
+            auto *method = __ ld<myir::POINTER>(dispatch_table_ptr, offset);
 
-                return __ call(method, args);
-            }},
-        expr._base);
+            // call
+            call = __ call(base_method, method, args);
+        }
 
-    __ move(call, result);
-    __ br(merge_block);
+        __ move(call, result);
+        __ br(merge_block);
+    }
 
     // it is null
     __ set_current_block(false_block);
@@ -789,25 +848,151 @@ void CodeGenMyIR::emit_runtime_main()
     runtime_main->record_max_ids();
 }
 
+std::map<std::string, myir::Function *> CodeGenMyIR::defined_functions() const
+{
+    // sort for the stable output
+    std::map<std::string, myir::Function *> funcs;
+    for (const auto &[name, func] : _module.get<myir::Function>())
+    {
+        // runtime methods are only declared
+        if (!func->cfg()->empty())
+        {
+            funcs.insert({func->short_name(), func});
+        }
+    }
+
+    return funcs;
+}
+
+void CodeGenMyIR::emit_functions(const std::string &asm_file)
+{
+    AssemblerX86 as;
+    EmitterX86 emitter(as, _runtime);
+
+    for (const auto &[name, func] : defined_functions())
+    {
+        CODEGEN_VERBOSE_ONLY(LOG("Emit function \"" + name + "\""));
+        emitter.emit(func);
+    }
+
+    emitter.emit_stack_maps();
+
+    std::ofstream(asm_file, std::ios::app) << as.code();
+}
+
+void CodeGenMyIR::emit_llvm_functions(const std::string &obj_file)
+{
+    EmitterLLVM emitter(_module, _runtime);
+
+    for (const auto &[name, func] : defined_functions())
+    {
+        CODEGEN_VERBOSE_ONLY(LOG("Translate function \"" + name + "\" to LLVM IR"));
+        emitter.emit(func);
+    }
+
+    emitter.emit_object(obj_file);
+}
+
+#define EXIT_ON_ERROR(cond, error)                                                                                     \
+    if (!(cond))                                                                                                       \
+    {                                                                                                                  \
+        std::cerr << error << std::endl;                                                                               \
+        exit(-1);                                                                                                      \
+    }
+
+void CodeGenMyIR::execute_linker(const std::vector<std::string> &inputs, const std::string &out_file)
+{
+    CODEGEN_VERBOSE_ONLY(LOG("Run linker for " + out_file + "."));
+
+    // coolc looks for the runtime library near itself
+    const auto rt_lib_path =
+        (std::filesystem::read_symlink("/proc/self/exe").parent_path() / RUNTIME_LIB_NAME).string();
+    CODEGEN_VERBOSE_ONLY(LOG("Runtime library path: " + rt_lib_path));
+
+    // clang++ runs the system assembler and the linker
+    const auto clang = static_cast<std::string>(CLANG_EXE_NAME);
+    std::vector<std::string> args = {clang};
+    args.insert(args.end(), inputs.begin(), inputs.end());
+    args.insert(args.end(), {rt_lib_path, "-o", out_file});
+
+    std::vector<char *> argv;
+    for (auto &arg : args)
+    {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
+    {
+        PhaseTimer timer("link");
+
+        pid_t pid = 0;
+        EXIT_ON_ERROR(posix_spawnp(&pid, clang.c_str(), nullptr, nullptr, argv.data(), environ) == 0,
+                      "Can't run " + clang);
+
+        int status = 0;
+        EXIT_ON_ERROR(waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0,
+                      clang + " failed for " + out_file);
+    }
+
+    for (const auto &input : inputs)
+    {
+        std::filesystem::remove(input);
+    }
+
+    CODEGEN_VERBOSE_ONLY(LOG("Finish linker for " + out_file + "."));
+}
+
 void CodeGenMyIR::emit(const std::string &out_file)
 {
-    const std::string obj_file = out_file + static_cast<std::string>(EXT);
+    const std::string asm_file = out_file + static_cast<std::string>(EXT);
+    const std::string obj_file = out_file + static_cast<std::string>(OBJ_EXT);
 
-    emit_class_code(_builder->root()); // emit
-    emit_runtime_main();
+    {
+        PhaseTimer timer("emit class code");
 
-    _data.emit(obj_file);
+        emit_class_code(_builder->root()); // emit
+        emit_runtime_main();
+    }
 
-    // prepare passes
-    myir::PassManager passes(_module);
-    passes.add(new myir::SSAConstruction());
-    passes.add(new myir::NCE(_runtime));
-    passes.add(new myir::Unboxing(_runtime, _data, _builder, _module));
-    passes.add(new myir::CP());
-    passes.add(new myir::DIE());
+    {
+        PhaseTimer timer("optimizer");
+
+        // prepare passes
+        myir::PassManager passes(_module);
+        passes.add(new myir::SSAConstruction());
+        passes.add(new myir::NCE(_runtime));
+        passes.add(new myir::Unboxing(_runtime, _data, _builder, _module));
+        passes.add(new myir::CP());
+        passes.add(new myir::DIE());
+
+        // LLVM IR has phis, so only x86-64 backend needs SSA destruction
+        if (!UseLLVMBackend)
+        {
+            passes.add(new myir::SSADestruction());
+        }
 
-    // apply passes
-    passes.run();
+        // apply passes
+        passes.run();
+    }
 
     CODEGEN_VERBOSE_ONLY(std::cout << _module.dump());
-}
\ No newline at end of file
+
+    {
+        PhaseTimer timer("object emission");
+
+        // passes can create new constants
+        _data.emit(asm_file);
+
+        if (UseLLVMBackend)
+        {
+            emit_llvm_functions(obj_file);
+        }
+        else
+        {
+            emit_functions(asm_file);
+        }
+    }
+
+    execute_linker(UseLLVMBackend ? std::vector<std::string>{asm_file, obj_file} : std::vector<std::string>{asm_file},
+                   out_file);
+}
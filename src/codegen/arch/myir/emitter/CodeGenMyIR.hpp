@@ -3,6 +3,7 @@
 #include "codegen/arch/myir/symtab/SymbolTableMyIR.hpp"
 #include "codegen/emitter/CodeGen.h"
 #include <iostream>
+#include <map>
 
 namespace codegen
 {
@@ -10,7 +11,10 @@ class CodeGenMyIR : public CodeGen<myir::Operand *, Symbol>
 {
   private:
     static constexpr std::string_view RUNTIME_MAIN_FUNC = "main";
-    static constexpr std::string_view EXT = ".o";
+    static constexpr std::string_view EXT = ".s";
+    static constexpr std::string_view OBJ_EXT = ".o";
+    static constexpr std::string_view RUNTIME_LIB_NAME = "libcool-rt.so";
+    static constexpr std::string_view CLANG_EXE_NAME = "clang++";
 
     allocator::LinearAllocator _alloc;
 
@@ -29,6 +33,12 @@ class CodeGenMyIR : public CodeGen<myir::Operand *, Symbol>
 
     myir::Operand *const _null_val;
 
+    // Self-recursive calls in tail position are loops: formals of such method are variables, a self tail call moves the
+    // new args to them and jumps to the beginning of the body
+    myir::Function *_current_func;
+    std::vector<myir::Operand *> _formals;
+    myir::Block *_method_body;
+
 #ifdef DEBUG
     void verify_oop(myir::Operand *object);
 #endif // DEBUG
@@ -106,6 +116,12 @@ class CodeGenMyIR : public CodeGen<myir::Operand *, Symbol>
     myir::Operand *emit_load_size(myir::Operand *obj);
     myir::Operand *emit_load_dispatch_table(myir::Operand *obj);
 
+    // native code
+    std::map<std::string, myir::Function *> defined_functions() const;
+    void emit_functions(const std::string &asm_file);
+    void emit_llvm_functions(const std::string &obj_file);
+    static void execute_linker(const std::vector<std::string> &inputs, const std::string &out_file);
+
   public:
     explicit CodeGenMyIR(const std::shared_ptr<semant::ClassNode> &root);
 
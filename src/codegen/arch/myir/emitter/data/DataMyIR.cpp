@@ -1,7 +1,10 @@
 #include "DataMyIR.hpp"
+#include "codegen/arch/myir/emitter/x86/EmitterX86.hpp"
 #include "codegen/arch/myir/ir/IR.inline.hpp"
 #include "codegen/emitter/data/Data.inline.h"
 #include "decls/Decls.h"
+#include <fstream>
+#include <map>
 
 using namespace codegen;
 
@@ -37,6 +40,21 @@ DataMyIR::DataMyIR(const std::shared_ptr<KlassBuilder> &builder, myir::Module &m
 
     // need thod table initialized during ir construction
     gen_class_obj_tab_inner();
+
+    // create constants for basic classes tags
+    // order in tags synchronized with RuntimeMyIR::RuntimeMyIRSymbols
+    const int tags[] = {_builder->tag(BaseClassesNames[BaseClasses::INT]),
+                        _builder->tag(BaseClassesNames[BaseClasses::BOOL]),
+                        _builder->tag(BaseClassesNames[BaseClasses::STRING])};
+    for (int i = RuntimeMyIR::RuntimeMyIRSymbols::INT_TAG_NAME; i <= RuntimeMyIR::RuntimeMyIRSymbols::STRING_TAG_NAME;
+         i++)
+    {
+        _module.add(new myir::GlobalConstant(
+            _runtime.symbol_name(i),
+            {new myir::Constant(tags[i - RuntimeMyIR::RuntimeMyIRSymbols::INT_TAG_NAME],
+                                _runtime.header_elem_type(HeaderLayout::Tag))},
+            _runtime.header_elem_type(HeaderLayout::Tag)));
+    }
 }
 
 void DataMyIR::make_init_method(const std::shared_ptr<Klass> &klass)
@@ -201,4 +219,62 @@ void DataMyIR::gen_class_name_tab()
     _module.add(new myir::GlobalConstant(_runtime.symbol_name(RuntimeMyIR::CLASS_NAME_TAB), names, myir::STRUCTURE));
 }
 
-void DataMyIR::emit_inner(const std::string &out_file) {}
\ No newline at end of file
+void DataMyIR::emit_inner(const std::string &out_file)
+{
+    AssemblerX86 as;
+
+    // constants are written, because runtime sets mark bits of the objects
+    as.directive(".data");
+
+    // sort for the stable output
+    const std::map<std::string, myir::GlobalConstant *> constants(_module.get<myir::GlobalConstant>().begin(),
+                                                                  _module.get<myir::GlobalConstant>().end());
+    for (const auto &[name, constant] : constants)
+    {
+        as.global(name, "@object", 3);
+
+        for (auto *const field : constant->fields())
+        {
+            if (myir::Operand::isa<myir::Constant>(field))
+            {
+                const auto value = EmitterX86::constant_value(myir::Operand::as<myir::Constant>(field));
+                switch (field->type())
+                {
+                case myir::INT8:
+                case myir::UINT8:
+                    as.directive(".byte", std::to_string(value));
+                    break;
+                case myir::INT32:
+                case myir::UINT32:
+                    as.directive(".long", std::to_string(value));
+                    break;
+                default:
+                    as.directive(".quad", std::to_string(value));
+                }
+            }
+            else
+            {
+                as.directive(".quad", AssemblerX86::symbol(EmitterX86::symbol_name(field)));
+            }
+        }
+
+        as.directive(".size", AssemblerX86::symbol(name) + ", .-" + AssemblerX86::symbol(name));
+    }
+
+    // global variables are thread local
+    as.directive(".section", ".tbss,\"awT\",@nobits");
+
+    const std::map<std::string, myir::GlobalVariable *> variables(_module.get<myir::GlobalVariable>().begin(),
+                                                                  _module.get<myir::GlobalVariable>().end());
+    for (const auto &[name, variable] : variables)
+    {
+        as.global(name, "@object", 3);
+        as.directive(".zero", std::to_string(WORD_SIZE));
+        as.directive(".size", AssemblerX86::symbol(name) + ", " + std::to_string(WORD_SIZE));
+    }
+
+    // program doesn't need executable stack
+    as.directive(".section", ".note.GNU-stack,\"\",@progbits");
+
+    std::ofstream(out_file) << as.code();
+}
\ No newline at end of file
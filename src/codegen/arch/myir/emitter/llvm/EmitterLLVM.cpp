@@ -0,0 +1,654 @@
+#include "EmitterLLVM.hpp"
+#include "codegen/arch/myir/emitter/x86/EmitterX86.hpp"
+#include "codegen/arch/myir/ir/IR.inline.hpp"
+#include "codegen/arch/myir/ir/cfg/CFG.inline.hpp"
+#include <iostream>
+#include <llvm/IR/Intrinsics.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Object/ELF.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Transforms/Scalar/RewriteStatepointsForGC.h>
+
+using namespace codegen;
+
+#define __ _ir_builder.
+
+#define EXIT_ON_ERROR(cond, error)                                                                                     \
+    if (!(cond))                                                                                                       \
+    {                                                                                                                  \
+        std::cerr << error << std::endl;                                                                               \
+        exit(-1);                                                                                                      \
+    }
+
+EmitterLLVM::EmitterLLVM(myir::Module &module, const RuntimeMyIR &runtime)
+    : _runtime(runtime), _module(static_cast<std::string>(MODULE_NAME), _context), _ir_builder(_context),
+      _int8_type(llvm::Type::getInt8Ty(_context)), _int32_type(llvm::Type::getInt32Ty(_context)),
+      _int64_type(llvm::Type::getInt64Ty(_context)), _void_type(llvm::Type::getVoidTy(_context)),
+      _raw_ptr_type(_int8_type->getPointerTo()), _object_type(_int8_type->getPointerTo(HEAP_ADDR_SPACE))
+{
+    // code is generated for the host only
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+
+    const auto target_triple = llvm::sys::getDefaultTargetTriple();
+
+    std::string error;
+    const auto *const target = llvm::TargetRegistry::lookupTarget(target_triple, error);
+    EXIT_ON_ERROR(target, error);
+
+    // the same target as x86-64 backend uses, so both get the same instruction set
+    _target_machine.reset(target->createTargetMachine(target_triple, "generic", "", llvm::TargetOptions(),
+                                                      llvm::Optional<llvm::Reloc::Model>(llvm::Reloc::Model::PIC_)));
+    EXIT_ON_ERROR(_target_machine, "Can't create target machine!");
+
+    _module.setDataLayout(_target_machine->createDataLayout());
+    _module.setTargetTriple(target_triple);
+
+    _sp_name = llvm::MetadataAsValue::get(_context, llvm::MDNode::get(_context, llvm::MDString::get(_context, "rsp")));
+    _fp_name = llvm::MetadataAsValue::get(_context, llvm::MDNode::get(_context, llvm::MDString::get(_context, "rbp")));
+
+    for (const auto &[name, constant] : module.get<myir::GlobalConstant>())
+    {
+        declare(constant, false);
+    }
+
+    // global variables are thread local
+    for (const auto &[name, variable] : module.get<myir::GlobalVariable>())
+    {
+        declare(variable, true);
+    }
+
+    for (const auto &[name, func] : module.get<myir::Function>())
+    {
+        declare(func);
+    }
+}
+
+void EmitterLLVM::declare(myir::Function *func)
+{
+    std::vector<llvm::Type *> params;
+    for (auto *param : func->params())
+    {
+        params.push_back(memory_type(param->type()));
+    }
+
+    auto *const llvm_func =
+        llvm::Function::Create(llvm::FunctionType::get(memory_type(func->return_type()), params, false),
+                               llvm::Function::ExternalLinkage, EmitterX86::symbol_name(func), _module);
+
+    if (!func->cfg()->empty())
+    {
+        llvm_func->setGC(static_cast<std::string>(GC_STRATEGY_NAME));
+        llvm_func->addFnAttr(llvm::Attribute::get(_context, "frame-pointer", "all"));
+    }
+
+    _functions[func] = llvm_func;
+}
+
+void EmitterLLVM::declare(myir::StructuredOperand *global, bool is_thread_local)
+{
+    // DataMyIR defines globals, so the type of a declaration doesn't matter
+    _globals[global] = new llvm::GlobalVariable(
+        _module, is_thread_local ? _int64_type : _int8_type, false, llvm::GlobalValue::ExternalLinkage, nullptr,
+        EmitterX86::symbol_name(global), nullptr,
+        is_thread_local ? llvm::GlobalValue::GeneralDynamicTLSModel : llvm::GlobalValue::NotThreadLocal);
+}
+
+bool EmitterLLVM::is_object_type(myir::OperandType type)
+{
+    return type == myir::POINTER || type == myir::INTEGER || type == myir::BOOLEAN || type == myir::STRING;
+}
+
+bool EmitterLLVM::is_signed(myir::OperandType type) { return type != myir::UINT8 && type != myir::UINT32; }
+
+llvm::Type *EmitterLLVM::memory_type(myir::OperandType type) const
+{
+    switch (type)
+    {
+    case myir::INT8:
+    case myir::UINT8:
+        return _int8_type;
+    case myir::INT32:
+    case myir::UINT32:
+        return _int32_type;
+    case myir::STRUCTURE:
+        return _raw_ptr_type;
+    case myir::VOID:
+        return _void_type;
+    }
+
+    return is_object_type(type) ? _object_type : _int64_type;
+}
+
+llvm::Type *EmitterLLVM::value_type(myir::Operand *value) const
+{
+    return is_object(value) ? _object_type : _int64_type;
+}
+
+bool EmitterLLVM::is_object(myir::Operand *oper) const
+{
+    if (myir::Operand::isa<myir::Constant>(oper) || myir::Operand::isa<myir::Function>(oper) ||
+        myir::Operand::isa<myir::GlobalVariable>(oper))
+    {
+        return false;
+    }
+
+    // dispatch tables and other tables are not objects
+    if (myir::Operand::isa<myir::GlobalConstant>(oper))
+    {
+        return is_object_type(oper->type());
+    }
+
+    return is_object_type(oper->type()) && _raw.find(oper) == _raw.end();
+}
+
+void EmitterLLVM::find_raw_values(myir::Function *func, const std::vector<myir::Block *> &blocks)
+{
+    // the same rule as for the stack maps of x86-64 backend: dispatch tables and methods must not get to the stack
+    // maps. Besides, phis and moves of raw values and results of arithmetic are raw, so the value has only one type
+    _raw.clear();
+
+    auto is_raw = [this](myir::Operand *oper) { return !myir::Operand::isa<myir::Constant>(oper) && !is_object(oper); };
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (auto *b : blocks)
+        {
+            for (auto *inst : b->insts())
+            {
+                auto *def = inst->def();
+                if (!def || !is_object(def))
+                {
+                    continue;
+                }
+
+                bool raw_def = false;
+                if (myir::Instruction::isa<myir::Load>(inst))
+                {
+                    auto *offset = inst->use(1);
+                    raw_def = is_raw(inst->use(0)) ||
+                              myir::Operand::isa<myir::Constant>(offset) &&
+                                  myir::Operand::as<myir::Constant>(offset)->value() ==
+                                      HeaderLayoutOffsets::DispatchTableOffset;
+                }
+                else if (myir::Instruction::isa<myir::Move>(inst))
+                {
+                    raw_def = is_raw(inst->use(0));
+                }
+                else if (myir::Instruction::isa<myir::Phi>(inst))
+                {
+                    raw_def = std::any_of(inst->uses().begin(), inst->uses().end(), is_raw);
+                }
+                else
+                {
+                    raw_def = myir::Instruction::isa<myir::BinaryInst>(inst) ||
+                              myir::Instruction::isa<myir::UnaryInst>(inst);
+                }
+
+                if (raw_def)
+                {
+                    _raw.insert(def);
+                    changed = true;
+                }
+            }
+        }
+    }
+}
+
+llvm::Value *EmitterLLVM::convert(llvm::Value *value, llvm::Type *type, bool is_signed)
+{
+    auto *const from = value->getType();
+    if (from == type)
+    {
+        return value;
+    }
+
+    if (from->isIntegerTy() && type->isIntegerTy())
+    {
+        return __ CreateIntCast(value, type, is_signed);
+    }
+
+    if (from->isPointerTy() && type->isIntegerTy())
+    {
+        return __ CreatePtrToInt(value, type);
+    }
+
+    if (from->isIntegerTy() && type->isPointerTy())
+    {
+        return __ CreateIntToPtr(__ CreateIntCast(value, _int64_type, is_signed), type);
+    }
+
+    return __ CreatePointerBitCastOrAddrSpaceCast(value, type);
+}
+
+llvm::Value *EmitterLLVM::value(myir::Operand *oper, llvm::Type *type)
+{
+    if (myir::Operand::isa<myir::Constant>(oper))
+    {
+        const auto constant = EmitterX86::constant_value(myir::Operand::as<myir::Constant>(oper));
+        if (type->isPointerTy())
+        {
+            return constant == 0 ? llvm::ConstantPointerNull::get(llvm::cast<llvm::PointerType>(type))
+                                 : llvm::ConstantExpr::getIntToPtr(llvm::ConstantInt::get(_int64_type, constant), type);
+        }
+
+        return llvm::ConstantInt::get(type, constant, true);
+    }
+
+    llvm::Value *result = nullptr;
+    if (myir::Operand::isa<myir::Function>(oper))
+    {
+        result = _functions.at(oper);
+    }
+    else if (myir::Operand::isa<myir::StructuredOperand>(oper))
+    {
+        // constant objects are not in the heap, but have the same type as other objects
+        auto *const global = _globals.at(oper);
+        result = is_object(oper) ? llvm::ConstantExpr::getAddrSpaceCast(global, _object_type) : global;
+    }
+    else
+    {
+        result = _values.at(oper);
+    }
+
+    return convert(result, type, is_signed(oper->type()));
+}
+
+llvm::Value *EmitterLLVM::address(myir::Operand *base, myir::Operand *offset, llvm::Type *type)
+{
+    auto *const offset_val = value(offset, _int64_type);
+
+    // derived pointers of the objects stay in the heap address space, so statepoints know their bases
+    const int addr_space = is_object(base) ? HEAP_ADDR_SPACE : 0;
+    auto *const base_val = value(base, addr_space ? _object_type : _raw_ptr_type);
+
+    return __ CreateBitCast(__ CreateGEP(_int8_type, base_val, offset_val), type->getPointerTo(addr_space));
+}
+
+void EmitterLLVM::emit(myir::Function *func)
+{
+    auto *const llvm_func = _functions.at(func);
+
+    // traversal needs ids of this function
+    func->reset_max_ids();
+    const auto blocks = func->cfg()->traversal<myir::CFG::REVERSE_POSTORDER>();
+    func->record_max_ids();
+
+    find_raw_values(func, blocks);
+
+    _values.clear();
+    _blocks.clear();
+
+    for (auto *b : blocks)
+    {
+        _blocks[b] = llvm::BasicBlock::Create(_context, "", llvm_func);
+    }
+
+    // phis can use values that are defined later, so create them first and set their incoming values at the end
+    for (auto *b : blocks)
+    {
+        __ SetInsertPoint(_blocks.at(b));
+        for (auto *inst : b->insts())
+        {
+            if (myir::Instruction::isa<myir::Phi>(inst))
+            {
+                _values[inst->def()] = __ CreatePHI(value_type(inst->def()), inst->uses().size());
+            }
+        }
+    }
+
+    // entry block doesn't have phis
+    __ SetInsertPoint(_blocks.at(blocks.front()));
+    for (int i = 0; i < func->params_size(); i++)
+    {
+        auto *param = func->param(i);
+        _values[param] = convert(llvm_func->getArg(i), value_type(param), is_signed(param->type()));
+    }
+
+    // runtime expects the record of the locals that are always live, as CodeGenLLVM makes. There are no such locals
+    auto *const stackmap = llvm::Intrinsic::getDeclaration(&_module, llvm::Intrinsic::experimental_stackmap);
+    __ CreateCall(stackmap, {llvm::ConstantInt::get(_int64_type, 0), llvm::ConstantInt::get(_int32_type, 0)});
+
+    for (auto *b : blocks)
+    {
+        __ SetInsertPoint(_blocks.at(b));
+        for (auto *inst : b->insts())
+        {
+            if (!myir::Instruction::isa<myir::Phi>(inst))
+            {
+                emit(inst);
+            }
+        }
+    }
+
+    for (auto *b : blocks)
+    {
+        for (auto *inst : b->insts())
+        {
+            if (myir::Instruction::isa<myir::Phi>(inst))
+            {
+                emit_phi_paths(myir::Instruction::as<myir::Phi>(inst));
+            }
+        }
+    }
+}
+
+void EmitterLLVM::emit(myir::Instruction *inst)
+{
+    if (myir::Instruction::isa<myir::Store>(inst))
+    {
+        emit_store(myir::Instruction::as<myir::Store>(inst));
+    }
+    else if (myir::Instruction::isa<myir::Load>(inst))
+    {
+        emit_load(myir::Instruction::as<myir::Load>(inst));
+    }
+    else if (myir::Instruction::isa<myir::BinaryInst>(inst))
+    {
+        emit_binary(myir::Instruction::as<myir::BinaryInst>(inst));
+    }
+    else if (myir::Instruction::isa<myir::UnaryInst>(inst))
+    {
+        emit_unary(myir::Instruction::as<myir::UnaryInst>(inst));
+    }
+    else if (myir::Instruction::isa<myir::Call>(inst))
+    {
+        emit_call(myir::Instruction::as<myir::Call>(inst));
+    }
+    else if (myir::Instruction::isa<myir::Ret>(inst))
+    {
+        emit_ret(myir::Instruction::as<myir::Ret>(inst));
+    }
+    else if (myir::Instruction::isa<myir::Branch>(inst))
+    {
+        __ CreateBr(_blocks.at(myir::Instruction::as<myir::Branch>(inst)->dest()));
+    }
+    else if (myir::Instruction::isa<myir::CondBranch>(inst))
+    {
+        emit_cond_branch(myir::Instruction::as<myir::CondBranch>(inst));
+    }
+    else
+    {
+        SHOULD_NOT_REACH_HERE();
+    }
+}
+
+void EmitterLLVM::emit_store(myir::Store *store)
+{
+    auto *const value = store->use(2);
+
+    // all fields are 8 bytes
+    const bool is_object_value =
+        is_object(value) || myir::Operand::isa<myir::Constant>(value) && is_object_type(value->type());
+    auto *const type = is_object_value ? _object_type : _int64_type;
+
+    __ CreateStore(this->value(value, type), address(store->use(0), store->use(1), type));
+}
+
+void EmitterLLVM::emit_load(myir::Load *load)
+{
+    auto *const def = load->def();
+
+    // raw pointers are loaded as words
+    auto *const type = is_object_type(def->type()) ? value_type(def) : memory_type(def->type());
+
+    auto *const result = __ CreateLoad(type, address(load->use(0), load->use(1), type));
+    _values[def] = convert(result, value_type(def), is_signed(def->type()));
+}
+
+void EmitterLLVM::emit_binary(myir::BinaryInst *inst)
+{
+    auto *const lhs = inst->use(0);
+    auto *const rhs = inst->use(1);
+
+    llvm::Value *result = nullptr;
+    if (myir::Instruction::isa<myir::BinaryLogicInst>(inst))
+    {
+        // compare objects as pointers, so they don't lose relocation
+        auto *const type = is_object(lhs) || is_object(rhs) ? _object_type : _int64_type;
+
+        auto pred = llvm::CmpInst::ICMP_EQ;
+        if (myir::Instruction::isa<myir::LT>(inst))
+        {
+            pred = llvm::CmpInst::ICMP_SLT;
+        }
+        else if (myir::Instruction::isa<myir::LE>(inst))
+        {
+            pred = llvm::CmpInst::ICMP_SLE;
+        }
+        else if (myir::Instruction::isa<myir::GT>(inst))
+        {
+            pred = llvm::CmpInst::ICMP_SGT;
+        }
+        else
+        {
+            assert(myir::Instruction::isa<myir::EQ>(inst));
+        }
+
+        result = __ CreateZExt(__ CreateICmp(pred, value(lhs, type), value(rhs, type)), _int64_type);
+    }
+    else
+    {
+        auto *const lhs_val = value(lhs, _int64_type);
+        auto *const rhs_val = value(rhs, _int64_type);
+
+        if (myir::Instruction::isa<myir::Add>(inst))
+        {
+            result = __ CreateAdd(lhs_val, rhs_val);
+        }
+        else if (myir::Instruction::isa<myir::Sub>(inst))
+        {
+            result = __ CreateSub(lhs_val, rhs_val);
+        }
+        else if (myir::Instruction::isa<myir::Mul>(inst))
+        {
+            result = __ CreateMul(lhs_val, rhs_val);
+        }
+        else if (myir::Instruction::isa<myir::Div>(inst))
+        {
+            result = __ CreateSDiv(lhs_val, rhs_val);
+        }
+        else if (myir::Instruction::isa<myir::Xor>(inst))
+        {
+            result = __ CreateXor(lhs_val, rhs_val);
+        }
+        else if (myir::Instruction::isa<myir::Or>(inst))
+        {
+            result = __ CreateOr(lhs_val, rhs_val);
+        }
+        else if (myir::Instruction::isa<myir::Shl>(inst))
+        {
+            result = __ CreateShl(lhs_val, rhs_val);
+        }
+        else
+        {
+            SHOULD_NOT_REACH_HERE();
+        }
+    }
+
+    _values[inst->def()] = result;
+}
+
+void EmitterLLVM::emit_unary(myir::UnaryInst *inst)
+{
+    auto *const def = inst->def();
+    auto *const operand = inst->use(0);
+
+    if (myir::Instruction::isa<myir::Move>(inst))
+    {
+        _values[def] = value(operand, value_type(def));
+    }
+    else if (myir::Instruction::isa<myir::Neg>(inst))
+    {
+        _values[def] = __ CreateNeg(value(operand, _int64_type));
+    }
+    else
+    {
+        assert(myir::Instruction::isa<myir::Not>(inst));
+        _values[def] = __ CreateXor(value(operand, _int64_type), llvm::ConstantInt::get(_int64_type, 1));
+    }
+}
+
+void EmitterLLVM::save_frame()
+{
+    auto *const read_reg = llvm::Intrinsic::getDeclaration(&_module, llvm::Intrinsic::read_register, {_int64_type});
+
+    __ CreateStore(__ CreateCall(read_reg, {_sp_name}), _globals.at(_runtime.stack_pointer()));
+    __ CreateStore(__ CreateCall(read_reg, {_fp_name}), _globals.at(_runtime.frame_pointer()));
+}
+
+void EmitterLLVM::emit_call(myir::Call *call)
+{
+    auto *const callee = call->callee();
+    auto *const target = call->use(0);
+    const bool is_direct = myir::Operand::isa<myir::Function>(target);
+
+    auto *const func_type = _functions.at(callee)->getFunctionType();
+
+    // the first use is a callee
+    std::vector<llvm::Value *> args;
+    for (int i = 1; i < call->uses().size(); i++)
+    {
+        args.push_back(value(call->use(i), func_type->getParamType(i - 1)));
+    }
+
+    auto *const callee_val = is_direct ? _functions.at(target) : value(target, func_type->getPointerTo());
+
+    if (!callee->is_leaf() && (!is_direct || callee->cfg()->empty()))
+    {
+        save_frame();
+    }
+
+    auto *const result = __ CreateCall(func_type, callee_val, args);
+
+    // RewriteStatepointsForGC makes statepoints only for the calls that can cause GC
+    if (callee->is_leaf())
+    {
+        result->addFnAttr(llvm::Attribute::get(_context, "gc-leaf-function"));
+    }
+
+    if (call->def())
+    {
+        _values[call->def()] = convert(result, value_type(call->def()), is_signed(callee->return_type()));
+    }
+}
+
+void EmitterLLVM::emit_ret(myir::Ret *ret)
+{
+    auto *const ret_type = __ GetInsertBlock()->getParent()->getReturnType();
+
+    if (ret->uses().empty() || ret_type->isVoidTy())
+    {
+        __ CreateRetVoid();
+        return;
+    }
+
+    __ CreateRet(value(ret->use(0), ret_type));
+}
+
+void EmitterLLVM::emit_cond_branch(myir::CondBranch *br)
+{
+    // constant condition is folded by IRBuilder, but both successors stay in CFG as in MyIR
+    auto *const cond = __ CreateICmpNE(value(br->use(0), _int64_type), llvm::ConstantInt::get(_int64_type, 0));
+    __ CreateCondBr(cond, _blocks.at(br->taken()), _blocks.at(br->not_taken()));
+}
+
+void EmitterLLVM::emit_phi_paths(myir::Phi *phi)
+{
+    auto *const node = llvm::cast<llvm::PHINode>(_values.at(phi->def()));
+
+    for (int i = 0; i < phi->uses().size(); i++)
+    {
+        const auto pred = _blocks.find(phi->path(i));
+        if (pred == _blocks.end())
+        {
+            continue; // unreachable block
+        }
+
+        // conversion of the value belongs to the predecessor
+        __ SetInsertPoint(pred->second->getTerminator());
+        node->addIncoming(value(phi->use(i), node->getType()), pred->second);
+    }
+}
+
+void EmitterLLVM::emit_object(const std::string &obj_file)
+{
+    GUARANTEE_DEBUG(!llvm::verifyModule(_module, &llvm::errs()));
+
+    // only gc roots: code generator is compared with x86-64 backend on the same MyIR
+    {
+        llvm::LoopAnalysisManager lam;
+        llvm::FunctionAnalysisManager fam;
+        llvm::CGSCCAnalysisManager cgam;
+        llvm::ModuleAnalysisManager mam;
+
+        llvm::PassBuilder pb(_target_machine.get());
+        pb.registerModuleAnalyses(mam);
+        pb.registerCGSCCAnalyses(cgam);
+        pb.registerFunctionAnalyses(fam);
+        pb.registerLoopAnalyses(lam);
+        pb.crossRegisterProxies(lam, fam, cgam, mam);
+
+        llvm::ModulePassManager mpm;
+        mpm.addPass(llvm::RewriteStatepointsForGC());
+        mpm.run(_module, mam);
+    }
+
+    CODEGEN_VERBOSE_ONLY(_module.print(llvm::errs(), nullptr));
+
+    // object is patched before it gets to the disk, so emit it in memory
+    llvm::SmallVector<char, 0> obj;
+    llvm::raw_svector_ostream os(obj);
+
+    llvm::legacy::PassManager pass;
+    EXIT_ON_ERROR(!_target_machine->addPassesToEmitFile(pass, os, nullptr, llvm::CGFT_ObjectFile),
+                  "TargetMachine can't emit a file of this type!");
+
+    pass.run(_module);
+
+    rename_stackmap_section(obj);
+
+    std::error_code ec;
+    llvm::raw_fd_ostream dest(obj_file, ec);
+    EXIT_ON_ERROR(!ec, "Could not open file: " + ec.message());
+
+    dest.write(obj.data(), obj.size());
+    dest.close();
+    EXIT_ON_ERROR(!dest.has_error(), "Could not write file: " + dest.error().message());
+}
+
+void EmitterLLVM::rename_stackmap_section(llvm::SmallVectorImpl<char> &obj)
+{
+    const llvm::StringRef from(STACKMAP_SECTION_NAME.data(), STACKMAP_SECTION_NAME.size());
+    const llvm::StringRef to(STACKMAP_LINKER_SECTION_NAME.data(), STACKMAP_LINKER_SECTION_NAME.size());
+
+    // new name is a suffix of the old one, so section can point to the middle of the same string in string table
+    GUARANTEE_DEBUG(from.endswith(to));
+
+    // MyIR targets x86-64 only
+    auto file = llvm::object::ELF64LEFile::create(llvm::StringRef(obj.data(), obj.size()));
+    EXIT_ON_ERROR(file, llvm::toString(file.takeError()));
+
+    auto sections = file->sections();
+    EXIT_ON_ERROR(sections, llvm::toString(sections.takeError()));
+
+    for (const auto &section : *sections)
+    {
+        auto name = file->getSectionName(section);
+        EXIT_ON_ERROR(name, llvm::toString(name.takeError()));
+
+        if (*name == from)
+        {
+            // section headers are in obj
+            auto &header = const_cast<llvm::object::ELF64LE::Shdr &>(section);
+            header.sh_name = header.sh_name + (from.size() - to.size());
+        }
+    }
+}
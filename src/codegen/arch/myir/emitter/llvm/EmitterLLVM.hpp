@@ -0,0 +1,118 @@
+#pragma once
+
+#include "codegen/arch/myir/ir/IR.hpp"
+#include "codegen/arch/myir/runtime/RuntimeMyIR.hpp"
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace codegen
+{
+
+/**
+ * @brief Lowering of the optimized MyIR to LLVM IR
+ *
+ * Functions, blocks, instructions and phis of MyIR in SSA form are mapped one-to-one onto LLVM ones, LLVM code
+ * generator does instruction selection and register allocation. Objects are pointers to the heap address space and
+ * RewriteStatepointsForGC makes gc roots of them as in CodeGenLLVM, other values are 64-bit integers. Global constants
+ * are emitted by DataMyIR, so they are only declared here.
+ */
+class EmitterLLVM
+{
+  private:
+    static constexpr std::string_view MODULE_NAME = "cool";
+    static constexpr std::string_view GC_STRATEGY_NAME = "statepoint-example";
+    static constexpr std::string_view STACKMAP_SECTION_NAME = ".llvm_stackmaps";
+    static constexpr std::string_view STACKMAP_LINKER_SECTION_NAME = "llvm_stackmaps";
+
+    // addrspace for RewriteStatepointsForGC in statepoint-example gc strategy
+    static const int HEAP_ADDR_SPACE = 1;
+
+    const RuntimeMyIR &_runtime;
+
+    llvm::LLVMContext _context;
+    llvm::Module _module;
+    llvm::IRBuilder<> _ir_builder;
+    std::unique_ptr<llvm::TargetMachine> _target_machine;
+
+    // types
+    llvm::Type *const _int8_type;
+    llvm::Type *const _int32_type;
+    llvm::Type *const _int64_type;
+    llvm::Type *const _void_type;
+    llvm::Type *const _raw_ptr_type;
+    llvm::Type *const _object_type;
+
+    llvm::MetadataAsValue *_sp_name;
+    llvm::MetadataAsValue *_fp_name;
+
+    std::unordered_map<myir::Operand *, llvm::Function *> _functions;
+    std::unordered_map<myir::Operand *, llvm::GlobalVariable *> _globals;
+
+    // state of the current function
+    std::unordered_map<myir::Operand *, llvm::Value *> _values;
+    std::unordered_map<myir::Block *, llvm::BasicBlock *> _blocks;
+    std::unordered_set<myir::Operand *> _raw; // values that are not objects
+
+    // declarations
+    void declare(myir::Function *func);
+    void declare(myir::StructuredOperand *global, bool is_thread_local);
+
+    // types
+    llvm::Type *memory_type(myir::OperandType type) const;
+    llvm::Type *value_type(myir::Operand *value) const;
+    static bool is_object_type(myir::OperandType type);
+    static bool is_signed(myir::OperandType type);
+    void find_raw_values(myir::Function *func, const std::vector<myir::Block *> &blocks);
+
+    // operands
+    bool is_object(myir::Operand *oper) const;
+    llvm::Value *value(myir::Operand *oper, llvm::Type *type);
+    llvm::Value *convert(llvm::Value *value, llvm::Type *type, bool is_signed);
+    llvm::Value *address(myir::Operand *base, myir::Operand *offset, llvm::Type *type);
+
+    // instructions
+    void emit(myir::Instruction *inst);
+    void emit_store(myir::Store *store);
+    void emit_load(myir::Load *load);
+    void emit_binary(myir::BinaryInst *inst);
+    void emit_unary(myir::UnaryInst *inst);
+    void emit_call(myir::Call *call);
+    void emit_ret(myir::Ret *ret);
+    void emit_cond_branch(myir::CondBranch *br);
+    void emit_phi_paths(myir::Phi *phi);
+
+    // runtime starts stack walking from the last frame of the program
+    void save_frame();
+
+    void rename_stackmap_section(llvm::SmallVectorImpl<char> &obj);
+
+  public:
+    /**
+     * @brief Construct a new EmitterLLVM and declare all functions and globals of the module
+     *
+     * @param module MyIR module
+     * @param runtime Runtime symbols
+     */
+    EmitterLLVM(myir::Module &module, const RuntimeMyIR &runtime);
+
+    /**
+     * @brief Translate the function to LLVM IR
+     *
+     * @param func Function in SSA form
+     */
+    void emit(myir::Function *func);
+
+    /**
+     * @brief Make gc roots and emit an object file
+     *
+     * @param obj_file Object file name
+     */
+    void emit_object(const std::string &obj_file);
+};
+
+}; // namespace codegen
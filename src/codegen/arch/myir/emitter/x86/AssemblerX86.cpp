@@ -0,0 +1,94 @@
+#include "AssemblerX86.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cassert>
+
+using namespace codegen;
+
+std::string AssemblerX86::symbol(const std::string &name)
+{
+    // init methods are named like "Main-init"
+    if (std::all_of(name.begin(), name.end(), [](char c) { return std::isalnum(c) || c == '_' || c == '.'; }))
+    {
+        return name;
+    }
+
+    return "\"" + name + "\"";
+}
+
+std::string AssemblerX86::reg(RegX86 reg, int size)
+{
+    static const std::string NAMES[RegX86Size] = {"ax", "cx", "dx", "bx", "sp", "bp", "si", "di",
+                                                  "8",  "9",  "10", "11", "12", "13", "14", "15"};
+
+    const auto &name = NAMES[reg];
+    if (reg >= R8)
+    {
+        switch (size)
+        {
+        case 1:
+            return "%r" + name + "b";
+        case 4:
+            return "%r" + name + "d";
+        default:
+            return "%r" + name;
+        }
+    }
+
+    switch (size)
+    {
+    case 1:
+        // only legacy registers that have low byte without REX
+        assert(reg <= RBX);
+        return "%" + name.substr(0, 1) + "l";
+    case 4:
+        return "%e" + name;
+    default:
+        return "%r" + name;
+    }
+}
+
+std::string AssemblerX86::imm(int64_t value) { return "$" + std::to_string(value); }
+
+std::string AssemblerX86::mem(RegX86 base, int32_t disp)
+{
+    return (disp ? std::to_string(disp) : "") + "(" + reg(base) + ")";
+}
+
+std::string AssemblerX86::mem(RegX86 base, RegX86 index, int32_t disp)
+{
+    return (disp ? std::to_string(disp) : "") + "(" + reg(base) + "," + reg(index) + ")";
+}
+
+std::string AssemblerX86::rip(const std::string &symbol) { return AssemblerX86::symbol(symbol) + "(%rip)"; }
+
+void AssemblerX86::inst(const std::string &mnemonic, const std::string &src, const std::string &dst)
+{
+    _code += std::string(INDENTATION) + mnemonic;
+    if (!src.empty())
+    {
+        _code += " " + src;
+    }
+    if (!dst.empty())
+    {
+        _code += ", " + dst;
+    }
+    _code += "\n";
+}
+
+void AssemblerX86::directive(const std::string &name, const std::string &args)
+{
+    _code += std::string(INDENTATION) + name + (args.empty() ? "" : " " + args) + "\n";
+}
+
+void AssemblerX86::label(const std::string &name) { _code += symbol(name) + ":\n"; }
+
+void AssemblerX86::global(const std::string &name, const std::string &type, int align)
+{
+    const auto sym = symbol(name);
+
+    directive(".globl", sym);
+    directive(".p2align", std::to_string(align));
+    directive(".type", sym + ", " + type);
+    label(name);
+}
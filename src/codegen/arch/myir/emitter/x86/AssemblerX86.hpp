@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace codegen
+{
+
+/**
+ * @brief x86-64 general purpose registers in the order of their encoding
+ *
+ */
+enum RegX86
+{
+    RAX,
+    RCX,
+    RDX,
+    RBX,
+    RSP,
+    RBP,
+    RSI,
+    RDI,
+    R8,
+    R9,
+    R10,
+    R11,
+    R12,
+    R13,
+    R14,
+    R15,
+
+    RegX86Size
+};
+
+/**
+ * @brief Text assembler for x86-64 in AT&T syntax
+ *
+ * Output is assembled by the system assembler, so this class only formats instructions and directives.
+ */
+class AssemblerX86
+{
+  private:
+    static constexpr std::string_view INDENTATION = "    ";
+
+    std::string _code;
+
+  public:
+    /**
+     * @brief Symbol name that is safe for the assembler
+     *
+     * @param name Symbol name
+     * @return Name in quotes if it contains special characters
+     */
+    static std::string symbol(const std::string &name);
+
+    /**
+     * @brief Register operand
+     *
+     * @param reg Register
+     * @param size Size of the operand in bytes
+     * @return Register name
+     */
+    static std::string reg(RegX86 reg, int size = 8);
+
+    /**
+     * @brief Immediate operand
+     *
+     * @param value Value
+     * @return Immediate
+     */
+    static std::string imm(int64_t value);
+
+    /**
+     * @brief Memory operand base + disp
+     *
+     * @param base Base register
+     * @param disp Displacement
+     * @return Memory operand
+     */
+    static std::string mem(RegX86 base, int32_t disp = 0);
+
+    /**
+     * @brief Memory operand base + index + disp
+     *
+     * @param base Base register
+     * @param index Index register
+     * @param disp Displacement
+     * @return Memory operand
+     */
+    static std::string mem(RegX86 base, RegX86 index, int32_t disp = 0);
+
+    /**
+     * @brief Memory operand relative to the instruction pointer
+     *
+     * @param symbol Symbol
+     * @return Memory operand
+     */
+    static std::string rip(const std::string &symbol);
+
+    /**
+     * @brief Check if value fits into the sign extended 32 bit immediate
+     *
+     * @param value Value
+     * @return true if it fits
+     */
+    static bool is_imm32(int64_t value) { return value >= INT32_MIN && value <= INT32_MAX; }
+
+    /**
+     * @brief Emit instruction
+     *
+     * @param mnemonic Instruction name
+     * @param src Source operand or the only operand
+     * @param dst Destination operand
+     */
+    void inst(const std::string &mnemonic, const std::string &src = "", const std::string &dst = "");
+
+    /**
+     * @brief Emit directive
+     *
+     * @param name Directive with the dot
+     * @param args Arguments
+     */
+    void directive(const std::string &name, const std::string &args = "");
+
+    /**
+     * @brief Bind label
+     *
+     * @param name Label name
+     */
+    void label(const std::string &name);
+
+    /**
+     * @brief Start a global symbol
+     *
+     * @param name Symbol name
+     * @param type @function or @object
+     * @param align Alignment as a power of two
+     */
+    void global(const std::string &name, const std::string &type, int align);
+
+    /**
+     * @brief Get the code
+     *
+     * @return Assembler text
+     */
+    inline const std::string &code() const { return _code; }
+};
+
+}; // namespace codegen
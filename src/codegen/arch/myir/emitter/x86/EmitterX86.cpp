@@ -0,0 +1,776 @@
+#include "EmitterX86.hpp"
+#include "codegen/arch/myir/ir/IR.inline.hpp"
+#include "codegen/arch/myir/ir/cfg/CFG.inline.hpp"
+
+using namespace codegen;
+
+const std::vector<RegX86> EmitterX86::ARGS_REGISTERS = {RDI, RSI, RDX, RCX, R8, R9};
+
+void EmitterX86::emit(myir::Function *func)
+{
+    _func = func;
+
+    // traversal needs ids of this function
+    func->reset_max_ids();
+    const auto blocks = func->cfg()->traversal<myir::CFG::REVERSE_POSTORDER>();
+    func->record_max_ids();
+
+    _alloc = std::make_unique<LinearScan>(func, blocks);
+
+    const auto name = func->short_name();
+    const int func_id = _stack_maps.size();
+
+    _block_labels.clear();
+    for (auto *b : blocks)
+    {
+        _block_labels[b] = ".LBB" + std::to_string(func_id) + "_" + std::to_string(b->id());
+    }
+
+    // 16 byte aligned frame keeps rsp aligned for calls
+    const int frame_size = (WORD_SIZE * ((int)_alloc->used_regs().size() + _alloc->slots()) +
+                            outgoing_args_size(blocks) + 2 * WORD_SIZE - 1) &
+                           ~(2 * WORD_SIZE - 1);
+
+    _asm.directive(".text");
+    _asm.global(name, "@function", 4);
+
+    emit_prologue(frame_size);
+
+    // stack size includes saved rbp, so the walker finds return address of the caller
+    _stack_maps.push_back({name, frame_size + WORD_SIZE, {}});
+
+    for (int i = 0; i < blocks.size(); i++)
+    {
+        auto *b = blocks[i];
+        _next_block = i + 1 < blocks.size() ? blocks[i + 1] : nullptr;
+
+        _fused.clear();
+        if (myir::Instruction::isa<myir::CondBranch>(b->insts().back()))
+        {
+            bool inverted = false;
+            auto *cmp = fused_compare(myir::Instruction::as<myir::CondBranch>(b->insts().back()), inverted);
+            if (cmp)
+            {
+                _fused.insert(cmp);
+                _fused.insert(b->insts().back()->use(0)->def());
+            }
+        }
+
+        _asm.label(_block_labels.at(b));
+        for (auto *inst : b->insts())
+        {
+            if (_fused.find(inst) == _fused.end())
+            {
+                emit(inst);
+            }
+        }
+    }
+
+    _asm.directive(".size", AssemblerX86::symbol(name) + ", .-" + AssemblerX86::symbol(name));
+
+    _alloc.reset();
+}
+
+int EmitterX86::outgoing_args_size(const std::vector<myir::Block *> &blocks)
+{
+    int size = 0;
+    for (auto *b : blocks)
+    {
+        for (auto *inst : b->insts())
+        {
+            if (myir::Instruction::isa<myir::Call>(inst))
+            {
+                // the first use is a callee
+                const int args = inst->uses().size() - 1;
+                size = std::max(size, (args - (int)ARGS_REGISTERS.size()) * WORD_SIZE);
+            }
+        }
+    }
+
+    return size;
+}
+
+void EmitterX86::emit_prologue(int frame_size)
+{
+    _asm.inst("pushq", AssemblerX86::reg(RBP));
+    _asm.inst("movq", AssemblerX86::reg(RSP), AssemblerX86::reg(RBP));
+    if (frame_size)
+    {
+        _asm.inst("subq", AssemblerX86::imm(frame_size), AssemblerX86::reg(RSP));
+    }
+
+    const auto &saved = _alloc->used_regs();
+    for (int i = 0; i < saved.size(); i++)
+    {
+        _asm.inst("movq", AssemblerX86::reg(saved[i]), AssemblerX86::mem(RBP, -WORD_SIZE * (i + 1)));
+    }
+
+    // move params to their locations
+    for (int i = 0; i < _func->params_size(); i++)
+    {
+        auto *param = _func->param(i);
+        if (_alloc->location(param)._kind == LinearScan::Location::NONE)
+        {
+            continue;
+        }
+
+        const auto src = i < ARGS_REGISTERS.size()
+                             ? AssemblerX86::reg(ARGS_REGISTERS[i])
+                             : AssemblerX86::mem(RBP, FRAME_INFO_SIZE + WORD_SIZE * (i - (int)ARGS_REGISTERS.size()));
+
+        _asm.inst("movq", src, AssemblerX86::reg(RAX));
+        extend(param->type(), RAX);
+        store(param, RAX);
+    }
+}
+
+void EmitterX86::emit_epilogue()
+{
+    const auto &saved = _alloc->used_regs();
+    for (int i = 0; i < saved.size(); i++)
+    {
+        _asm.inst("movq", AssemblerX86::mem(RBP, -WORD_SIZE * (i + 1)), AssemblerX86::reg(saved[i]));
+    }
+
+    _asm.inst("leave");
+    _asm.inst("ret");
+}
+
+int EmitterX86::slot_offset(int slot) const
+{
+    return -WORD_SIZE * ((int)_alloc->used_regs().size() + slot + 1);
+}
+
+std::string EmitterX86::location(myir::Operand *value) const
+{
+    const auto loc = _alloc->location(value);
+    assert(loc._kind != LinearScan::Location::NONE);
+
+    return loc._kind == LinearScan::Location::REGISTER ? AssemblerX86::reg(loc._reg)
+                                                       : AssemblerX86::mem(RBP, slot_offset(loc._slot));
+}
+
+int64_t EmitterX86::constant_value(myir::Constant *constant)
+{
+    const auto value = constant->value();
+
+    switch (constant->type())
+    {
+    case myir::INT8:
+        return (int8_t)value;
+    case myir::UINT8:
+        return (uint8_t)value;
+    case myir::INT32:
+        return (int32_t)value;
+    case myir::UINT32:
+        return (uint32_t)value;
+    }
+
+    return (int64_t)value;
+}
+
+std::string EmitterX86::symbol_name(myir::Operand *oper)
+{
+    if (myir::Operand::isa<myir::Function>(oper))
+    {
+        return myir::Operand::as<myir::Function>(oper)->short_name();
+    }
+
+    return oper->name();
+}
+
+void EmitterX86::load(myir::Operand *oper, RegX86 reg)
+{
+    if (myir::Operand::isa<myir::Constant>(oper))
+    {
+        const auto value = constant_value(myir::Operand::as<myir::Constant>(oper));
+
+        if (value == 0)
+        {
+            _asm.inst("xorl", AssemblerX86::reg(reg, 4), AssemblerX86::reg(reg, 4));
+        }
+        else if (value > 0 && value <= UINT32_MAX)
+        {
+            // zero extends
+            _asm.inst("movl", AssemblerX86::imm(value), AssemblerX86::reg(reg, 4));
+        }
+        else
+        {
+            _asm.inst(AssemblerX86::is_imm32(value) ? "movq" : "movabsq", AssemblerX86::imm(value),
+                      AssemblerX86::reg(reg));
+        }
+        return;
+    }
+
+    if (myir::Operand::isa<myir::Function>(oper) && myir::Operand::as<myir::Function>(oper)->cfg()->empty())
+    {
+        // defined by the runtime library
+        _asm.inst("movq", AssemblerX86::symbol(symbol_name(oper)) + "@GOTPCREL(%rip)", AssemblerX86::reg(reg));
+        return;
+    }
+
+    if (myir::Operand::isa<myir::GlobalConstant>(oper))
+    {
+        _asm.inst("leaq", AssemblerX86::rip(symbol_name(oper)), AssemblerX86::reg(reg));
+        return;
+    }
+
+    // global variables are thread local and used only by calls
+    assert(!myir::Operand::isa<myir::GlobalVariable>(oper));
+
+    const auto loc = _alloc->location(oper);
+    if (loc._kind != LinearScan::Location::REGISTER || loc._reg != reg)
+    {
+        _asm.inst("movq", location(oper), AssemblerX86::reg(reg));
+    }
+}
+
+void EmitterX86::store(myir::Operand *value, RegX86 reg)
+{
+    const auto loc = _alloc->location(value);
+    if (loc._kind == LinearScan::Location::NONE || loc._kind == LinearScan::Location::REGISTER && loc._reg == reg)
+    {
+        return;
+    }
+
+    _asm.inst("movq", AssemblerX86::reg(reg), location(value));
+}
+
+void EmitterX86::extend(myir::OperandType type, RegX86 reg)
+{
+    switch (type)
+    {
+    case myir::INT8:
+        _asm.inst("movsbq", AssemblerX86::reg(reg, 1), AssemblerX86::reg(reg));
+        break;
+    case myir::UINT8:
+        _asm.inst("movzbl", AssemblerX86::reg(reg, 1), AssemblerX86::reg(reg, 4));
+        break;
+    case myir::INT32:
+        _asm.inst("movslq", AssemblerX86::reg(reg, 4), AssemblerX86::reg(reg));
+        break;
+    case myir::UINT32:
+        _asm.inst("movl", AssemblerX86::reg(reg, 4), AssemblerX86::reg(reg, 4));
+        break;
+    }
+}
+
+std::string EmitterX86::operand(myir::Operand *oper, RegX86 scratch)
+{
+    if (myir::Operand::isa<myir::Constant>(oper))
+    {
+        const auto value = constant_value(myir::Operand::as<myir::Constant>(oper));
+        if (AssemblerX86::is_imm32(value))
+        {
+            return AssemblerX86::imm(value);
+        }
+    }
+    else if (LinearScan::is_value(oper))
+    {
+        return location(oper);
+    }
+
+    load(oper, scratch);
+    return AssemblerX86::reg(scratch);
+}
+
+RegX86 EmitterX86::in_register(myir::Operand *oper, RegX86 scratch)
+{
+    const auto loc = _alloc->location(oper);
+    if (loc._kind == LinearScan::Location::REGISTER)
+    {
+        return loc._reg;
+    }
+
+    load(oper, scratch);
+    return scratch;
+}
+
+std::string EmitterX86::address(myir::Operand *base, myir::Operand *offset)
+{
+    const auto base_reg = in_register(base, RCX);
+
+    if (myir::Operand::isa<myir::Constant>(offset))
+    {
+        const auto value = constant_value(myir::Operand::as<myir::Constant>(offset));
+        if (AssemblerX86::is_imm32(value))
+        {
+            return AssemblerX86::mem(base_reg, value);
+        }
+    }
+
+    return AssemblerX86::mem(base_reg, in_register(offset, RDX));
+}
+
+void EmitterX86::emit(myir::Instruction *inst)
+{
+    if (myir::Instruction::isa<myir::Store>(inst))
+    {
+        emit_store(myir::Instruction::as<myir::Store>(inst));
+    }
+    else if (myir::Instruction::isa<myir::Load>(inst))
+    {
+        emit_load(myir::Instruction::as<myir::Load>(inst));
+    }
+    else if (myir::Instruction::isa<myir::BinaryInst>(inst))
+    {
+        emit_binary(myir::Instruction::as<myir::BinaryInst>(inst));
+    }
+    else if (myir::Instruction::isa<myir::UnaryInst>(inst))
+    {
+        emit_unary(myir::Instruction::as<myir::UnaryInst>(inst));
+    }
+    else if (myir::Instruction::isa<myir::Call>(inst))
+    {
+        emit_call(myir::Instruction::as<myir::Call>(inst));
+    }
+    else if (myir::Instruction::isa<myir::Ret>(inst))
+    {
+        emit_ret(myir::Instruction::as<myir::Ret>(inst));
+    }
+    else if (myir::Instruction::isa<myir::Branch>(inst))
+    {
+        emit_branch(myir::Instruction::as<myir::Branch>(inst));
+    }
+    else if (myir::Instruction::isa<myir::CondBranch>(inst))
+    {
+        emit_cond_branch(myir::Instruction::as<myir::CondBranch>(inst));
+    }
+    else
+    {
+        SHOULD_NOT_REACH_HERE();
+    }
+}
+
+void EmitterX86::emit_store(myir::Store *store)
+{
+    const auto addr = address(store->use(0), store->use(1));
+    auto *value = store->use(2);
+
+    // all fields are 8 bytes
+    if (myir::Operand::isa<myir::Constant>(value) &&
+        AssemblerX86::is_imm32(constant_value(myir::Operand::as<myir::Constant>(value))))
+    {
+        _asm.inst("movq", operand(value, RAX), addr);
+        return;
+    }
+
+    _asm.inst("movq", AssemblerX86::reg(in_register(value, RAX)), addr);
+}
+
+void EmitterX86::emit_load(myir::Load *load)
+{
+    const auto addr = address(load->use(0), load->use(1));
+    auto *def = load->def();
+
+    const auto loc = _alloc->location(def);
+    const auto dst = loc._kind == LinearScan::Location::REGISTER ? loc._reg : RAX;
+
+    switch (def->type())
+    {
+    case myir::INT8:
+        _asm.inst("movsbq", addr, AssemblerX86::reg(dst));
+        break;
+    case myir::UINT8:
+        _asm.inst("movzbl", addr, AssemblerX86::reg(dst, 4));
+        break;
+    case myir::INT32:
+        _asm.inst("movslq", addr, AssemblerX86::reg(dst));
+        break;
+    case myir::UINT32:
+        _asm.inst("movl", addr, AssemblerX86::reg(dst, 4));
+        break;
+    default:
+        _asm.inst("movq", addr, AssemblerX86::reg(dst));
+    }
+
+    store(def, dst);
+}
+
+bool EmitterX86::is_compare(myir::Instruction *inst)
+{
+    return myir::Instruction::isa<myir::BinaryLogicInst>(inst);
+}
+
+std::string EmitterX86::condition(myir::Instruction *cmp, bool inverted)
+{
+    if (myir::Instruction::isa<myir::LT>(cmp))
+    {
+        return inverted ? "ge" : "l";
+    }
+    if (myir::Instruction::isa<myir::LE>(cmp))
+    {
+        return inverted ? "g" : "le";
+    }
+    if (myir::Instruction::isa<myir::GT>(cmp))
+    {
+        return inverted ? "le" : "g";
+    }
+
+    assert(myir::Instruction::isa<myir::EQ>(cmp));
+    return inverted ? "ne" : "e";
+}
+
+void EmitterX86::emit_compare(myir::Instruction *cmp)
+{
+    load(cmp->use(0), RAX);
+    _asm.inst("cmpq", operand(cmp->use(1), RCX), AssemblerX86::reg(RAX));
+}
+
+void EmitterX86::emit_binary(myir::BinaryInst *inst)
+{
+    auto *lhs = inst->use(0);
+    auto *rhs = inst->use(1);
+
+    if (is_compare(inst))
+    {
+        emit_compare(inst);
+        _asm.inst("set" + condition(inst, false), AssemblerX86::reg(RAX, 1));
+        _asm.inst("movzbl", AssemblerX86::reg(RAX, 1), AssemblerX86::reg(RAX, 4));
+        store(inst->def(), RAX);
+        return;
+    }
+
+    load(lhs, RAX);
+
+    if (myir::Instruction::isa<myir::Div>(inst))
+    {
+        load(rhs, RCX);
+        _asm.inst("cqto");
+        _asm.inst("idivq", AssemblerX86::reg(RCX));
+    }
+    else if (myir::Instruction::isa<myir::Shl>(inst))
+    {
+        if (myir::Operand::isa<myir::Constant>(rhs))
+        {
+            _asm.inst("shlq", AssemblerX86::imm(constant_value(myir::Operand::as<myir::Constant>(rhs))),
+                      AssemblerX86::reg(RAX));
+        }
+        else
+        {
+            load(rhs, RCX);
+            _asm.inst("shlq", AssemblerX86::reg(RCX, 1), AssemblerX86::reg(RAX));
+        }
+    }
+    else
+    {
+        std::string mnemonic;
+        if (myir::Instruction::isa<myir::Add>(inst))
+        {
+            mnemonic = "addq";
+        }
+        else if (myir::Instruction::isa<myir::Sub>(inst))
+        {
+            mnemonic = "subq";
+        }
+        else if (myir::Instruction::isa<myir::Mul>(inst))
+        {
+            mnemonic = "imulq";
+        }
+        else if (myir::Instruction::isa<myir::Xor>(inst))
+        {
+            mnemonic = "xorq";
+        }
+        else if (myir::Instruction::isa<myir::Or>(inst))
+        {
+            mnemonic = "orq";
+        }
+        else
+        {
+            SHOULD_NOT_REACH_HERE();
+        }
+
+        _asm.inst(mnemonic, operand(rhs, RCX), AssemblerX86::reg(RAX));
+    }
+
+    store(inst->def(), RAX);
+}
+
+void EmitterX86::emit_unary(myir::UnaryInst *inst)
+{
+    auto *def = inst->def();
+    auto *value = inst->use(0);
+
+    if (myir::Instruction::isa<myir::Move>(inst))
+    {
+        const auto loc = _alloc->location(def);
+        if (loc._kind == LinearScan::Location::REGISTER)
+        {
+            load(value, loc._reg);
+        }
+        else if (loc._kind == LinearScan::Location::SLOT)
+        {
+            if (myir::Operand::isa<myir::Constant>(value) &&
+                AssemblerX86::is_imm32(constant_value(myir::Operand::as<myir::Constant>(value))))
+            {
+                _asm.inst("movq", operand(value, RAX), location(def));
+            }
+            else
+            {
+                store(def, in_register(value, RAX));
+            }
+        }
+        return;
+    }
+
+    load(value, RAX);
+
+    if (myir::Instruction::isa<myir::Neg>(inst))
+    {
+        _asm.inst("negq", AssemblerX86::reg(RAX));
+    }
+    else
+    {
+        assert(myir::Instruction::isa<myir::Not>(inst));
+        _asm.inst("xorq", AssemblerX86::imm(1), AssemblerX86::reg(RAX));
+    }
+
+    store(def, RAX);
+}
+
+void EmitterX86::emit_call(myir::Call *call)
+{
+    auto *callee = call->callee();
+    auto *target = call->use(0);
+    const bool is_direct = myir::Operand::isa<myir::Function>(target);
+
+    const int args = call->uses().size() - 1;
+
+    // stack arguments first, because rax is a scratch
+    for (int i = ARGS_REGISTERS.size(); i < args; i++)
+    {
+        load(call->use(i + 1), RAX);
+        _asm.inst("movq", AssemblerX86::reg(RAX), AssemblerX86::mem(RSP, WORD_SIZE * (i - (int)ARGS_REGISTERS.size())));
+    }
+
+    for (int i = 0; i < args && i < ARGS_REGISTERS.size(); i++)
+    {
+        load(call->use(i + 1), ARGS_REGISTERS[i]);
+    }
+
+    if (!is_direct)
+    {
+        load(target, R11);
+    }
+
+    // runtime starts stack walking from the last frame of the program
+    if (!callee->is_leaf() && (!is_direct || callee->cfg()->empty()))
+    {
+        _asm.inst("movq", AssemblerX86::reg(RSP),
+                  "%fs:" + AssemblerX86::symbol(_runtime.symbol_name(RuntimeMyIR::STACK_POINTER)) + "@tpoff");
+        _asm.inst("movq", AssemblerX86::reg(RBP),
+                  "%fs:" + AssemblerX86::symbol(_runtime.symbol_name(RuntimeMyIR::FRAME_POINTER)) + "@tpoff");
+    }
+
+    if (is_direct)
+    {
+        const auto name = AssemblerX86::symbol(symbol_name(target));
+        _asm.inst("call", callee->cfg()->empty() ? name + "@PLT" : name);
+    }
+    else
+    {
+        _asm.inst("call", "*" + AssemblerX86::reg(R11));
+    }
+
+    if (LinearScan::is_safepoint(call))
+    {
+        Safepoint safepoint{".Lsm" + std::to_string(_labels++), {}};
+        _asm.label(safepoint._label);
+
+        for (auto *root : _alloc->live_roots(call))
+        {
+            safepoint._offsets.push_back(slot_offset(_alloc->location(root)._slot));
+        }
+
+        _stack_maps.back()._safepoints.push_back(std::move(safepoint));
+    }
+
+    if (call->def())
+    {
+        extend(callee->return_type(), RAX);
+        store(call->def(), RAX);
+    }
+}
+
+void EmitterX86::emit_ret(myir::Ret *ret)
+{
+    if (!ret->uses().empty())
+    {
+        load(ret->use(0), RAX);
+    }
+
+    emit_epilogue();
+}
+
+void EmitterX86::emit_branch(myir::Branch *br)
+{
+    if (br->dest() != _next_block)
+    {
+        _asm.inst("jmp", _block_labels.at(br->dest()));
+    }
+}
+
+myir::Instruction *EmitterX86::fused_compare(myir::CondBranch *br, bool &inverted) const
+{
+    // compare has to be right before the branch, otherwise its operands can be overwritten
+    auto *cond = br->use(0);
+    if (!LinearScan::is_value(cond) || cond->uses().size() != 1 || !cond->has_def())
+    {
+        return nullptr;
+    }
+
+    const auto &insts = br->holder()->insts();
+    auto prev = std::prev(insts.end(), 2);
+
+    if (*prev != cond->def())
+    {
+        return nullptr;
+    }
+
+    inverted = false;
+    if (myir::Instruction::isa<myir::Not>(*prev) && prev != insts.begin())
+    {
+        auto *value = (*prev)->use(0);
+        prev--;
+        if (!LinearScan::is_value(value) || value->uses().size() != 1 || *prev != value->def())
+        {
+            return nullptr;
+        }
+
+        inverted = true;
+    }
+
+    return is_compare(*prev) ? *prev : nullptr;
+}
+
+void EmitterX86::emit_jumps(const std::string &cond, myir::Block *taken, myir::Block *not_taken)
+{
+    static const std::unordered_map<std::string, std::string> INVERTED = {{"l", "ge"}, {"ge", "l"}, {"le", "g"},
+                                                                          {"g", "le"}, {"e", "ne"}, {"ne", "e"}};
+
+    if (taken == _next_block)
+    {
+        _asm.inst("j" + INVERTED.at(cond), _block_labels.at(not_taken));
+        return;
+    }
+
+    _asm.inst("j" + cond, _block_labels.at(taken));
+    if (not_taken != _next_block)
+    {
+        _asm.inst("jmp", _block_labels.at(not_taken));
+    }
+}
+
+void EmitterX86::emit_cond_branch(myir::CondBranch *br)
+{
+    auto *cond = br->use(0);
+
+    bool inverted = false;
+    auto *cmp = fused_compare(br, inverted);
+    if (cmp)
+    {
+        emit_compare(cmp);
+        emit_jumps(condition(cmp, inverted), br->taken(), br->not_taken());
+        return;
+    }
+
+    if (myir::Operand::isa<myir::Constant>(cond))
+    {
+        auto *dest = myir::Operand::as<myir::Constant>(cond)->value() ? br->taken() : br->not_taken();
+        if (dest != _next_block)
+        {
+            _asm.inst("jmp", _block_labels.at(dest));
+        }
+        return;
+    }
+
+    _asm.inst("cmpq", AssemblerX86::imm(0), operand(cond, RAX));
+    emit_jumps("ne", br->taken(), br->not_taken());
+}
+
+void EmitterX86::emit_stack_maps()
+{
+    int records = 0;
+    for (const auto &func : _stack_maps)
+    {
+        records += func._safepoints.size() + 1;
+    }
+
+    _asm.directive(".section", std::string(STACKMAP_SECTION_NAME) + ",\"aw\",@progbits");
+    _asm.directive(".p2align", "3");
+
+    // header
+    _asm.directive(".byte", std::to_string(STACKMAP_VERSION));
+    _asm.directive(".byte", "0");
+    _asm.directive(".short", "0");
+    _asm.directive(".long", std::to_string(_stack_maps.size()));
+    _asm.directive(".long", "0"); // constants
+    _asm.directive(".long", std::to_string(records));
+
+    // functions
+    for (const auto &func : _stack_maps)
+    {
+        _asm.directive(".quad", AssemblerX86::symbol(func._name));
+        _asm.directive(".quad", std::to_string(func._stack_size));
+        _asm.directive(".quad", std::to_string(func._safepoints.size() + 1));
+    }
+
+    auto location = [this](int type, int reg, int offset) {
+        _asm.directive(".byte", std::to_string(type));
+        _asm.directive(".byte", "0");
+        _asm.directive(".short", std::to_string(WORD_SIZE));
+        _asm.directive(".short", std::to_string(reg));
+        _asm.directive(".short", "0");
+        _asm.directive(".long", std::to_string(offset));
+    };
+
+    auto record = [this](uint64_t id, const std::string &offset, int locations) {
+        _asm.directive(".quad", std::to_string(id));
+        _asm.directive(".long", offset);
+        _asm.directive(".short", "0");
+        _asm.directive(".short", std::to_string(locations));
+    };
+
+    auto record_tail = [this]() {
+        _asm.directive(".p2align", "3");
+        _asm.directive(".short", "0");
+        _asm.directive(".short", "0"); // live outs
+        _asm.directive(".p2align", "3");
+    };
+
+    // location types and DWARF numbers of rbp
+    static const int INDIRECT = 3;
+    static const int CONSTANT = 4;
+    static const int FP = 6;
+
+    // the same id as LLVM uses for statepoints by default
+    static const uint64_t STATEPOINT_ID = 0xABCDEF00;
+
+    for (const auto &func : _stack_maps)
+    {
+        // the special record for the locals that are always live: there are no such locals
+        record(0, "0", 0);
+        record_tail();
+
+        for (const auto &safepoint : func._safepoints)
+        {
+            record(STATEPOINT_ID, safepoint._label + "-" + AssemblerX86::symbol(func._name),
+                   3 + 2 * safepoint._offsets.size());
+
+            // calling convention, flags and number of deopt args
+            for (int i = 0; i < 3; i++)
+            {
+                location(CONSTANT, 0, 0);
+            }
+
+            // objects are not derived pointers, so base and derived are the same slot
+            for (auto offset : safepoint._offsets)
+            {
+                location(INDIRECT, FP, offset);
+                location(INDIRECT, FP, offset);
+            }
+
+            record_tail();
+        }
+    }
+}
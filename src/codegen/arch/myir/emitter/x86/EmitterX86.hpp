@@ -0,0 +1,134 @@
+#pragma once
+
+#include "AssemblerX86.hpp"
+#include "LinearScan.hpp"
+#include "codegen/arch/myir/ir/IR.hpp"
+#include "codegen/arch/myir/runtime/RuntimeMyIR.hpp"
+#include <memory>
+#include <unordered_set>
+
+namespace codegen
+{
+
+/**
+ * @brief Instruction selection for MyIR functions
+ *
+ * Frame of the function is addressed by rbp: saved callee-saved registers, stack slots and the area for the stack
+ * arguments of the calls. rsp doesn't change after the prologue, so the stack walker finds the previous frame by the
+ * frame size. Every call that can cause GC gets a stack map record with the stack slots of live objects. Format of
+ * the stack maps is the same as LLVM uses for statepoints, so the runtime parses them in the same way.
+ */
+class EmitterX86
+{
+  private:
+    static constexpr std::string_view STACKMAP_SECTION_NAME = "llvm_stackmaps";
+    static constexpr int STACKMAP_VERSION = 3;
+
+    static const std::vector<RegX86> ARGS_REGISTERS;
+
+    // calls save a return address and rbp
+    static constexpr int FRAME_INFO_SIZE = 16;
+
+    struct Safepoint
+    {
+        std::string _label;
+        std::vector<int> _offsets; // offsets of the objects from rbp
+    };
+
+    struct FunctionStackMap
+    {
+        std::string _name;
+        int _stack_size;
+        std::vector<Safepoint> _safepoints;
+    };
+
+    AssemblerX86 &_asm;
+    const RuntimeMyIR &_runtime;
+
+    std::vector<FunctionStackMap> _stack_maps;
+    int _labels;
+
+    // state of the current function
+    myir::Function *_func;
+    std::unique_ptr<LinearScan> _alloc;
+    std::unordered_map<myir::Block *, std::string> _block_labels;
+    std::unordered_set<myir::Instruction *> _fused; // compares that are emitted with the branch
+    myir::Block *_next_block;
+
+    // instructions
+    void emit(myir::Instruction *inst);
+    void emit_store(myir::Store *store);
+    void emit_load(myir::Load *load);
+    void emit_binary(myir::BinaryInst *inst);
+    void emit_unary(myir::UnaryInst *inst);
+    void emit_call(myir::Call *call);
+    void emit_ret(myir::Ret *ret);
+    void emit_branch(myir::Branch *br);
+    void emit_cond_branch(myir::CondBranch *br);
+
+    // compare and branch
+    void emit_compare(myir::Instruction *cmp);
+    static std::string condition(myir::Instruction *cmp, bool inverted);
+    static bool is_compare(myir::Instruction *inst);
+    myir::Instruction *fused_compare(myir::CondBranch *br, bool &inverted) const;
+    void emit_jumps(const std::string &cond, myir::Block *taken, myir::Block *not_taken);
+
+    // prologue and epilogue
+    void emit_prologue(int frame_size);
+    void emit_epilogue();
+
+    // operands
+    int slot_offset(int slot) const;
+    std::string location(myir::Operand *value) const;
+    std::string operand(myir::Operand *oper, RegX86 scratch);
+    RegX86 in_register(myir::Operand *oper, RegX86 scratch);
+    std::string address(myir::Operand *base, myir::Operand *offset);
+    void load(myir::Operand *oper, RegX86 reg);
+    void store(myir::Operand *value, RegX86 reg);
+    void extend(myir::OperandType type, RegX86 reg);
+
+    static int outgoing_args_size(const std::vector<myir::Block *> &blocks);
+
+  public:
+    /**
+     * @brief Construct a new EmitterX86
+     *
+     * @param assembler Output
+     * @param runtime Runtime symbols
+     */
+    EmitterX86(AssemblerX86 &assembler, const RuntimeMyIR &runtime)
+        : _asm(assembler), _runtime(runtime), _labels(0), _func(nullptr), _next_block(nullptr)
+    {
+    }
+
+    /**
+     * @brief Emit code of the function
+     *
+     * @param func Function after SSA destruction
+     */
+    void emit(myir::Function *func);
+
+    /**
+     * @brief Emit stack maps for all emitted functions
+     *
+     */
+    void emit_stack_maps();
+
+    /**
+     * @brief Value of the constant extended to 64 bits according to its type
+     *
+     * @param constant Constant
+     * @return Value
+     */
+    static int64_t constant_value(myir::Constant *constant);
+
+    /**
+     * @brief Name of the symbol for the global operand
+     *
+     * @param oper Function, global constant or global variable
+     * @return Symbol name
+     */
+    static std::string symbol_name(myir::Operand *oper);
+};
+
+}; // namespace codegen
@@ -0,0 +1,409 @@
+#include "LinearScan.hpp"
+#include "codegen/arch/myir/ir/IR.inline.hpp"
+#include "codegen/arch/myir/runtime/RuntimeMyIR.hpp"
+#include <climits>
+
+using namespace codegen;
+
+// only callee-saved registers: runtime and methods keep them across calls
+const std::vector<RegX86> LinearScan::REGISTERS = {RBX, R12, R13, R14, R15};
+
+bool LinearScan::is_value(myir::Operand *oper)
+{
+    return !myir::Operand::isa<myir::Constant>(oper) && !myir::Operand::isa<myir::StructuredOperand>(oper);
+}
+
+bool LinearScan::is_safepoint(myir::Instruction *inst)
+{
+    return myir::Instruction::isa<myir::Call>(inst) && !myir::Instruction::as<myir::Call>(inst)->callee()->is_leaf();
+}
+
+LinearScan::LinearScan(myir::Function *func, const std::vector<myir::Block *> &blocks)
+    : _blocks(blocks), _func(func), _slots(0)
+{
+    number();
+    build_intervals();
+    allocate_registers();
+    allocate_slots();
+}
+
+void LinearScan::number()
+{
+    auto add = [this](myir::Operand *oper) {
+        if (is_value(oper) && _index.find(oper) == _index.end())
+        {
+            _index[oper] = _values.size();
+            _values.push_back(oper);
+        }
+    };
+
+    for (auto *param : _func->params())
+    {
+        add(param);
+    }
+
+    // leave a gap between instructions, so a value that is live out of the block outlives its last instruction
+    int pos = 0;
+    for (auto *b : _blocks)
+    {
+        assert(!b->insts().empty());
+        for (auto *inst : b->insts())
+        {
+            assert(!myir::Instruction::isa<myir::Phi>(inst));
+
+            _position[inst] = pos;
+            pos += 2;
+
+            if (inst->def())
+            {
+                add(inst->def());
+            }
+
+            for (auto *use : inst->uses())
+            {
+                add(use);
+            }
+        }
+    }
+}
+
+std::vector<bool> LinearScan::raw_pointers() const
+{
+    // dispatch tables, methods and init methods are not objects, so GC must not see them
+    std::vector<bool> raw(_values.size());
+
+    auto is_raw = [this, &raw](myir::Operand *oper) {
+        if (myir::Operand::isa<myir::GlobalConstant>(oper))
+        {
+            return oper->type() == myir::STRUCTURE;
+        }
+        return is_value(oper) && raw[_index.at(oper)];
+    };
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (auto *b : _blocks)
+        {
+            for (auto *inst : b->insts())
+            {
+                auto *def = inst->def();
+                if (!def || raw[_index.at(def)])
+                {
+                    continue;
+                }
+
+                bool raw_def = false;
+                if (myir::Instruction::isa<myir::Load>(inst))
+                {
+                    auto *offset = inst->use(1);
+                    raw_def = is_raw(inst->use(0)) ||
+                              myir::Operand::isa<myir::Constant>(offset) &&
+                                  myir::Operand::as<myir::Constant>(offset)->value() ==
+                                      HeaderLayoutOffsets::DispatchTableOffset;
+                }
+                else if (myir::Instruction::isa<myir::Move>(inst))
+                {
+                    raw_def = is_raw(inst->use(0));
+                }
+
+                if (raw_def)
+                {
+                    raw[_index.at(def)] = true;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    return raw;
+}
+
+void LinearScan::extend(int value, int pos)
+{
+    _start[value] = std::min(_start[value], pos);
+    _end[value] = std::max(_end[value], pos);
+}
+
+void LinearScan::build_intervals()
+{
+    const int values = _values.size();
+    const int blocks = _blocks.size();
+
+    _start.assign(values, INT_MAX);
+    _end.assign(values, -1);
+    _in_memory.assign(values, false);
+
+    // params are defined before the first instruction
+    for (auto *param : _func->params())
+    {
+        extend(_index.at(param), -1);
+    }
+
+    std::unordered_map<myir::Block *, int> block_index;
+    for (int i = 0; i < blocks; i++)
+    {
+        block_index[_blocks[i]] = i;
+    }
+
+    // upward exposed uses and defs of the blocks
+    std::vector<std::vector<bool>> gen(blocks, std::vector<bool>(values));
+    std::vector<std::vector<bool>> kill(blocks, std::vector<bool>(values));
+
+    for (int i = 0; i < blocks; i++)
+    {
+        for (auto *inst : _blocks[i]->insts())
+        {
+            for (auto *use : inst->uses())
+            {
+                if (is_value(use) && !kill[i][_index.at(use)])
+                {
+                    gen[i][_index.at(use)] = true;
+                }
+            }
+
+            if (inst->def())
+            {
+                kill[i][_index.at(inst->def())] = true;
+            }
+        }
+    }
+
+    // iterative liveness analysis in postorder
+    std::vector<std::vector<bool>> live_in(blocks, std::vector<bool>(values));
+    std::vector<std::vector<bool>> live_out(blocks, std::vector<bool>(values));
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (int i = blocks - 1; i >= 0; i--)
+        {
+            std::vector<bool> out(values);
+            for (auto *succ : _blocks[i]->succs())
+            {
+                const auto &succ_in = live_in[block_index.at(succ)];
+                for (int v = 0; v < values; v++)
+                {
+                    out[v] = out[v] || succ_in[v];
+                }
+            }
+
+            std::vector<bool> in(values);
+            for (int v = 0; v < values; v++)
+            {
+                in[v] = gen[i][v] || out[v] && !kill[i][v];
+            }
+
+            if (in != live_in[i] || out != live_out[i])
+            {
+                live_in[i] = std::move(in);
+                live_out[i] = std::move(out);
+                changed = true;
+            }
+        }
+    }
+
+    const auto raw = raw_pointers();
+
+    for (int i = 0; i < blocks; i++)
+    {
+        auto *b = _blocks[i];
+        const int first = _position.at(b->insts().front());
+        const int last = _position.at(b->insts().back());
+
+        for (int v = 0; v < values; v++)
+        {
+            if (live_in[i][v])
+            {
+                extend(v, first);
+            }
+            if (live_out[i][v])
+            {
+                extend(v, last + 1);
+            }
+        }
+
+        for (auto *inst : b->insts())
+        {
+            const int pos = _position.at(inst);
+
+            if (inst->def())
+            {
+                extend(_index.at(inst->def()), pos);
+            }
+
+            for (auto *use : inst->uses())
+            {
+                if (is_value(use))
+                {
+                    extend(_index.at(use), pos);
+                }
+            }
+        }
+
+        // exact liveness at the safepoints
+        auto live = live_out[i];
+        for (auto inst = b->insts().rbegin(); inst != b->insts().rend(); inst++)
+        {
+            const int def = (*inst)->def() ? _index.at((*inst)->def()) : -1;
+
+            if (is_safepoint(*inst))
+            {
+                auto &roots = _live_roots[*inst];
+                for (int v = 0; v < values; v++)
+                {
+                    const auto type = _values[v]->type();
+                    const bool is_object =
+                        type == myir::POINTER || type == myir::INTEGER || type == myir::BOOLEAN || type == myir::STRING;
+
+                    if (live[v] && v != def && is_object && !raw[v])
+                    {
+                        roots.push_back(_values[v]);
+                        _in_memory[v] = true;
+                    }
+                }
+            }
+
+            if (def != -1)
+            {
+                live[def] = false;
+            }
+
+            for (auto *use : (*inst)->uses())
+            {
+                if (is_value(use))
+                {
+                    live[_index.at(use)] = true;
+                }
+            }
+        }
+    }
+}
+
+void LinearScan::allocate_registers()
+{
+    _locations.assign(_values.size(), {Location::NONE, RAX, -1});
+
+    std::vector<int> order;
+    for (int v = 0; v < _values.size(); v++)
+    {
+        if (!_in_memory[v])
+        {
+            order.push_back(v);
+        }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) { return _start[a] < _start[b]; });
+
+    std::vector<RegX86> free(REGISTERS.rbegin(), REGISTERS.rend());
+    std::vector<int> active;
+
+    for (auto v : order)
+    {
+        // a value that dies on the instruction gives its register to the result of the instruction
+        for (auto iter = active.begin(); iter != active.end();)
+        {
+            if (_end[*iter] <= _start[v])
+            {
+                free.push_back(_locations[*iter]._reg);
+                iter = active.erase(iter);
+            }
+            else
+            {
+                iter++;
+            }
+        }
+
+        if (!free.empty())
+        {
+            _locations[v] = {Location::REGISTER, free.back(), -1};
+            free.pop_back();
+            active.push_back(v);
+
+            if (std::find(_used_regs.begin(), _used_regs.end(), _locations[v]._reg) == _used_regs.end())
+            {
+                _used_regs.push_back(_locations[v]._reg);
+            }
+            continue;
+        }
+
+        // spill the value that lives longer
+        auto spill = std::max_element(active.begin(), active.end(), [this](int a, int b) { return _end[a] < _end[b]; });
+        if (_end[*spill] > _end[v])
+        {
+            _locations[v] = _locations[*spill];
+            _locations[*spill] = {Location::NONE, RAX, -1};
+            _in_memory[*spill] = true;
+            *spill = v;
+        }
+        else
+        {
+            _in_memory[v] = true;
+        }
+    }
+}
+
+void LinearScan::allocate_slots()
+{
+    std::vector<int> order;
+    for (int v = 0; v < _values.size(); v++)
+    {
+        if (_in_memory[v])
+        {
+            order.push_back(v);
+        }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) { return _start[a] < _start[b]; });
+
+    std::vector<int> free;
+    std::vector<int> active;
+
+    for (auto v : order)
+    {
+        for (auto iter = active.begin(); iter != active.end();)
+        {
+            if (_end[*iter] <= _start[v])
+            {
+                free.push_back(_locations[*iter]._slot);
+                iter = active.erase(iter);
+            }
+            else
+            {
+                iter++;
+            }
+        }
+
+        int slot = 0;
+        if (!free.empty())
+        {
+            slot = free.back();
+            free.pop_back();
+        }
+        else
+        {
+            slot = _slots++;
+        }
+
+        _locations[v] = {Location::SLOT, RAX, slot};
+        active.push_back(v);
+    }
+}
+
+LinearScan::Location LinearScan::location(myir::Operand *value) const
+{
+    auto iter = _index.find(value);
+    if (iter == _index.end())
+    {
+        return {Location::NONE, RAX, -1};
+    }
+
+    return _locations[iter->second];
+}
+
+const std::vector<myir::Operand *> &LinearScan::live_roots(myir::Instruction *call) const
+{
+    return _live_roots.at(call);
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "AssemblerX86.hpp"
+#include "codegen/arch/myir/ir/IR.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace codegen
+{
+
+/**
+ * @brief Register allocation for a function after SSA destruction
+ *
+ * Uses the linear scan algorithm from "Linear Scan Register Allocation" by Massimiliano Poletto and Vivek Sarkar.
+ * Live ranges are approximated by one interval over the linear order of the blocks. GC can move objects, so the
+ * objects that are live across the calls that can cause GC stay in the stack slots, where the stack walker finds and
+ * updates them. Registers are callee-saved, so other values keep them across calls.
+ */
+class LinearScan
+{
+  public:
+    struct Location
+    {
+        enum Kind
+        {
+            NONE,
+            REGISTER,
+            SLOT
+        };
+
+        Kind _kind;
+        RegX86 _reg;
+        int _slot;
+    };
+
+  private:
+    static const std::vector<RegX86> REGISTERS;
+
+    const std::vector<myir::Block *> _blocks;
+    myir::Function *const _func;
+
+    // values are numbered densely
+    std::unordered_map<myir::Operand *, int> _index;
+    std::vector<myir::Operand *> _values;
+
+    std::unordered_map<myir::Instruction *, int> _position;
+
+    std::vector<int> _start;
+    std::vector<int> _end;
+    std::vector<bool> _in_memory;
+
+    std::vector<Location> _locations;
+    std::vector<RegX86> _used_regs;
+    int _slots;
+
+    // objects that are live across the calls that can cause GC
+    std::unordered_map<myir::Instruction *, std::vector<myir::Operand *>> _live_roots;
+
+    void number();
+    std::vector<bool> raw_pointers() const;
+    void build_intervals();
+    void allocate_registers();
+    void allocate_slots();
+
+    void extend(int value, int pos);
+
+  public:
+    /**
+     * @brief Check if operand needs a location
+     *
+     * @param oper Operand
+     * @return true if it is a value computed by the function
+     */
+    static bool is_value(myir::Operand *oper);
+
+    /**
+     * @brief Check if call can cause GC
+     *
+     * @param inst Instruction
+     * @return true if it is a safepoint
+     */
+    static bool is_safepoint(myir::Instruction *inst);
+
+    /**
+     * @brief Allocate registers for the function
+     *
+     * @param func Function
+     * @param blocks Blocks in the order of emission
+     */
+    LinearScan(myir::Function *func, const std::vector<myir::Block *> &blocks);
+
+    /**
+     * @brief Get location of the value
+     *
+     * @param value Value
+     * @return Register or stack slot
+     */
+    Location location(myir::Operand *value) const;
+
+    /**
+     * @brief Get objects that are live across the call
+     *
+     * @param call Call that can cause GC
+     * @return Values in the stack slots
+     */
+    const std::vector<myir::Operand *> &live_roots(myir::Instruction *call) const;
+
+    /**
+     * @brief Get number of stack slots
+     *
+     * @return Number of slots
+     */
+    inline int slots() const { return _slots; }
+
+    /**
+     * @brief Get used callee-saved registers
+     *
+     * @return Registers
+     */
+    inline const std::vector<RegX86> &used_regs() const { return _used_regs; }
+};
+
+}; // namespace codegen
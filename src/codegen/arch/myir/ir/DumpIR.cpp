@@ -130,9 +130,9 @@ std::string Variable::name() const
 std::string Phi::dump() const
 {
     std::string s = "phi " + _def->name() + " <- [";
-    for (auto &[def, block] : _def_from_block)
+    for (int i = 0; i < _uses.size(); i++)
     {
-        s += "(" + def->name() + ": " + block->name() + "), ";
+        s += "(" + _uses.at(i)->name() + ": " + _def_from_block.at(i)->name() + "), ";
     }
 
     trim(s, ", ");
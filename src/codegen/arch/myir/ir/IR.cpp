@@ -38,7 +38,7 @@ void Function::reset_max_ids()
 
 Function::Function(const std::string &name, const std::vector<Variable *> &params, OperandType return_type)
     : GlobalConstant(name, {}, POINTER), _params(params.begin(), params.end() ALLOCCOMMA), _return_type(return_type),
-      _cfg(new CFG()), _max_operand_id(0), _max_instruction_id(0), _max_block_id(0)
+      _cfg(new CFG()), _kind(), _max_operand_id(0), _max_instruction_id(0), _max_block_id(0)
 {
 }
 
@@ -141,7 +141,7 @@ void Block::disconnect()
                 if (Instruction::isa<Phi>(inst))
                 {
                     auto *phi = Instruction::as<Phi>(inst);
-                    phi->update_path(phi->oper_path(this), p);
+                    phi->update_path(this, p);
                 }
                 else
                 {
@@ -22,7 +22,9 @@ template <class T> myir::Operand *myir::IRBuilder::binary(Operand *lhs, Operand
 {
     Operand *res = nullptr;
 
-    if (Operand::isa<Constant>(lhs) && Operand::isa<Constant>(rhs))
+    // division by zero is left for the runtime
+    if (Operand::isa<Constant>(lhs) && Operand::isa<Constant>(rhs) &&
+        !(std::is_same_v<T, Div> && Operand::as<Constant>(rhs)->value() == 0))
     {
         auto lhsv = Operand::as<Constant>(lhs)->value();
         auto rhsv = Operand::as<Constant>(rhs)->value();
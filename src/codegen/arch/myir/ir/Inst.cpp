@@ -61,29 +61,32 @@ void Phi::add_path(Operand *use, Block *b)
 {
     _uses.push_back(use);
     use->used_by(this);
-    _def_from_block[use] = b;
+    _def_from_block.push_back(b);
 }
 
-void Phi::update_path(Operand *use, Block *b) { _def_from_block[use] = b; }
-
-void Phi::update_use(Operand *old_use, Operand *new_use)
+void Phi::update_path(Block *old_block, Block *new_block)
 {
-    Instruction::update_use(old_use, new_use);
+    auto iter = std::find(_def_from_block.begin(), _def_from_block.end(), old_block);
 
-    auto iter = _def_from_block.find(old_use);
-    if (iter != _def_from_block.end())
-    {
-        auto *block = iter->second;
-        _def_from_block.erase(iter);
-        _def_from_block[new_use] = block;
-    }
+    assert(iter != _def_from_block.end());
+    *iter = new_block;
 }
 
 Operand *Phi::oper_path(Block *b)
 {
-    auto iter =
-        std::find_if(_def_from_block.begin(), _def_from_block.end(), [b](const auto &kv) { return kv.second == b; });
+    auto iter = std::find(_def_from_block.begin(), _def_from_block.end(), b);
+
+    assert(iter != _def_from_block.end());
+    return _uses.at(iter - _def_from_block.begin());
+}
+
+void Phi::update_oper_path(Block *b, Operand *new_use)
+{
+    auto iter = std::find(_def_from_block.begin(), _def_from_block.end(), b);
 
     assert(iter != _def_from_block.end());
-    return iter->first;
+    auto *&use = _uses.at(iter - _def_from_block.begin());
+    use->erase_use(this);
+    use = new_use;
+    new_use->used_by(this);
 }
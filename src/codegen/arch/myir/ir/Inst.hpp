@@ -54,15 +54,17 @@ class Instruction : public IRObject
 class Phi : public Instruction
 {
   private:
-    irunordered_map<Operand *, Block *> _def_from_block;
+    // the same operand can come from several blocks, so keep a block for every use
+    irvector<Block *> _def_from_block;
 
   public:
     Phi(Operand *result) : Instruction(result, {}), _def_from_block(ALLOC) {}
 
     void add_path(Operand *use, Block *b);
-    void update_path(Operand *use, Block *b);
-    void update_use(Operand *old_use, Operand *new_use) override;
+    void update_path(Block *old_block, Block *new_block);
     Operand *oper_path(Block *b);
+    void update_oper_path(Block *b, Operand *new_use);
+    inline Block *path(int i) const { return _def_from_block.at(i); }
 
     std::string dump() const override;
 };
@@ -97,6 +99,8 @@ class Branch : public Instruction
   public:
     Branch(Block *dest) : Instruction({}, {}), _dest(dest) {}
 
+    inline Block *dest() const { return _dest; }
+
     std::string dump() const override;
 };
 
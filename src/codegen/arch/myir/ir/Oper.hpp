@@ -158,6 +158,8 @@ class StructuredOperand : public Operand
     Operand *field(int offset) const;
     Operand *word(int offset) const;
 
+    inline const irvector<Operand *> &fields() const { return _fields; }
+
     // debugging
     std::string name() const override { return (std::string)_name; }
     std::string dump() const override;
@@ -195,10 +197,11 @@ class Function final : public GlobalConstant
     CFG *_cfg;
 
     // kind of method
-    union Kind {
-        int _is_leaf : 1;
-        int _is_init : 1;
-        int _is_runtime : 1;
+    struct Kind
+    {
+        bool _is_leaf : 1;
+        bool _is_init : 1;
+        bool _is_runtime : 1;
     } _kind;
 
     // IDs
@@ -0,0 +1,38 @@
+#include "SSADestruction.hpp"
+#include "codegen/arch/myir/ir/IR.inline.hpp"
+#include "codegen/arch/myir/ir/cfg/CFG.hpp"
+
+using namespace myir;
+
+void SSADestruction::run(Function *func)
+{
+    for (auto *b : _cfg->traversal<CFG::REVERSE_POSTORDER>())
+    {
+        std::vector<Phi *> phis;
+        for (auto *inst : b->insts())
+        {
+            if (!Instruction::isa<Phi>(inst))
+            {
+                break;
+            }
+            phis.push_back(Instruction::as<Phi>(inst));
+        }
+
+        for (auto *phi : phis)
+        {
+            auto *temp = new Operand(phi->def()->type());
+
+            for (int i = 0; i < phi->uses().size(); i++)
+            {
+                auto *pred = phi->path(i);
+                assert(Instruction::isa<Branch>(pred->insts().back()) ||
+                       Instruction::isa<CondBranch>(pred->insts().back()));
+
+                pred->append_before(pred->insts().back(), new Move(temp, phi->use(i)));
+            }
+
+            // phis are at the start of the block, so copies keep their order
+            b->append_instead(phi, new Move(phi->def(), temp));
+        }
+    }
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "codegen/arch/myir/ir/pass/PassManager.hpp"
+
+namespace myir
+{
+
+// Pass replaces phi-functions with moves, so a machine code can be emitted from the CFG.
+// Every phi gets its own temporary that is assigned at the end of the predecessors and copied to the phi result at
+// the start of the block. It avoids both the lost copy and the swap problems without splitting critical edges: the
+// temporary is read only in the block of the phi.
+class SSADestruction : public Pass
+{
+  public:
+    void run(Function *func) override;
+};
+
+} // namespace myir
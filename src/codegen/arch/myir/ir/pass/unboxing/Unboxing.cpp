@@ -2,6 +2,7 @@
 #include "codegen/arch/myir/ir/IR.inline.hpp"
 #include "codegen/arch/myir/ir/cfg/CFG.hpp"
 #include "codegen/arch/myir/runtime/RuntimeMyIR.hpp"
+#include "codegen/emitter/data/Data.inline.h"
 
 using namespace myir;
 
@@ -27,13 +28,21 @@ std::shared_ptr<codegen::Klass> Unboxing::operand_to_klass(OperandType type) con
 
 bool Unboxing::need_unboxing(Operand *value) const
 {
-    // We don't need unboxing if value was used by calls only (aka call argument)
+    // We don't need unboxing if value was used by calls only (aka call argument) or is returned or stored as is,
+    // because otherwise it will be boxed again
     for (auto *use : value->uses())
     {
-        if (!Instruction::isa<Call>(use))
+        if (Instruction::isa<Call>(use) || Instruction::isa<Ret>(use))
         {
-            return true;
+            continue;
         }
+
+        if (Instruction::isa<Store>(use) && use->use(0) != value && use->use(2) == value)
+        {
+            continue;
+        }
+
+        return true;
     }
 
     return false;
@@ -42,7 +51,7 @@ bool Unboxing::need_unboxing(Operand *value) const
 Operand *Unboxing::allocate_primitive(Instruction *before, Operand *value,
                                       const std::shared_ptr<ast::Type> &klass_type) const
 {
-    auto &klass = _builder->klass(klass_type->_string);
+    auto &klass = _builder->klass(klass_type);
 
     auto *func_alloca = _runtime.symbol_by_id(codegen::RuntimeMyIR::RuntimeMyIRSymbols::GC_ALLOC)->_func;
     auto *func_init = _module.get<myir::Function>(klass->init_method());
@@ -208,6 +217,13 @@ void Unboxing::replace_uses(std::stack<TypeLink> &s, std::vector<bool> &processe
         auto *inst = link._inst;
         s.pop();
 
+        // call can get several arguments that were unboxed by different chains, so wrap them every time
+        if (Instruction::isa<Call>(inst) || Instruction::isa<Ret>(inst))
+        {
+            wrap_primitives(inst, link._type);
+            continue;
+        }
+
         if (processed[inst->id()])
         {
             continue;
@@ -223,14 +239,6 @@ void Unboxing::replace_uses(std::stack<TypeLink> &s, std::vector<bool> &processe
         {
             replace_store(Instruction::as<Store>(inst), link._type, s);
         }
-        else if (Instruction::isa<Call>(inst))
-        {
-            wrap_primitives(inst, link._type);
-        }
-        else if (Instruction::isa<Ret>(inst))
-        {
-            wrap_primitives(inst, link._type);
-        }
         else
         {
             if (!inst->def())
@@ -238,6 +246,18 @@ void Unboxing::replace_uses(std::stack<TypeLink> &s, std::vector<bool> &processe
                 continue;
             }
 
+            // primitive is moved to the variable of the Object type, so it is an object again
+            if (Instruction::isa<Move>(inst) && inst->def()->type() == POINTER)
+            {
+                wrap_primitives(inst, link._type);
+                continue;
+            }
+
+            if (Instruction::isa<Phi>(inst))
+            {
+                unbox_phi(Instruction::as<Phi>(inst));
+            }
+
             // TODO: INT64 for now. FIXME!
             inst->def()->set_type(INT64);
 
@@ -313,6 +333,24 @@ void Unboxing::wrap_primitives(Instruction *inst, OperandType type) const
     }
 }
 
+void Unboxing::unbox_phi(Phi *phi) const
+{
+    // phi can merge the unboxed value with the object from another path. Load value at the end of that path
+    for (int i = 0; i < phi->uses().size(); i++)
+    {
+        auto *value = phi->use(i);
+        if (value->type() != INTEGER && value->type() != BOOLEAN || Operand::isa<Constant>(value))
+        {
+            continue;
+        }
+
+        auto *pred = phi->path(i);
+        auto *load = load_primitive(value);
+        pred->append_before(pred->insts().back(), load);
+        phi->update_oper_path(pred, load->def());
+    }
+}
+
 void Unboxing::replace_store(Store *store, OperandType type, std::stack<TypeLink> &s) const
 {
     // store to/of Integer/Boolean object
@@ -34,6 +34,7 @@ class Unboxing : public Pass
     void replace_load(Load *load, OperandType type, std::stack<TypeLink> &s) const;
     void replace_store(Store *store, OperandType type, std::stack<TypeLink> &s) const;
     void wrap_primitives(Instruction *inst, OperandType type) const;
+    void unbox_phi(Phi *phi) const;
 
     // this function mostly copies logic of the CodeGenMyIR::emit_allocate_primitive,
     // but inserts a new code after specific instruction
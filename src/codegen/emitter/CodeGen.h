@@ -2,6 +2,7 @@
 
 #include "codegen/klass/Klass.h"
 #include "codegen/symtab/SymbolTable.h"
+#include <unordered_set>
 
 namespace codegen
 {
@@ -35,6 +36,10 @@ template <class Value, class Symbol> class CodeGen
     void emit_class_init_method();
     virtual void emit_class_init_method_inner() = 0;
 
+    // dispatches in tail position of the current method: their result is the result of the method
+    std::unordered_set<const ast::DispatchExpression *> _tail_calls;
+    void find_tail_calls(const std::shared_ptr<ast::Expression> &expr);
+
     // emit expressions
     Value emit_expr(const std::shared_ptr<ast::Expression> &expr);
 
@@ -66,6 +71,9 @@ template <class Value, class Symbol> class CodeGen
 
     Value emit_list_expr(const ast::ListExpression &expr, const std::shared_ptr<ast::Type> &expr_type);
 
+    // emit expression which result is not used
+    virtual void emit_unused_expr(const std::shared_ptr<ast::Expression> &expr);
+
     Value emit_loop_expr(const ast::WhileExpression &expr, const std::shared_ptr<ast::Type> &expr_type);
     virtual Value emit_loop_expr_inner(const ast::WhileExpression &expr,
                                        const std::shared_ptr<ast::Type> &expr_type) = 0;
@@ -117,6 +117,26 @@ void CodeGen<Value, Symbol>::emit_class_method(const std::shared_ptr<ast::Featur
     CODEGEN_VERBOSE_ONLY(LOG_EXIT("GEN METHOD \"" + method->_object->_object + "\""));
 }
 
+template <class Value, class Symbol>
+void CodeGen<Value, Symbol>::find_tail_calls(const std::shared_ptr<ast::Expression> &expr)
+{
+    std::visit(ast::overloaded{[&](const ast::DispatchExpression &disp) { _tail_calls.insert(&disp); },
+                               [&](const ast::IfExpression &if_expr) {
+                                   find_tail_calls(if_expr._true_path_expr);
+                                   find_tail_calls(if_expr._false_path_expr);
+                               },
+                               [&](const ast::CaseExpression &case_expr) {
+                                   for (const auto &branch : case_expr._cases)
+                                   {
+                                       find_tail_calls(branch->_expr);
+                                   }
+                               },
+                               [&](const ast::LetExpression &let) { find_tail_calls(let._body_expr); },
+                               [&](const ast::ListExpression &list) { find_tail_calls(list._exprs.back()); },
+                               [&](const auto &) {}},
+               expr->_data);
+}
+
 template <class Value, class Symbol>
 Value CodeGen<Value, Symbol>::emit_object_expr(const ast::ObjectExpression &expr,
                                                const std::shared_ptr<ast::Type> &expr_type)
@@ -166,12 +186,13 @@ Value CodeGen<Value, Symbol>::emit_list_expr(const ast::ListExpression &expr,
     }
     else
     {
-        Value res;
-        for (const auto &e : expr._exprs)
+        for (auto e = expr._exprs.begin(); e != expr._exprs.end() - 1; e++)
         {
-            res = emit_expr(e);
+            emit_unused_expr(*e);
         }
 
+        Value res = emit_expr(expr._exprs.back());
+
         CODEGEN_VERBOSE_ONLY(LOG_EXIT("GEN LIST EXPR"));
         return res;
     }
@@ -179,6 +200,12 @@ Value CodeGen<Value, Symbol>::emit_list_expr(const ast::ListExpression &expr,
     CODEGEN_VERBOSE_ONLY(LOG_EXIT("GEN LIST EXPR"));
 }
 
+template <class Value, class Symbol>
+void CodeGen<Value, Symbol>::emit_unused_expr(const std::shared_ptr<ast::Expression> &expr)
+{
+    emit_expr(expr);
+}
+
 template <class Value, class Symbol>
 Value CodeGen<Value, Symbol>::emit_loop_expr(const ast::WhileExpression &expr,
                                              const std::shared_ptr<ast::Type> &expr_type)
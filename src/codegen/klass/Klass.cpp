@@ -1,14 +1,16 @@
 #include "Klass.h"
 #include "utils/logger/Logger.h"
 #include <algorithm>
+#include <iterator>
 
 using namespace codegen;
 
 Klass::Klass(const std::shared_ptr<ast::Class> &klass, const KlassBuilder *builder)
-    : _klass(klass->_type), _parent_klass(builder->_klasses.at(klass->_parent->_string)), _is_leaf(false)
+    : _klass(klass->_type), _parent_klass(builder->klass(klass->_parent)), _is_leaf(false)
 {
     _fields.insert(_fields.end(), _parent_klass->fields_begin(), _parent_klass->fields_end());
     _methods.insert(_methods.end(), _parent_klass->methods_begin(), _parent_klass->methods_end());
+    _method_indices = _parent_klass->_method_indices;
 
     divide_features(klass->_features);
 
@@ -28,20 +30,20 @@ void Klass::divide_features(const std::vector<std::shared_ptr<ast::Feature>> &fe
 
         if (std::holds_alternative<ast::MethodFeature>(feature->_base))
         {
-            auto table_entry = std::find_if(_methods.begin(), _methods.end(), [&name](const auto &entry) {
-                return entry.second->_object->_object == name;
-            });
+            const auto index = _method_indices.find(feature->_object->_symbol);
 
-            if (table_entry == _methods.end())
+            if (index == _method_indices.end())
             {
                 CODEGEN_VERBOSE_ONLY(LOG("Adds method \"" + name + "\""););
+                _method_indices.insert({feature->_object->_symbol, _methods.size()});
                 _methods.push_back(std::make_pair(_klass, feature));
             }
             else
             {
                 CODEGEN_VERBOSE_ONLY(LOG("Overload method \"" + name + "\""););
-                table_entry->first = _klass;
-                table_entry->second = feature;
+                auto &table_entry = _methods[index->second];
+                table_entry.first = _klass;
+                table_entry.second = feature;
             }
         }
         else
@@ -97,7 +99,7 @@ int KlassBuilder::build_klass(const std::shared_ptr<semant::ClassNode> &node, co
 
     CODEGEN_VERBOSE_ONLY(LOG_ENTER("BUILD KLASS FOR \"" + klass->_type->_string + "\""));
 
-    _klasses.insert({klass->_type->_string, make_klass(klass)});
+    _klasses[klass->_type->_symbol] = make_klass(klass);
 
     auto child_max_tag = tag;
     for (const auto &node : node->_children)
@@ -105,8 +107,8 @@ int KlassBuilder::build_klass(const std::shared_ptr<semant::ClassNode> &node, co
         child_max_tag = build_klass(node, child_max_tag + 1);
     }
 
-    _klasses[klass->_type->_string]->set_tags(tag, child_max_tag);
-    _klasses[klass->_type->_string]->_is_leaf = node->_children.size() == 0;
+    _klasses[klass->_type->_symbol]->set_tags(tag, child_max_tag);
+    _klasses[klass->_type->_symbol]->_is_leaf = node->_children.size() == 0;
 
     CODEGEN_VERBOSE_ONLY(LOG("Set tags: (" + std::to_string(tag) + ", " + std::to_string(child_max_tag) + ")"););
 
@@ -114,13 +116,6 @@ int KlassBuilder::build_klass(const std::shared_ptr<semant::ClassNode> &node, co
     return child_max_tag;
 }
 
-size_t Klass::method_index(const std::string &method_name) const
-{
-    return std::find_if(_methods.begin(), _methods.end(),
-                        [&method_name](const auto &method) { return method.second->_object->_object == method_name; }) -
-           _methods.begin();
-}
-
 KlassBuilder::KlassBuilder(const std::shared_ptr<semant::ClassNode> &root) : _root(root) {}
 
 void KlassBuilder::init()
@@ -128,20 +123,55 @@ void KlassBuilder::init()
     CODEGEN_VERBOSE_ONLY(LOG_ENTER("KlassBuilder."));
 
     _klasses.clear();
+    _klasses.resize(ast::SymbolTable::size());
 
     // parent of the Object class. Need for algorithms
-    _klasses.insert({semant::Semant::empty_type()->_string, make_klass(nullptr)});
+    _klasses[semant::Semant::empty_type()->_symbol] = make_klass(nullptr);
 
     build_klass(_root, 1); // convention with GC: tag 0 is reserved
 
     // delete parent of the Object class
-    _klasses.erase(semant::Semant::empty_type()->_string);
+    _klasses[semant::Semant::empty_type()->_symbol] = nullptr;
 
-    // transform to vector and sort by tag
-    _klasses_by_tag.resize(_klasses.size());
-    transform(_klasses.begin(), _klasses.end(), _klasses_by_tag.begin(), [](const auto &pair) { return pair.second; });
+    // collect to vector and sort by tag
+    _klasses_by_tag.clear();
+    copy_if(_klasses.begin(), _klasses.end(), back_inserter(_klasses_by_tag),
+            [](const auto &klass) { return klass != nullptr; });
     sort(_klasses_by_tag.begin(), _klasses_by_tag.end(),
          [](const auto &l, const auto &r) { return l->tag() < r->tag(); });
 
     CODEGEN_VERBOSE_ONLY(LOG_EXIT("KlassBuilder."));
 }
+
+std::vector<DispatchTarget> KlassBuilder::dispatch_targets(const std::shared_ptr<Klass> &klass,
+                                                           const int &method) const
+{
+    std::vector<DispatchTarget> targets;
+
+    // tags are assigned in DFS order, so all subclasses of klass have tags in [tag, child_max_tag]
+    for (auto tag = klass->tag(); tag <= klass->child_max_tag(); tag++)
+    {
+        const auto &subclass = _klasses_by_tag[tag - 1];
+        GUARANTEE_DEBUG(subclass->tag() == tag);
+
+        const auto &owner = (subclass->methods_begin() + subclass->method_index(method))->first;
+
+        auto target = std::find_if(targets.begin(), targets.end(), [&owner](const auto &target) {
+            return target._klass->klass()->_symbol == owner->_symbol;
+        });
+        if (target == targets.end())
+        {
+            targets.push_back({_klasses[owner->_symbol], {{tag, tag}}});
+        }
+        else if (target->_tags.back().second == tag - 1)
+        {
+            target->_tags.back().second = tag;
+        }
+        else
+        {
+            target->_tags.push_back({tag, tag});
+        }
+    }
+
+    return targets;
+}
@@ -7,6 +7,20 @@ namespace codegen
 {
 
 class KlassBuilder;
+class Klass;
+
+/**
+ * @brief DispatchTarget is an implementation of the method that can be called for the receiver of the static type
+ *
+ */
+struct DispatchTarget
+{
+    // Klass that defines this implementation
+    std::shared_ptr<Klass> _klass;
+
+    // ranges of tags [first, last] that dispatch to this implementation
+    std::vector<std::pair<int, int>> _tags;
+};
 
 /**
  * @brief Klass represents Cool class
@@ -30,6 +44,8 @@ class Klass
     // All fields and methods of this class
     std::vector<std::shared_ptr<ast::Feature>> _fields;
     std::vector<std::pair<std::shared_ptr<ast::Type>, std::shared_ptr<ast::Feature>>> _methods;
+    // index of the method in _methods by the symbol of its name
+    std::unordered_map<int, size_t> _method_indices;
 
     void divide_features(const std::vector<std::shared_ptr<ast::Feature>> &features);
 
@@ -142,10 +158,14 @@ class Klass
     /**
      * @brief Get index in dispatch table for the given method
      *
-     * @param method_name Name of the method
+     * @param method Symbol of the method name
      * @return Index
      */
-    size_t method_index(const std::string &method_name) const;
+    inline size_t method_index(const int &method) const
+    {
+        GUARANTEE_DEBUG(_method_indices.find(method) != _method_indices.end());
+        return _method_indices.at(method);
+    }
 
     /**
      * @brief Construct full name of the method for this Class
@@ -210,8 +230,8 @@ class KlassBuilder
     // Classes from semant
     const std::shared_ptr<semant::ClassNode> _root;
 
-    // Map of classes for inheritance
-    std::unordered_map<std::string, std::shared_ptr<Klass>> _klasses;
+    // Klasses indexed by the symbol of the class name
+    std::vector<std::shared_ptr<Klass>> _klasses;
 
     // Klasses sorted by tag
     std::vector<std::shared_ptr<Klass>> _klasses_by_tag;
@@ -241,36 +261,57 @@ class KlassBuilder
      */
     void init();
 
+    /**
+     * @brief Class tag
+     *
+     * @param type Class type
+     * @return Class tag
+     */
+    inline int tag(const std::shared_ptr<ast::Type> &type) const { return klass(type)->tag(); }
+
     /**
      * @brief Class tag
      *
      * @param class_name Class name
      * @return Class tag
      */
-    inline int tag(const std::string &class_name) const
-    {
-        GUARANTEE_DEBUG(_klasses.find(class_name) != _klasses.end());
-        return _klasses.at(class_name)->tag();
-    }
+    inline int tag(const std::string &class_name) const { return klass(class_name)->tag(); }
 
     /**
      * @brief Iterator to the first Klass
      *
      * @return Iterator to the first Klass
      */
-    inline std::unordered_map<std::string, std::shared_ptr<Klass>>::const_iterator begin() const
-    {
-        return _klasses.begin();
-    }
+    inline std::vector<std::shared_ptr<Klass>>::const_iterator begin() const { return _klasses_by_tag.begin(); }
 
     /**
      * @brief Iterator to the behind of the last Klass
      *
      * @return Iterator to the behind of the last Klass
      */
-    inline std::unordered_map<std::string, std::shared_ptr<Klass>>::const_iterator end() const
+    inline std::vector<std::shared_ptr<Klass>>::const_iterator end() const { return _klasses_by_tag.end(); }
+
+    /**
+     * @brief Klass that represents Cool Class
+     *
+     * @param symbol Symbol of the class name
+     * @return Klass instance
+     */
+    inline const std::shared_ptr<Klass> &klass(const int &symbol) const
     {
-        return _klasses.end();
+        GUARANTEE_DEBUG(symbol >= 0 && symbol < _klasses.size() && _klasses[symbol]);
+        return _klasses[symbol];
+    }
+
+    /**
+     * @brief Klass that represents Cool Class
+     *
+     * @param type Class type
+     * @return Klass instance
+     */
+    inline const std::shared_ptr<Klass> &klass(const std::shared_ptr<ast::Type> &type) const
+    {
+        return klass(type->_symbol);
     }
 
     /**
@@ -281,8 +322,7 @@ class KlassBuilder
      */
     inline const std::shared_ptr<Klass> &klass(const std::string &class_name) const
     {
-        GUARANTEE_DEBUG(_klasses.find(class_name) != _klasses.end());
-        return _klasses.at(class_name);
+        return klass(ast::SymbolTable::find(class_name));
     }
 
     /**
@@ -298,6 +338,16 @@ class KlassBuilder
      * @return Root of the Class hierarchy
      */
     inline const std::shared_ptr<semant::ClassNode> &root() const { return _root; }
+
+    /**
+     * @brief Class Hierarchy Analysis: find all implementations of the method that can be called for the receiver of
+     * the given static type
+     *
+     * @param klass Static type of the receiver
+     * @param method Symbol of the method name
+     * @return Implementations ordered by the first tag that dispatches to them
+     */
+    std::vector<DispatchTarget> dispatch_targets(const std::shared_ptr<Klass> &klass, const int &method) const;
 };
 
 }; // namespace codegen
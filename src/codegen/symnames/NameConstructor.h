@@ -26,6 +26,8 @@ class Names
         CONST_INT,
         CONST_STRING,
 
+        UNBOXED,
+
         CommentsNumber
     };
 
@@ -1,7 +1,10 @@
 #include "coolc.h"
 #include "parser/Parser.h"
+#include "utils/timer/PhaseTimer.h"
+#include <atomic>
 #include <iostream>
 #include <numeric>
+#include <thread>
 
 /**
  * @brief Parse
@@ -25,8 +28,9 @@ std::shared_ptr<semant::ClassNode> do_semant(const std::vector<std::shared_ptr<a
  *
  * @param program One AST for all files
  * @param out_file Result file
+ * @return Code generator
  */
-void do_codegen(const std::shared_ptr<semant::ClassNode> &program, const std::string &out_file);
+std::unique_ptr<CODEGEN> do_codegen(const std::shared_ptr<semant::ClassNode> &program, const std::string &out_file);
 
 int main(int argc, char *argv[])
 {
@@ -35,18 +39,26 @@ int main(int argc, char *argv[])
     const auto parsed_program = do_parse(files.first, argv);
     const auto analysed_program = do_semant(parsed_program);
 
-    do_codegen(analysed_program, files.second);
+    const auto codegen = do_codegen(analysed_program, files.second);
+
+    PhaseTimer::print();
+
+#ifdef LLVM
+    // compiler phases are reported before the program output
+    if (RunInJit)
+    {
+        return codegen->run(ProgramArgs);
+    }
+#endif // LLVM
 
     return 0;
 }
 
 std::vector<std::shared_ptr<ast::Program>> do_parse(const std::vector<int> &files, char *argv[])
 {
-    std::vector<std::shared_ptr<ast::Program>> programs;
-
-    for (const auto &i : files)
-    {
-        DEBUG_ONLY(if (TokensOnly) {
+    DEBUG_ONLY(if (TokensOnly) {
+        for (const auto &i : files)
+        {
             lexer::Lexer l(argv[i]);
             std::cout << "#name \"" << l.file_name() << "\"" << std::endl;
 
@@ -55,29 +67,79 @@ std::vector<std::shared_ptr<ast::Program>> do_parse(const std::vector<int> &file
             {
                 token = l.next();
             }
+        }
+
+        exit(0);
+    });
+
+    PhaseTimer timer("parse");
+
+    struct ParseResult
+    {
+        std::shared_ptr<ast::Program> _program;
+        std::string _error;
+        std::exception_ptr _exception;
+    };
+
+    // files are independent, so parse them in parallel
+    std::vector<ParseResult> results(files.size());
+    std::atomic<size_t> next_file = 0;
+
+    const auto parse_files = [&]() {
+        for (auto i = next_file++; i < files.size(); i = next_file++)
+        {
+            try
+            {
+                parser::Parser parser(std::make_shared<lexer::Lexer>(argv[files[i]]));
+                results[i]._program = parser.parse_program();
+                results[i]._error = parser.error_msg();
+            }
+            catch (...)
+            {
+                results[i]._exception = std::current_exception();
+            }
+        }
+    };
+
+    auto threads_num = std::min<size_t>(files.size(), std::max(std::thread::hardware_concurrency(), 1U));
+    DEBUG_ONLY(if (TraceLexer || TraceParser) { threads_num = 1; });
 
-            continue;
-        });
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threads_num; i++)
+    {
+        threads.emplace_back(parse_files);
+    }
+    parse_files();
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
 
-        parser::Parser parser(std::make_shared<lexer::Lexer>(argv[i]));
-        if (const auto ast = parser.parse_program())
+    // report errors in order of files
+    std::vector<std::shared_ptr<ast::Program>> programs;
+    for (auto &result : results)
+    {
+        if (result._exception)
         {
-            programs.push_back(ast);
+            std::rethrow_exception(result._exception);
         }
-        else
+
+        if (!result._program)
         {
-            std::cout << parser.error_msg() << std::endl;
+            std::cout << result._error << std::endl;
             exit(-1);
         }
-    }
 
-    DEBUG_ONLY(if (TokensOnly) { exit(0); });
+        programs.push_back(std::move(result._program));
+    }
 
     return programs;
 }
 
 std::shared_ptr<semant::ClassNode> do_semant(const std::vector<std::shared_ptr<ast::Program>> &programs)
 {
+    PhaseTimer timer("semant");
+
     semant::Semant semant(std::move(programs));
     const auto result = semant.infer_types_and_check();
 
@@ -92,8 +154,12 @@ std::shared_ptr<semant::ClassNode> do_semant(const std::vector<std::shared_ptr<a
     return result.first;
 }
 
-void do_codegen(const std::shared_ptr<semant::ClassNode> &program, const std::string &out_file)
+std::unique_ptr<CODEGEN> do_codegen(const std::shared_ptr<semant::ClassNode> &program, const std::string &out_file)
 {
-    CODEGEN codegen(program);
-    codegen.emit(out_file);
+    PhaseTimer timer("codegen");
+
+    auto codegen = std::make_unique<CODEGEN>(program);
+    codegen->emit(out_file);
+
+    return codegen;
 }
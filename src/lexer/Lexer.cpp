@@ -1,404 +1,447 @@
 #include "lexer/Lexer.h"
 #include "utils/Utils.h"
 #include "utils/logger/Logger.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace lexer;
 
-const std::regex Lexer::LEXER_SPEC_REGEX(
-    std::string(
-        // keywords
-        "[cC][lL][aA][sS][sS]|[eE][lL][sS][eE]|[fF][iI]|[iI][fF]"
-        "|[iI][nN]|[iI][nN][hH][eE][rR][iI][tT][sS]|[lL][eE][tT]|"
-        "[lL][oO][oO][pP]|[pP][oO][oO][lL]|[tT][hH][eE][nN]|[wW]"
-        "[hH][iI][lL][eE]|[cC][aA][sS][eE]|[eE][sS][aA][cC]|[oO][fF]|"
-        "[nN][oO][tT]|[nN][eE][wW]|[iI][sS][vV][oO][iI][dD]|"
-        "=>|<=|<-|"
-        // types and objects
-        "[0-9]+|t[rR][uU][eE]|f[aA][lL][sS][eE]|[A-Z][a-zA-Z0-9_]*|[a-z][a-zA-Z0-9_]*|"
-        // control symbols
-        ";|\\{|}|:|\\(|\\)|\\."
-        "@|~|\\*|/|\\+|-|<|=|,|"
-        "\\*\\)|"
-        // whitespaces
-        "[\f\r\t\v ]+|"
-        // error
-        "." // . does not accept \x00
-        "|\x00"),
-    std::regex::extended);
-
-const std::regex Lexer::STR_SYMBOLS_REGEX("\\\"|\\\\|\\x00");
-const std::regex Lexer::COMM_SYMBOLS_REGEX("\\(\\*|\\*\\)");
-
-Lexer::Lexer(const std::string &input_file_name) : _file_name(input_file_name)
+const std::array<Lexer::CharClass, 256> Lexer::CHAR_CLASS = []() {
+    std::array<CharClass, 256> classes;
+    classes.fill(OTHER);
+
+    for (const auto ch : {'\f', '\r', '\t', '\v', ' '})
+    {
+        classes[ch] = WHITESPACE;
+    }
+    classes['\n'] = NEW_LINE;
+
+    for (auto ch = '0'; ch <= '9'; ch++)
+    {
+        classes[ch] = DIGIT;
+    }
+    for (auto ch = 'A'; ch <= 'Z'; ch++)
+    {
+        classes[ch] = UPPER;
+    }
+    for (auto ch = 'a'; ch <= 'z'; ch++)
+    {
+        classes[ch] = LOWER;
+    }
+    classes['_'] = UNDERSCORE;
+
+    return classes;
+}();
+
+const std::array<std::pair<std::string_view, Token::TokenType>, 17> Lexer::KEYWORDS = {
+    {{"class", Token::CLASS}, {"else", Token::ELSE}, {"fi", Token::FI}, {"if", Token::IF}, {"in", Token::IN},
+     {"inherits", Token::INHERITS}, {"let", Token::LET}, {"loop", Token::LOOP}, {"pool", Token::POOL},
+     {"then", Token::THEN}, {"while", Token::WHILE}, {"case", Token::CASE}, {"esac", Token::ESAC}, {"of", Token::OF},
+     {"not", Token::NOT}, {"new", Token::NEW}, {"isvoid", Token::ISVOID}}};
+
+// keywords are case insensitive
+static bool equals_in_lowercase(const std::string_view &str, const std::string_view &lowercase)
+{
+    return str.length() == lowercase.length() &&
+           std::equal(str.begin(), str.end(), lowercase.begin(), [](const char &ch, const char &lower) {
+               return std::tolower(static_cast<unsigned char>(ch)) == lower;
+           });
+}
+
+Lexer::Lexer(const std::string &input_file_name)
+    : _file_name(input_file_name), _line_number(1), _eof(false), _buffer(nullptr), _size(0), _pos(0)
 {
-    _line_number = 0;
+    const auto fd = open(input_file_name.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        throw std::runtime_error("Lexer::Lexer: can't open file " + input_file_name + "!");
+    }
 
-    _input_file.open(input_file_name);
-    if (!_input_file.is_open())
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == -1 || !S_ISREG(file_stat.st_mode))
     {
+        close(fd);
         throw std::runtime_error("Lexer::Lexer: can't open file " + input_file_name + "!");
     }
+
+    _size = file_stat.st_size;
+    if (_size != 0)
+    {
+        auto *const addr = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED)
+        {
+            close(fd);
+            throw std::runtime_error("Lexer::Lexer: can't map file " + input_file_name + "!");
+        }
+        _buffer = static_cast<const char *>(addr);
+    }
+
+    close(fd);
+}
+
+Lexer::~Lexer()
+{
+    if (_buffer)
+    {
+        munmap(const_cast<char *>(_buffer), _size);
+    }
 }
 
-// append a suffix to prefix if can
+// append a character to string if can
 // set new error message
-void Lexer::append_to_string_if_can(std::string &prefix, const std::string &suffix, std::string &error_msg,
-                                    int &error_line_num)
+void Lexer::append_to_string_if_can(std::string &str, const char &ch, std::string_view &error_msg, int &error_line_num)
 {
     if (!error_msg.empty())
     {
         return;
     }
-    if (prefix.length() + suffix.length() > MAX_STR_CONST - 1)
+    if (str.length() + 1 > MAX_STR_CONST - 1)
     {
         error_msg = "String constant too long";
         error_line_num = _line_number;
     }
     else
     {
-        prefix += suffix;
+        str += ch;
     }
 }
 
-Token Lexer::match_string(const std::string &start_string)
+Token Lexer::match_identifier(const size_t &start)
 {
+    while (_pos < _size && is_id_char(_buffer[_pos]))
+    {
+        _pos++;
+    }
 
-    auto escape = false;
-    std::string error_msg;
-    int error_line_num;
+    const auto lexeme = std::string_view(_buffer + start, _pos - start);
+    for (const auto &[keyword, type] : KEYWORDS)
+    {
+        if (equals_in_lowercase(lexeme, keyword))
+        {
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("keyword", lexeme, start)));
+            return Token(type, lexeme, _line_number);
+        }
+    }
 
-    auto processed_string = start_string;
-    std::string builded_string;
+    // the first letter of the boolean constants must be in lowercase
+    if (lexeme[0] == 't' && equals_in_lowercase(lexeme, "true"))
+    {
+        LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("boolean", lexeme, start)));
+        return Token(Token::BOOL_CONST, "true", _line_number);
+    }
+    if (lexeme[0] == 'f' && equals_in_lowercase(lexeme, "false"))
+    {
+        LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("boolean", lexeme, start)));
+        return Token(Token::BOOL_CONST, "false", _line_number);
+    }
 
-    while (true)
+    if (char_class(lexeme[0]) == UPPER)
     {
-        // we read all lines from the file
-        if (_input_file.eof() && processed_string.empty())
-        {
-            if (error_msg.empty())
-            {
-                error_msg = "EOF in string constant";
-                error_line_num = _line_number;
-            }
+        LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("typeid", lexeme, start)));
+        return Token(Token::TYPEID, lexeme, _line_number, symbol(lexeme));
+    }
 
-            _current_line.clear();
-            return Token(Token::ERROR, error_msg, error_line_num);
-        }
-        if (processed_string.empty())
-        {
-            std::getline(_input_file, processed_string);
-            _line_number++;
+    LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("object", lexeme, start)));
+    return Token(Token::OBJECTID, lexeme, _line_number, symbol(lexeme));
+}
 
-            LEXER_VERBOSE_ONLY(LOG("New line: \"" + processed_string + "\""));
-            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("new line symbol", "", 0)));
+int Lexer::symbol(const std::string_view &lexeme)
+{
+    const auto symbol = _symbols.find(lexeme);
+    if (symbol != _symbols.end())
+    {
+        return symbol->second;
+    }
 
-            // we read a new line, so check if '\n' is escaped
-            if (!escape)
-            {
-                // save a rest of the line
-                _current_line = processed_string;
-                return Token(Token::ERROR, error_msg.empty() ? "Unterminated string constant" : error_msg,
-                             error_msg.empty() ? _line_number : error_line_num);
-            }
+    return _symbols[lexeme] = ast::SymbolTable::intern(lexeme);
+}
 
-            append_to_string_if_can(builded_string, "\n", error_msg, error_line_num);
-            escape = 0;
-        }
+Token Lexer::match_number(const size_t &start)
+{
+    while (_pos < _size && char_class(_buffer[_pos]) == DIGIT)
+    {
+        _pos++;
+    }
+
+    LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("number", std::string_view(_buffer + start, _pos - start), start)));
+    return make_token(Token::INT_CONST, start);
+}
+
+Token Lexer::match_string()
+{
+    const auto start = _pos;
+
+    // fast path: string without escape sequences and special characters is a part of the file
+    auto end = start;
+    while (end < _size && _buffer[end] != '\"' && _buffer[end] != '\\' && _buffer[end] != '\n' && _buffer[end] != '\0')
+    {
+        end++;
+    }
+    if (end < _size && _buffer[end] == '\"' && end - start <= MAX_STR_CONST - 1)
+    {
+        LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("string", std::string_view(_buffer + start, end - start), start)));
 
-        // escape next character
+        _pos = end + 1;
+        return Token(Token::STR_CONST, std::string_view(_buffer + start, end - start), _line_number);
+    }
+
+    std::string builded_string;
+    std::string_view error_msg;
+    int error_line_num = 0;
+
+    auto escape = false;
+    while (_pos < _size)
+    {
+        const auto ch = _buffer[_pos++];
+
+        // escape this character
         if (escape)
         {
-            // we analyze the first character not in the regular expression,
-            // so catch the special case when it is \x00
-            if (processed_string[0] == '\0')
+            escape = false;
+
+            switch (ch)
             {
+            case '\n':
+                _line_number++;
+                append_to_string_if_can(builded_string, '\n', error_msg, error_line_num);
+                break;
+            case '\0':
                 if (error_msg.empty())
                 {
                     error_msg = "String contains escaped null character.";
                     error_line_num = _line_number;
                 }
-            }
-            else
-            {
-                auto ch = processed_string.substr(0, 1);
-                switch (processed_string[0])
-                {
-                case 'n':
-                    ch = "\n";
-                    break;
-                case 'b':
-                    ch = "\b";
-                    break;
-                case 't':
-                    ch = "\t";
-                    break;
-                case 'f':
-                    ch = "\f";
-                    break;
-                case '\\':
-                    ch = "\\";
-                }
-
+                break;
+            case 'n':
+                append_to_string_if_can(builded_string, '\n', error_msg, error_line_num);
+                break;
+            case 'b':
+                append_to_string_if_can(builded_string, '\b', error_msg, error_line_num);
+                break;
+            case 't':
+                append_to_string_if_can(builded_string, '\t', error_msg, error_line_num);
+                break;
+            case 'f':
+                append_to_string_if_can(builded_string, '\f', error_msg, error_line_num);
+                break;
+            default:
                 append_to_string_if_can(builded_string, ch, error_msg, error_line_num);
             }
-            escape = 0;
-            processed_string = processed_string.substr(1);
+            continue;
         }
 
-        // match escape characters and closing "
-        std::smatch matches;
-        if (std::regex_search(processed_string, matches, STR_SYMBOLS_REGEX))
+        switch (ch)
         {
-            const auto ch = processed_string[matches.position(0)];
-
-            append_to_string_if_can(builded_string, processed_string.substr(0, matches.position(0)), error_msg,
-                                    error_line_num);
-            processed_string = processed_string.substr(matches.position(0) + 1);
+        case '\"': {
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("closing \"", "", _pos - 1)));
 
-            switch (ch)
+            if (!error_msg.empty())
             {
-            case '\"': {
-                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("closing \"", "", matches.position(0))));
-
-                _current_line = processed_string;
-                return Token(error_msg.empty() ? Token::STR_CONST : Token::ERROR,
-                             error_msg.empty() ? builded_string : error_msg,
-                             error_msg.empty() ? _line_number : error_line_num);
+                return Token(Token::ERROR, error_msg, error_line_num);
             }
-            case '\\': {
-                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("closing \\", "", matches.position(0))));
+            return Token(Token::STR_CONST, _strings.emplace_back(std::move(builded_string)), _line_number);
+        }
+        case '\n': {
+            _line_number++;
+            // the rest of the string is lexed from the new line
+            return Token(Token::ERROR, error_msg.empty() ? "Unterminated string constant" : error_msg,
+                         error_msg.empty() ? _line_number : error_line_num);
+        }
+        case '\\': {
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("escape \\", "", _pos - 1)));
 
-                if (error_msg.empty())
-                {
-                    escape = true;
-                }
-                break;
-            }
-            case '\0': {
-                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("null character", "", matches.position(0))));
+            // escape sequences are not interpreted after the error
+            escape = error_msg.empty();
+            break;
+        }
+        case '\0': {
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("null character", "", _pos - 1)));
 
-                if (error_msg.empty())
-                {
-                    error_msg = "String contains null character.";
-                    error_line_num = _line_number;
-                }
-                break;
-            }
+            if (error_msg.empty())
+            {
+                error_msg = "String contains null character.";
+                error_line_num = _line_number;
             }
+            break;
         }
-        else
-        {
-            // did not catch any special characters using regular expression
-            append_to_string_if_can(builded_string, processed_string, error_msg, error_line_num);
-            processed_string.clear();
+        default:
+            append_to_string_if_can(builded_string, ch, error_msg, error_line_num);
         }
     }
+
+    // we read all the file
+    if (error_msg.empty())
+    {
+        error_msg = "EOF in string constant";
+        error_line_num = _line_number;
+    }
+    return Token(Token::ERROR, error_msg, error_line_num);
 }
 
-std::optional<Token> Lexer::skip_comment(const std::string &start_string)
+std::optional<Token> Lexer::skip_comment()
 {
-    auto processed_string = start_string;
     auto comm_level = 1;
 
-    while (true)
+    while (_pos < _size)
     {
-        if (_input_file.eof() && processed_string.empty())
+        const auto ch = _buffer[_pos++];
+        if (ch == '\n')
         {
-            _current_line.clear();
-            return Token(Token::ERROR, "EOF in comment", _line_number);
+            _line_number++;
         }
-        if (processed_string.empty())
+        else if (ch == '(' && peek() == '*')
         {
-            std::getline(_input_file, processed_string);
-            _line_number++;
-
-            LEXER_VERBOSE_ONLY(LOG("New line: \"" + processed_string + "\""));
+            _pos++;
+            comm_level++; // open a nested comment
         }
-
-        std::smatch matches;
-        if (std::regex_search(processed_string, matches, COMM_SYMBOLS_REGEX))
+        else if (ch == '*' && peek() == ')')
         {
-            for (auto i = 0; i < matches.size(); i++)
-            {
-                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("controls", matches[i], matches.position(i))));
+            _pos++;
+            comm_level--; // close a nested comment
 
-                const auto ch = processed_string[matches.position(i)];
-                if (ch == '(')
-                {
-                    comm_level++; // open a nested comment
-                }
-                else
-                {
-                    comm_level--; // close a nested comment
-                }
-                // all comments are closed
-                if (comm_level == 0)
-                {
-                    _current_line = processed_string.substr(matches.position(i) + 2);
-                    return std::nullopt;
-                }
+            // all comments are closed
+            if (comm_level == 0)
+            {
+                return std::nullopt;
             }
-            processed_string = processed_string.substr(matches.position(matches.size() - 1) + 2);
-        }
-        else
-        {
-            // skip this line
-            processed_string.clear();
         }
     }
+
+    return Token(Token::ERROR, "EOF in comment", _line_number);
 }
 
-std::optional<Token> Lexer::next()
+void Lexer::skip_line_comment()
 {
-    std::string current_line_suffix;
-    if (_saved_tokens.empty())
+    const auto *const new_line = static_cast<const char *>(memchr(_buffer + _pos, '\n', _size - _pos));
+    _pos = new_line ? new_line - _buffer : _size;
+}
+
+std::optional<Token> Lexer::match_token()
+{
+    while (_pos < _size)
     {
-        while (_saved_tokens.empty())
+        const auto start = _pos;
+        const auto ch = _buffer[_pos++];
+
+        switch (char_class(ch))
         {
-            if (_current_line.empty())
-            {
-                std::getline(_input_file, _current_line);
-                _line_number++;
+        case WHITESPACE:
+            continue;
+        case NEW_LINE:
+            _line_number++;
+            continue;
+        case DIGIT:
+            return match_number(start);
+        case UPPER:
+        case LOWER:
+            return match_identifier(start);
+        default:
+            break;
+        }
 
-                LEXER_VERBOSE_ONLY(LOG("New line: \"" + _current_line + "\""));
-            }
-            if (_input_file.eof() && _current_line.empty())
+        switch (ch)
+        {
+        case '\"':
+            LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("start of the string", "", start)));
+            return match_string();
+        case '(':
+            if (peek() == '*')
             {
-                // end of file
-                return std::nullopt;
-            }
-
-            // try to match Cool string
-            const auto string_start = _current_line.find("\"");
-            // try to match Cool comments
-            const auto par_comm_start = _current_line.find("(*");
-            const auto dash_comm_start = _current_line.find("--");
+                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("start of the comment", "", start)));
 
-            auto suffix_start = -1;
-            auto shift = -1;
-            // save string suffix for further lexing
-            if (string_start < par_comm_start && string_start < dash_comm_start)
-            {
-                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("start of the string", "", string_start)));
-                suffix_start = string_start;
-                shift = 1;
+                _pos++;
+                if (auto error = skip_comment())
+                {
+                    return error;
+                }
+                continue;
             }
-            else if (par_comm_start < string_start && par_comm_start < dash_comm_start)
+            return make_token(Token::LEFT_PAREN, start);
+        case '-':
+            if (peek() == '-')
             {
-                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("start of the comment", "", par_comm_start)));
-                suffix_start = par_comm_start;
-                shift = 2;
+                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("start of the dash comment", "", start)));
+
+                skip_line_comment();
+                continue;
             }
-            else if (dash_comm_start < string_start && dash_comm_start < par_comm_start)
+            return make_token(Token::MINUS, start);
+        case '*':
+            if (peek() == ')')
             {
-                LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("start of the dash comment", "", dash_comm_start)));
-                suffix_start = dash_comm_start;
-                shift = 2;
+                _pos++;
+                return Token(Token::ERROR, "Unmatched *)", _line_number);
             }
-            if (suffix_start != -1)
+            return make_token(Token::ASTERISK, start);
+        case '<':
+            if (peek() == '=')
             {
-                current_line_suffix = _current_line.substr(suffix_start + shift);
-                _current_line = _current_line.substr(0, suffix_start);
+                _pos++;
+                return make_token(Token::LE, start);
             }
-            // throw out suffix for comments starting from --
-            if (suffix_start == dash_comm_start)
+            // "<--" is a less sign before the comment
+            if (peek() == '-' && (_pos + 1 >= _size || _buffer[_pos + 1] != '-'))
             {
-                current_line_suffix.clear();
-                suffix_start = -1;
+                _pos++;
+                return make_token(Token::ASSIGN, start);
             }
-
-            // match all substring before Cool string and Cool comments
-            auto match_begin = std::sregex_iterator(_current_line.begin(), _current_line.end(), LEXER_SPEC_REGEX);
-            auto match_end = std::sregex_iterator();
-
-            for (auto it = match_begin; it != match_end; ++it)
+            return make_token(Token::LESS, start);
+        case '=':
+            if (peek() == '>')
             {
-                auto str_in_lowercase = it->str();
-                std::transform(str_in_lowercase.begin(), str_in_lowercase.end(), str_in_lowercase.begin(), ::tolower);
-
-                // we are not interested in characters (\x00) over the line length
-                if (it->position() >= _current_line.size())
-                {
-                    continue;
-                }
-                // if we matched \x00 in the string so create a string containing \x00
-                Token t(Token::ERROR, (it->str()).length() != 0 ? it->str() : std::string("\0", 1), _line_number);
-
-                if (Token::is_keyword(str_in_lowercase))
-                {
-                    LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("keyword or symbol", it->str(), it->position())));
-                    t = Token(Token::str_to_token(str_in_lowercase), it->str(), _line_number);
-                }
-                else if (Token::is_number(it->str()))
-                {
-                    LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("number", it->str(), it->position())));
-                    t = Token(Token::INT_CONST, str_in_lowercase, _line_number);
-                }
-                else if (Token::is_boolean(it->str()))
-                {
-                    LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("boolean", it->str(), it->position())));
-                    t = Token(Token::BOOL_CONST, str_in_lowercase, _line_number);
-                }
-                else if (Token::is_typeid(it->str()))
-                {
-                    LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("typeid", it->str(), it->position())));
-                    t = Token(Token::TYPEID, it->str(), _line_number);
-                }
-                else if (Token::is_object(it->str()))
-                {
-                    LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("object", it->str(), it->position())));
-                    t = Token(Token::OBJECTID, it->str(), _line_number);
-                }
-                else if (Token::is_close_par_comment(it->str()))
-                {
-                    LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("", it->str(), it->position())));
-                    t = Token(Token::ERROR, "Unmatched *)", _line_number);
-                }
-                else if (Token::is_whitespace(it->str()))
-                {
-                    LEXER_VERBOSE_ONLY(LOG(LEXER_LOG_MATCH("whitespace", it->str(), it->position())));
-                    continue;
-                }
-                _saved_tokens.push(t);
+                _pos++;
+                return make_token(Token::DARROW, start);
             }
-            _current_line.clear();
-
-            LEXER_VERBOSE_ONLY(LOG("Start analyzing a rest of the string."));
-
-            // analyze a rest of the string
-            if (suffix_start != -1)
-            {
-                // it is start of the Cool string
-                if (suffix_start == string_start)
-                {
-                    _saved_tokens.push(match_string(current_line_suffix));
-                }
-                else
-                {
-                    // it is start of the Cool comment
-                    auto t = skip_comment(current_line_suffix);
-                    if (t.has_value())
-                    {
-                        _saved_tokens.push(t.value());
-                    }
-                }
-            }
-
-            LEXER_VERBOSE_ONLY(LOG("End analyzing the rest of the string."));
+            return make_token(Token::EQUALS, start);
+        case ';':
+            return make_token(Token::SEMICOLON, start);
+        case '{':
+            return make_token(Token::LEFT_CURLY_BRACKET, start);
+        case '}':
+            return make_token(Token::RIGHT_CURLY_BRACKET, start);
+        case ':':
+            return make_token(Token::COLON, start);
+        case ')':
+            return make_token(Token::RIGHT_PAREN, start);
+        case '.':
+            return make_token(Token::DOT, start);
+        case '@':
+            return make_token(Token::AT, start);
+        case '~':
+            return make_token(Token::NEG, start);
+        case '/':
+            return make_token(Token::SLASH, start);
+        case '+':
+            return make_token(Token::PLUS, start);
+        case ',':
+            return make_token(Token::COMMA, start);
+        default:
+            // any other character is an error
+            return make_token(Token::ERROR, start);
         }
+    }
 
-        const auto t = _saved_tokens.front();
-        _saved_tokens.pop();
-
-        DEBUG_ONLY(if (TokensOnly) { LOG(t.to_string()); });
-
-        return t;
+    // EOF is on the line after the last one, even if the last line doesn't end with the new line symbol
+    if (!_eof && _size != 0 && _buffer[_size - 1] != '\n')
+    {
+        _line_number++;
     }
+    _eof = true;
+
+    return std::nullopt;
+}
 
-    const auto t = _saved_tokens.front();
-    _saved_tokens.pop();
+std::optional<Token> Lexer::next()
+{
+    auto token = match_token();
 
-    DEBUG_ONLY(if (TokensOnly) { LOG(t.to_string()); });
+    DEBUG_ONLY(if (TokensOnly && token) { LOG(token->to_string()); });
 
-    return t;
+    return token;
 }
@@ -1,10 +1,11 @@
 #pragma once
 
+#include "ast/SymbolTable.h"
 #include "token/Token.h"
-#include <fstream>
+#include <array>
+#include <deque>
 #include <optional>
-#include <queue>
-#include <regex>
+#include <unordered_map>
 
 #ifdef DEBUG
 #define LEXER_LOG_MATCH(type, str, pos)                                                                                \
@@ -26,26 +27,61 @@ class Lexer
   private:
     static constexpr int MAX_STR_CONST = 1025;
 
-    std::ifstream _input_file;
+    // character classes of the DFA
+    enum CharClass : uint8_t
+    {
+        OTHER,
+        WHITESPACE,
+        NEW_LINE,
+        DIGIT,
+        UPPER,
+        LOWER,
+        UNDERSCORE
+    };
+
+    static const std::array<CharClass, 256> CHAR_CLASS;
+    static const std::array<std::pair<std::string_view, Token::TokenType>, 17> KEYWORDS;
+
+    inline static CharClass char_class(const char &ch) { return CHAR_CLASS[static_cast<unsigned char>(ch)]; }
+    inline static bool is_id_char(const char &ch)
+    {
+        const auto cls = char_class(ch);
+        return cls >= DIGIT && cls <= UNDERSCORE;
+    }
+
     const std::string _file_name;
     int _line_number;
+    bool _eof;
+
+    // input file is mapped to memory, lexemes of the tokens refer to it
+    const char *_buffer;
+    size_t _size;
+    size_t _pos;
 
-    // lexer specification that is used outside of Cool strings and Cool comments
-    static const std::regex LEXER_SPEC_REGEX;
+    // lexemes of the strings with escape sequences
+    std::deque<std::string> _strings;
 
-    static const std::regex STR_SYMBOLS_REGEX;
-    static const std::regex COMM_SYMBOLS_REGEX;
+    // ids of the identifiers met in this file. Saves locking of the global table for every identifier
+    std::unordered_map<std::string_view, int> _symbols;
+    int symbol(const std::string_view &lexeme);
 
-    std::string _current_line;
-    std::queue<Token> _saved_tokens; // see next() description
+    inline char peek() const { return _pos < _size ? _buffer[_pos] : '\0'; }
+    inline Token make_token(const Token::TokenType &type, const size_t &start) const
+    {
+        return Token(type, std::string_view(_buffer + start, _pos - start), _line_number);
+    }
 
+    std::optional<Token> match_token();
+
+    Token match_identifier(const size_t &start);
+    Token match_number(const size_t &start);
     // return either STR_CONST or ERROR token
-    Token match_string(const std::string &start_string);
+    Token match_string();
     // return either std::nullopt if OK or ERROR token
-    std::optional<Token> skip_comment(const std::string &start_string);
+    std::optional<Token> skip_comment();
+    void skip_line_comment();
 
-    void append_to_string_if_can(std::string &prefix, const std::string &suffix, std::string &error_msg,
-                                 int &error_line_num);
+    void append_to_string_if_can(std::string &str, const char &ch, std::string_view &error_msg, int &error_line_num);
 
   public:
     /**
@@ -55,17 +91,20 @@ class Lexer
      */
     explicit Lexer(const std::string &input_file_name);
 
+    Lexer(const Lexer &) = delete;
+    Lexer &operator=(const Lexer &) = delete;
+
+    ~Lexer();
+
     /**
      * @brief Get maybe next token
      *
      * @return Next token or nullopt
      *
      * @details
-     * next() reads a line from the _input_file and save it in the _current_line.
-     * next() tries to match all possible tokens in the _current_line during a call and save them in the
-     * _saved_tokens. next next() calls will be pop tokens from the _saved_tokens if it is not empty. next() can read
-     * more than one line if it recognised start of Cool string or Cool comment, in such cases next() will read new
-     * lines until read EOF, end of string or end of comment. next() returns std::nullopt for EOF.
+     * next() runs the DFA from the current position of the mapped file until it recognises a token. Cool strings and
+     * Cool comments are matched by separate loops. Lexemes of the tokens refer to the mapped file, so they are valid
+     * while the Lexer is alive. next() returns std::nullopt for EOF.
      */
     std::optional<Token> next();
 
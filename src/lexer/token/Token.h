@@ -1,8 +1,7 @@
 #pragma once
 
-#include <algorithm>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 namespace lexer
@@ -62,12 +61,11 @@ class Token
     };
 
   private:
-    // name to token and token to name
-    static const std::unordered_map<std::string, TokenType> STR_TO_TOKEN_TYPE;
     static const std::vector<std::string> TOKEN_TYPE_TO_STR;
 
     TokenType _type;
-    std::string _lexeme;
+    std::string_view _lexeme;
+    int _symbol; // id of the lexeme in ast::SymbolTable for TYPEID and OBJECTID
 
     int _line_number;
 
@@ -76,84 +74,15 @@ class Token
      * @brief Construct a new Token
      *
      * @param type Type of token from TOKEN_TYPE
-     * @param substr Lexeme
+     * @param lexeme Lexeme, that refers to the source file or to the storage of the lexer
      * @param line_number Where this token was found in the file
+     * @param symbol Id of the lexeme in ast::SymbolTable or -1
      */
-    Token(const TokenType &type, const std::string &substr, const int &line_number)
-        : _type(type), _lexeme(substr), _line_number(line_number)
+    Token(const TokenType &type, const std::string_view &lexeme, const int &line_number, const int &symbol = -1)
+        : _type(type), _lexeme(lexeme), _symbol(symbol), _line_number(line_number)
     {
     }
 
-    /**
-     * @brief Get token type for Cool reserved words
-     *
-     * @param str Lexeme
-     * @return Token type for lexeme
-     */
-    inline static const TokenType &str_to_token(const std::string &str) { return STR_TO_TOKEN_TYPE.find(str)->second; }
-
-    /**
-     * @brief Check if lexeme is a keyword
-     *
-     * @param str Lexeme
-     * @return True if it is a keyword
-     */
-    inline static bool is_keyword(const std::string &str)
-    {
-        return !(STR_TO_TOKEN_TYPE.find(str) == STR_TO_TOKEN_TYPE.end());
-    }
-
-    /**
-     * @brief Check if lexeme is a whitespace
-     *
-     * @param str Lexeme
-     * @return True if it is a whitespace
-     */
-    inline static bool is_whitespace(const std::string &str)
-    {
-        return (str[0] == ' ' || str[0] == '\f' || str[0] == '\r' || str[0] == '\t' || str[0] == '\v');
-    }
-
-    /**
-     * @brief Check if lexeme is a number
-     *
-     * @param str Lexeme
-     * @return True if it is a number
-     */
-    inline static bool is_number(const std::string &str) { return isdigit(str[0]); }
-
-    /**
-     * @brief Check if lexeme is a boolean
-     *
-     * @param str Lexeme
-     * @return True if it is a boolean
-     */
-    static bool is_boolean(const std::string &str);
-
-    /**
-     * @brief Check if lexeme is a type name
-     *
-     * @param str Lexeme
-     * @return True if it is a type name
-     */
-    inline static bool is_typeid(const std::string &str) { return str[0] >= 'A' && str[0] <= 'Z' && !is_keyword(str); }
-
-    /**
-     * @brief Check if lexeme is an object name
-     *
-     * @param str Lexeme
-     * @return True if it is an object name
-     */
-    inline static bool is_object(const std::string &str) { return str[0] >= 'a' && str[0] <= 'z' && !is_keyword(str); }
-
-    /**
-     * @brief Check if lexeme is a closing comment bracket
-     *
-     * @param str Lexeme
-     * @return True if it a closing comment bracket
-     */
-    inline static bool is_close_par_comment(const std::string &str) { return str == "*)"; }
-
     /**
      * @brief Get the type as string
      *
@@ -181,7 +110,14 @@ class Token
      *
      * @return Lexeme
      */
-    inline const std::string &value() const { return _lexeme; }
+    inline const std::string_view &value() const { return _lexeme; }
+
+    /**
+     * @brief Get the id of the lexeme
+     *
+     * @return Id in ast::SymbolTable for TYPEID and OBJECTID, -1 for other tokens
+     */
+    inline const int &symbol() const { return _symbol; }
 
     /**
      * @brief Get the type
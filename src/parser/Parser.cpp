@@ -26,11 +26,11 @@ void Parser::report_error()
                  ": syntax error at or near ";
         if (type >= lexer::Token::SEMICOLON && type <= lexer::Token::COMMA)
         {
-            _error += "\'" + token.value() + "\'";
+            _error += "\'" + std::string(token.value()) + "\'";
         }
         else if (type >= lexer::Token::INT_CONST && type <= lexer::Token::STR_CONST)
         {
-            _error += token.type_as_str() + " = " + token.value();
+            _error += token.type_as_str() + " = " + std::string(token.value());
         }
         else
         {
@@ -38,8 +38,8 @@ void Parser::report_error()
         }
     }
 
-    PARSER_VERBOSE_ONLY(
-        LOG("Actual token: \"" + _next_token->value() + "\", actual type = " + std::to_string(_next_token->type())));
+    PARSER_VERBOSE_ONLY(LOG("Actual token: \"" + std::string(_next_token->value()) +
+                            "\", actual type = " + std::to_string(_next_token->type())));
 }
 
 bool Parser::check_next_and_report_error(const lexer::Token::TokenType &expected_type)
@@ -61,7 +61,7 @@ std::shared_ptr<ast::Program> Parser::parse_program()
     // check if program is empty
     PARSER_RETURN_IF_FALSE(_next_token);
 
-    const auto program = std::make_shared<ast::Program>();
+    const auto program = ast::make<ast::Program>();
     program->_line_number = _next_token->line_number();
 
     const bool result = parse_list<std::shared_ptr<ast::Class>>(
@@ -80,7 +80,7 @@ std::shared_ptr<ast::Class> Parser::parse_class()
 {
     PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE CLASS")));
 
-    const auto klass = std::make_shared<ast::Class>();
+    const auto klass = ast::make<ast::Class>();
     klass->_line_number = _next_token->line_number();
 
     PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::CLASS));
@@ -94,8 +94,8 @@ std::shared_ptr<ast::Class> Parser::parse_class()
     }
     else
     {
-        klass->_parent = std::make_shared<ast::Type>();
-        klass->_parent->_string = BaseClassesNames[BaseClasses::OBJECT];
+        klass->_parent = make_type(BaseClassesNames[BaseClasses::OBJECT],
+                                   ast::SymbolTable::intern(BaseClassesNames[BaseClasses::OBJECT]));
     }
 
     PARSER_ADVANCE_ELSE_RETURN(check_next_and_report_error(lexer::Token::LEFT_CURLY_BRACKET));
@@ -118,7 +118,7 @@ std::shared_ptr<ast::Feature> Parser::parse_feature()
 {
     PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE FEATURE")));
 
-    const auto feature = std::make_shared<ast::Feature>();
+    const auto feature = ast::make<ast::Feature>();
     feature->_line_number = _next_token->line_number();
 
     PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::OBJECTID), feature->_object = parse_object());
@@ -169,7 +169,7 @@ std::shared_ptr<ast::Formal> Parser::parse_formal()
 {
     PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE FORMAL")));
 
-    const auto formal = std::make_shared<ast::Formal>();
+    const auto formal = ast::make<ast::Formal>();
     formal->_line_number = _next_token->line_number();
 
     PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::OBJECTID), formal->_object = parse_object());
@@ -344,7 +344,7 @@ std::shared_ptr<ast::Expression> Parser::parse_isvoid()
 std::shared_ptr<ast::Case> Parser::parse_one_case()
 {
     PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE ONE CASE")));
-    const auto kase = std::make_shared<ast::Case>();
+    const auto kase = ast::make<ast::Case>();
     kase->_line_number = _next_token->line_number();
 
     PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::OBJECTID), kase->_object = parse_object());
@@ -483,7 +483,7 @@ bool Parser::parse_dispatch_list(std::vector<std::shared_ptr<ast::Expression>> &
             return false;
         }
     }
-    PARSER_VERBOSE_ONLY(LOG("Current token: \"" + _next_token->value() + "\""););
+    PARSER_VERBOSE_ONLY(LOG("Current token: \"" + std::string(_next_token->value()) + "\""););
     if (check_next_and_report_error(lexer::Token::RIGHT_PAREN))
     {
         advance_token();
@@ -579,13 +579,26 @@ std::shared_ptr<ast::Expression> Parser::parse_operators(const std::shared_ptr<a
 }
 
 // ----------------- Methods for parsing expression with complex type of starting -----------------
+std::shared_ptr<ast::Type> Parser::make_type(const std::string_view &name, const int &symbol)
+{
+    auto &type = _types[symbol];
+    if (!type)
+    {
+        type = ast::make<ast::Type>();
+        type->_string = name;
+        type->_symbol = symbol;
+    }
+
+    return type;
+}
+
 std::shared_ptr<ast::Type> Parser::parse_type()
 {
     PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE TYPE")));
 
-    const auto type = std::make_shared<ast::Type>();
-
-    PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::TYPEID), type->_string = _next_token->value());
+    std::shared_ptr<ast::Type> type;
+    PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::TYPEID),
+                           type = make_type(_next_token->value(), _next_token->symbol()));
     PARSER_ADVANCE_AND_RETURN_IF_EOF();
 
     PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE TYPE")));
@@ -596,9 +609,10 @@ std::shared_ptr<ast::ObjectExpression> Parser::parse_object()
 {
     PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE OBJECT")));
 
-    const auto obj = std::make_shared<ast::ObjectExpression>();
+    const auto obj = ast::make<ast::ObjectExpression>();
 
-    PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::OBJECTID), obj->_object = _next_token->value());
+    PARSER_ACT_ELSE_RETURN(check_next_and_report_error(lexer::Token::OBJECTID), obj->_object = _next_token->value();
+                           obj->_symbol = _next_token->symbol());
     PARSER_ADVANCE_AND_RETURN_IF_EOF();
 
     PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE OBJECT")));
@@ -622,7 +636,7 @@ std::shared_ptr<ast::Expression> Parser::parse_expr_object()
     }
     case lexer::Token::LEFT_PAREN: {
         ast::DispatchExpression dispatch;
-        dispatch._expr = make_expr(std::move(ast::ObjectExpression{SelfObject}), line);
+        dispatch._expr = make_expr(std::move(ast::ObjectExpression{SelfObject, _self_symbol}), line);
         dispatch._object = lhs;
 
         PARSER_RETURN_IF_FALSE(parse_dispatch_list(dispatch._args));
@@ -641,7 +655,7 @@ std::shared_ptr<ast::Expression> Parser::parse_int()
     PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE INT")));
     const auto line = _next_token->line_number();
 
-    const auto value = std::stoi(_next_token->value());
+    const auto value = std::stoi(std::string(_next_token->value()));
     PARSER_ADVANCE_AND_RETURN_IF_EOF();
 
     PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE INT")));
@@ -653,7 +667,7 @@ std::shared_ptr<ast::Expression> Parser::parse_string()
     PARSER_VERBOSE_ONLY(LOG_ENTER(PARSER_APPEND_LINE_NUM("PARSE STRING")));
     const auto line = _next_token->line_number();
 
-    const auto value = _next_token->value();
+    const auto value = std::string(_next_token->value());
     PARSER_ADVANCE_AND_RETURN_IF_EOF();
 
     PARSER_VERBOSE_ONLY(LOG_EXIT(PARSER_APPEND_LINE_NUM("PARSE STRING")));
@@ -1,7 +1,11 @@
 #pragma once
 
 #include "ast/AST.h"
+#include "decls/Decls.h"
 #include "lexer/Lexer.h"
+#include <functional>
+#include <stack>
+#include <unordered_map>
 
 #ifdef DEBUG
 #define PARSER_APPEND_LINE_NUM(msg)                                                                                    \
@@ -11,7 +15,7 @@
 #endif // DEBUG
 
 #define PARSER_ACT_ELSE_RETURN(pred, action)                                                                           \
-    PARSER_VERBOSE_ONLY(LOG("Current token: \"" + _next_token->value() + "\""););                                      \
+    PARSER_VERBOSE_ONLY(LOG("Current token: \"" + std::string(_next_token->value()) + "\""););                         \
     if (pred)                                                                                                          \
     {                                                                                                                  \
         action;                                                                                                        \
@@ -32,7 +36,7 @@
     PARSER_RETURN_IF_EOF();
 
 #define PARSER_ADVANCE_ELSE_RETURN(pred)                                                                               \
-    PARSER_VERBOSE_ONLY(LOG("Current token: \"" + _next_token->value() + "\""););                                      \
+    PARSER_VERBOSE_ONLY(LOG("Current token: \"" + std::string(_next_token->value()) + "\""););                         \
     if (pred)                                                                                                          \
         advance_token();                                                                                               \
     else                                                                                                               \
@@ -56,6 +60,8 @@ class Parser
 
     std::string _error; // error message
 
+    const int _self_symbol; // id of self object for the implicit dispatches
+
     inline void advance_token() { _next_token = std::move(_lexer->next()); }
 
     // error handling
@@ -94,6 +100,10 @@ class Parser
     std::shared_ptr<ast::Expression> parse_maybe_dispatch_or_oper(const std::shared_ptr<ast::Expression> &expr);
     bool parse_dispatch_list(std::vector<std::shared_ptr<ast::Expression>> &list);
 
+    // type nodes are not changed after parsing, so all occurrences of the type name share one node
+    std::unordered_map<int, std::shared_ptr<ast::Type>> _types;
+    std::shared_ptr<ast::Type> make_type(const std::string_view &name, const int &symbol);
+
     std::shared_ptr<ast::Type> parse_type();
     std::shared_ptr<ast::ObjectExpression> parse_object();
     // parse expressions starting from object
@@ -125,7 +135,8 @@ class Parser
      *
      * @param lexer Lexer for retrieving tokens
      */
-    explicit Parser(const std::shared_ptr<lexer::Lexer> &lexer) : _lexer(lexer), _next_token(_lexer->next())
+    explicit Parser(const std::shared_ptr<lexer::Lexer> &lexer)
+        : _lexer(lexer), _next_token(_lexer->next()), _self_symbol(ast::SymbolTable::intern(SelfObject))
     {
         _precedence_level.push(-1);
     }
@@ -8,7 +8,7 @@ using namespace parser;
 
 template <class T> std::shared_ptr<ast::Expression> Parser::make_expr(T &&variant, const int &line)
 {
-    const auto expr = std::make_shared<ast::Expression>();
+    const auto expr = ast::make<ast::Expression>();
     expr->_data = std::forward<T>(variant);
     expr->_line_number = line;
 
@@ -0,0 +1,108 @@
+#include "Profile.hpp"
+#include "Runtime.h"
+#include "globals.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// profile of this run. It is set only if the program is instrumented
+static ProfileFunction *Functions = nullptr; // NOLINT
+static int FunctionsNum = 0;                 // NOLINT
+static uint64_t *Counters = nullptr;         // NOLINT
+
+// program can exit from abort() and runtime errors too, so profile is written at exit
+struct ProfileWriter
+{
+    ~ProfileWriter() { write_profile(); }
+};
+
+void _init_profile(ProfileFunction *funcs, int funcs_num, uint64_t *counters) // NOLINT
+{
+    Functions = funcs;
+    FunctionsNum = funcs_num;
+    Counters = counters;
+
+    // it is destroyed before the flags, because it is constructed after them
+    static ProfileWriter writer;
+}
+
+// line is a function name, number of counters and the counters. Missing file is an empty profile
+static bool read_profile(std::unordered_map<std::string, std::vector<uint64_t>> &prev)
+{
+    std::ifstream in(ProfileFile);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::istringstream fields(line);
+        std::string name;
+        size_t counters_num = 0;
+        if (!(fields >> name >> counters_num))
+        {
+            return false;
+        }
+
+        auto &counters = prev[name];
+        uint64_t counter = 0;
+        while (fields >> counter)
+        {
+            counters.push_back(counter);
+        }
+
+        // truncated or corrupted line
+        if (!fields.eof() || counters.size() != counters_num)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void write_profile()
+{
+    if (!Functions)
+    {
+        return;
+    }
+
+    // counts of the previous runs
+    std::unordered_map<std::string, std::vector<uint64_t>> prev;
+    if (!read_profile(prev))
+    {
+        fprintf(stderr, "profile %s is corrupted, counts of the previous runs are dropped!\n", ProfileFile.c_str());
+        prev.clear();
+    }
+
+    auto *const out = fopen(ProfileFile.c_str(), "w");
+    if (!out)
+    {
+        fprintf(stderr, "cannot write profile to %s!\n", ProfileFile.c_str());
+        Functions = nullptr;
+        return;
+    }
+
+    auto *counter = Counters;
+    for (auto i = 0; i < FunctionsNum; i++)
+    {
+        const auto &func = Functions[i];
+
+        // function was changed since the previous run
+        auto prev_counters = prev.find(func._name);
+        const auto accumulate = prev_counters != prev.end() && prev_counters->second.size() == (size_t)func._counters_num;
+
+        fprintf(out, "%s %lld", func._name, (long long)func._counters_num);
+        for (auto j = 0; j < func._counters_num; j++, counter++)
+        {
+            fprintf(out, " %llu", (unsigned long long)(*counter + (accumulate ? prev_counters->second[j] : 0)));
+        }
+        fprintf(out, "\n");
+    }
+
+    fclose(out);
+
+    // write only once
+    Functions = nullptr;
+}
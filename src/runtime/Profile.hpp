@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Function of the instrumented program
+ *
+ * Counters of the functions follow each other in the same order as the functions.
+ *
+ */
+struct ProfileFunction
+{
+    const char *_name;
+    int64_t _counters_num;
+};
+
+/**
+ * @brief Write the profile of the instrumented program to ProfileFile
+ *
+ * Every line of the profile is a function name, number of its counters and the counters. Counts of the previous runs
+ * of the same program are accumulated.
+ *
+ */
+void write_profile();
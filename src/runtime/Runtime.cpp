@@ -16,6 +16,8 @@ void _init_runtime(int argc, char **argv) // NOLINT
 
 void _finish_runtime() // NOLINT
 {
+    write_profile();
+
     gc::GC::release();
     gc::Marker::release();
     gc::StackWalker::release();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ObjectLayout.hpp"
+#include "Profile.hpp"
 
 extern "C"
 {
@@ -18,6 +19,15 @@ extern "C"
      */
     void _finish_runtime(); // NOLINT
 
+    /**
+     * @brief Collect the profile of the instrumented program
+     *
+     * @param funcs Instrumented functions
+     * @param funcs_num Number of the functions
+     * @param counters Counters of all functions
+     */
+    void _init_profile(ProfileFunction *funcs, int funcs_num, uint64_t *counters); // NOLINT
+
     /**
      * @brief Check if two objects are equal
      *
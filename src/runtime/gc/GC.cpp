@@ -2,32 +2,40 @@
 #include "Utils.hpp"
 #include <cstdio>
 #include <cstring>
+#include <sys/resource.h>
 
 using namespace gc;
 
 GC *GC::Gc = nullptr;
 
-std::chrono::milliseconds GCStats::Phases[GCPhaseCount];
+std::chrono::nanoseconds GCStats::Phases[GCPhaseCount];
 std::string GCStats::PhasesNames[GCPhaseCount] = {"ALLOCATE", "MARK    ", "COLLECT "};
 
-GCStats::GCStats(GCPhase phase)
-    : _phase(phase),
-      _local_start(duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()))
+GCStats::GCStats(GCPhase phase) : _phase(phase), _local_start(std::chrono::steady_clock::now())
 {
 }
 
 GCStats::~GCStats()
 {
-    Phases[_phase] +=
-        (duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()) - _local_start);
+    Phases[_phase] += std::chrono::steady_clock::now() - _local_start;
 }
 
 void GCStats::dump()
 {
     for (int i = 0; i < GCPhaseCount; i++)
     {
-        fprintf(stderr, "GC Phase %s: %s\n", PhasesNames[i].c_str(), printable_time(Phases[i].count()).c_str());
+        fprintf(stderr, "GC Phase %s: %s\n", PhasesNames[i].c_str(),
+                printable_time(duration_cast<std::chrono::milliseconds>(Phases[i]).count()).c_str());
     }
+
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    const unsigned long long peak_rss = usage.ru_maxrss; // bytes on MacOS
+#else
+    const unsigned long long peak_rss = usage.ru_maxrss * 1024ULL;
+#endif // __APPLE__
+    fprintf(stderr, "Peak RSS: %s\n", printable_size(peak_rss).c_str());
 }
 
 ObjectLayout *GC::allocate(int tag, size_t size, void *disp_tab)
@@ -20,10 +20,11 @@ class GCStats
     };
 
   private:
-    static std::chrono::milliseconds Phases[GCPhaseCount];
+    // phases are short, so accumulate them precisely and round only the total
+    static std::chrono::nanoseconds Phases[GCPhaseCount];
     static std::string PhasesNames[GCPhaseCount];
 
-    std::chrono::milliseconds _local_start; // start of the period
+    std::chrono::steady_clock::time_point _local_start; // start of the period
     GCPhase _phase;
 
   public:
@@ -37,7 +38,7 @@ class GCStats
     ~GCStats();
 
     /**
-     * @brief Print timers
+     * @brief Print timers and peak RSS of the process
      *
      */
     static void dump();
@@ -1,4 +1,5 @@
 #include "Utils.hpp"
+#include <cstdio>
 
 #define SECONDS 1000
 #define MINUTES (SECONDS * 60)
@@ -23,8 +24,11 @@ std::string printable_time(unsigned long long time_in_millis)
         time += std::to_string(minutes) + "m:";
     }
 
+    char millis_str[4];
+    snprintf(millis_str, sizeof(millis_str), "%03d", millis);
+
     time += std::to_string(seconds) + ".";
-    time += std::to_string(millis % 1000) + "s";
+    time += std::string(millis_str) + "s";
 
     return time;
 }
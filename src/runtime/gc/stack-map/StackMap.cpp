@@ -5,16 +5,55 @@ using namespace gc::stackmap;
 
 StackMap *StackMap::Map = nullptr;
 
+#ifdef JIT_RUNTIME
+address _stackmaps_start = nullptr; // NOLINT
+address _stackmaps_end = nullptr;   // NOLINT
+#endif                              // JIT_RUNTIME
+
 StackMap::StackMap()
 {
-    Header *hdr = (Header *)&__LLVM_StackMaps;
+#ifdef JIT_RUNTIME
+    address stackmap = _stackmaps_start;
+    address const stackmaps_end = _stackmaps_end;
+#else
+    address stackmap = (address)&__start_llvm_stackmaps;
+    address const stackmaps_end = (address)&__stop_llvm_stackmaps;
+#endif // JIT_RUNTIME
+    while (stackmap < stackmaps_end)
+    {
+        stackmap = parse(stackmap);
+    }
+
+#ifdef DEBUG
+    if (PrintStackMaps)
+    {
+        for (const auto &safepoint : _stack_maps)
+        {
+            fprintf(stderr, "Safepoint address: %p\n", safepoint.first);
+            fprintf(stderr, "Stack size: %d\n", safepoint.second._stack_size);
+            int i = 0;
+            for (const auto &offset : safepoint.second._offsets)
+            {
+                fprintf(stderr, "%d: Offset(reg = %d) = %d, base offset(reg = %d) = %d\n", i, offset._der_reg,
+                        offset._offset, offset._base_reg, offset._base_offset);
+                i++;
+            }
+            fprintf(stderr, "\n");
+        }
+    }
+#endif // DEBUG
+}
+
+address StackMap::parse(address stackmap)
+{
+    Header *hdr = (Header *)stackmap;
 
     assert(hdr->_version == 3);
     assert(hdr->_num_constants == 0);
     assert(hdr->_reserved0 == 0);
     assert(hdr->_reserved1 == 0);
 
-    StkSizeRecord *funcs = (StkSizeRecord *)((address)&__LLVM_StackMaps + sizeof(Header));
+    StkSizeRecord *funcs = (StkSizeRecord *)(stackmap + sizeof(Header));
     address recrds = (address)(funcs + hdr->_num_functions);
 
     for (int i = 0; i < hdr->_num_functions; i++)
@@ -82,7 +121,8 @@ StackMap::StackMap()
 
                     assert(lock->_reserved1 == 0);
                     assert(lock->_type == LocationType::Constant);
-                    assert(lock->_offset_or_small_constant == 0);
+                    // the first one is a calling convention: internal functions can be fastcc
+                    assert(k == 0 || lock->_offset_or_small_constant == 0);
 
                     recrds += sizeof(Location);
                 }
@@ -170,24 +210,7 @@ StackMap::StackMap()
         }
     }
 
-#ifdef DEBUG
-    if (PrintStackMaps)
-    {
-        for (const auto &safepoint : _stack_maps)
-        {
-            fprintf(stderr, "Safepoint address: %p\n", safepoint.first);
-            fprintf(stderr, "Stack size: %d\n", safepoint.second._stack_size);
-            int i = 0;
-            for (const auto &offset : safepoint.second._offsets)
-            {
-                fprintf(stderr, "%d: Offset(reg = %d) = %d, base offset(reg = %d) = %d\n", i, offset._der_reg,
-                        offset._offset, offset._base_reg, offset._base_offset);
-                i++;
-            }
-            fprintf(stderr, "\n");
-        }
-    }
-#endif // DEBUG
+    return recrds;
 }
 
 const AddrInfo *StackMap::info(address ret) const
@@ -5,9 +5,20 @@
 #include <unordered_map>
 #include <vector>
 
-extern address __LLVM_StackMaps;            // NOLINT
+#ifdef JIT_RUNTIME
+// JIT linker supports neither thread local storage nor section bounds symbols, so coolc --run sets bounds of the stack
+// maps section before the start
+extern address _stackmaps_start; // NOLINT
+extern address _stackmaps_end;   // NOLINT
+extern address _stack_pointer;   // NOLINT
+extern address _frame_pointer;   // NOLINT
+#else
+// linker defines bounds of the stack maps section, every object file brings its own stack map there
+extern address __start_llvm_stackmaps;      // NOLINT
+extern address __stop_llvm_stackmaps;       // NOLINT
 extern thread_local address _stack_pointer; // NOLINT
 extern thread_local address _frame_pointer; // NOLINT
+#endif // JIT_RUNTIME
 
 namespace gc
 {
@@ -121,11 +132,14 @@ class StackMap
 
     std::unordered_map<address, AddrInfo> _stack_maps;
 
+    // parse a stack map of one object file and return its end
+    address parse(address stackmap);
+
   public:
     StackMap();
 
     /**
-     * @brief Parse __LLVM_StackMaps section
+     * @brief Parse llvm_stackmaps section
      *
      */
     static void init();
@@ -44,6 +44,9 @@ int GCAlgo = 0; // ZeroGC
 std::string MaxHeapSize = "384Kb";
 #endif // LLVM_SHADOW_STACK || LLVM_STATEPOINT_EXAMPLE
 
+// profile of the program that was compiled with -profile-generate
+std::string ProfileFile = "cool.profile";
+
 const std::unordered_map<std::string, bool *> BoolFlags = {
 #ifdef LLVM_STATEPOINT_EXAMPLE
 #ifdef DEBUG
@@ -57,7 +60,7 @@ const std::unordered_map<std::string, bool *> BoolFlags = {
 #endif // DEBUG
     flag_pair(PrintGCStatistics)};
 
-const std::unordered_map<std::string, std::string *> StringFlags = {flag_pair(MaxHeapSize)};
+const std::unordered_map<std::string, std::string *> StringFlags = {flag_pair(MaxHeapSize), flag_pair(ProfileFile)};
 
 const std::unordered_map<std::string, int *> IntFlags = {flag_pair(GCAlgo)};
 
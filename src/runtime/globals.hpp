@@ -17,6 +17,7 @@ extern bool TraceVerifyOops;
 extern bool PrintGCStatistics;
 extern std::string MaxHeapSize;
 extern int GCAlgo;
+extern std::string ProfileFile;
 
 #ifdef LLVM_STATEPOINT_EXAMPLE
 #ifdef DEBUG
@@ -1,6 +1,7 @@
 #include "semant/Semant.h"
 #include "utils/logger/Logger.h"
 #include <algorithm>
+#include <bit>
 
 using namespace semant;
 
@@ -12,7 +13,7 @@ std::shared_ptr<ast::Program> Semant::merge_to_one_program(const std::vector<std
         return nullptr;
     }
 
-    const auto program = std::make_shared<ast::Program>();
+    const auto program = ast::make<ast::Program>();
     program->_line_number = programs.at(0)->_line_number;
 
     for (const auto &p : programs)
@@ -27,32 +28,57 @@ Semant::Semant(std::vector<std::shared_ptr<ast::Program>> programs) : _program(m
 
 // ---------------------------------------- CLASS CHECK ----------------------------------------
 
+std::shared_ptr<ast::Type> Semant::make_type(const std::string_view &name)
+{
+    const auto type = ast::make<ast::Type>();
+    type->_string = name;
+    type->_symbol = ast::SymbolTable::intern(name);
+
+    return type;
+}
+
+std::shared_ptr<ast::ObjectExpression> Semant::make_object(const std::string_view &name)
+{
+    const auto object = ast::make<ast::ObjectExpression>();
+    object->_object = name;
+    object->_symbol = ast::SymbolTable::intern(name);
+
+    return object;
+}
+
+void Semant::add_class(const std::shared_ptr<ClassNode> &klass)
+{
+    const auto &symbol = klass->_class->_type->_symbol;
+    if (symbol >= _classes.size())
+    {
+        _classes.resize(symbol + 1);
+    }
+
+    _classes[symbol] = klass;
+}
+
 std::shared_ptr<ClassNode> Semant::make_basic_class(
     const std::string &name, const std::string &parent,
     const std::vector<std::pair<std::string, std::vector<std::string>>> &methods,
     const std::vector<std::shared_ptr<ast::Type>> &fields)
 {
     const auto klass = std::make_shared<ClassNode>();
-    klass->_class = std::make_shared<ast::Class>();
-    klass->_class->_type = std::make_shared<ast::Type>();
-    klass->_class->_parent = std::make_shared<ast::Type>();
+    klass->_class = ast::make<ast::Class>();
+    klass->_class->_type = make_type(name);
+    klass->_class->_parent = make_type(parent);
     klass->_class->_expression_stack = 0;
 
-    klass->_class->_type->_string = name;
-    klass->_class->_parent->_string = parent;
     for (const auto &m : methods)
     {
-        const auto feature = std::make_shared<ast::Feature>();
+        const auto feature = ast::make<ast::Feature>();
         feature->_base = ast::MethodFeature();
 
         // method name
-        feature->_object = std::make_shared<ast::ObjectExpression>();
-        feature->_object->_object = m.first;
+        feature->_object = make_object(m.first);
 
         // method ret type
         GUARANTEE_DEBUG(!methods.empty());
-        feature->_type = std::make_shared<ast::Type>();
-        feature->_type->_string = m.second.front();
+        feature->_type = make_type(m.second.front());
 
         auto &method = std::get<ast::MethodFeature>(feature->_base);
         method._expression_stack = 0;
@@ -61,13 +87,12 @@ std::shared_ptr<ClassNode> Semant::make_basic_class(
         for (auto i = 1; i < m.second.size(); i++)
         {
             // formal name
-            method._formals.push_back(std::make_shared<ast::Formal>());
-            method._formals.back()->_object = std::make_shared<ast::ObjectExpression>();
-            method._formals.back()->_object->_object = static_cast<std::string>(DUMMY_ARG_SUFFIX) + std::to_string(i);
+            method._formals.push_back(ast::make<ast::Formal>());
+            method._formals.back()->_object =
+                make_object(static_cast<std::string>(DUMMY_ARG_SUFFIX) + std::to_string(i));
 
             // formal type
-            method._formals.back()->_type = std::make_shared<ast::Type>();
-            method._formals.back()->_type->_string = m.second[i];
+            method._formals.back()->_type = make_type(m.second[i]);
         }
 
         klass->_class->_features.push_back(feature);
@@ -77,38 +102,37 @@ std::shared_ptr<ClassNode> Semant::make_basic_class(
     static auto N = 0;
     for (const auto &f : fields)
     {
-        const auto feature = std::make_shared<ast::Feature>();
+        const auto feature = ast::make<ast::Feature>();
         feature->_base = ast::AttrFeature();
 
-        feature->_object = std::make_shared<ast::ObjectExpression>();
+        feature->_object = make_object(static_cast<std::string>(DUMMY_FIELD_SUFFIX) + std::to_string(N));
         feature->_type = f;
-        feature->_object->_object = static_cast<std::string>(DUMMY_FIELD_SUFFIX) + std::to_string(N);
 
         klass->_class->_features.push_back(feature);
 
         N++;
     }
 
-    _classes.insert({name, klass});
+    add_class(klass);
     return klass;
 }
 
-bool Semant::check_class_hierarchy_for_cycle(const std::shared_ptr<ClassNode> &klass,
-                                             std::unordered_map<std::string, int> &visited, const int &loop)
+bool Semant::check_class_hierarchy_for_cycle(const std::shared_ptr<ClassNode> &klass, std::vector<int> &visited,
+                                             const int &loop)
 {
-    const auto &class_name = klass->_class->_type->_string;
+    const auto &class_symbol = klass->_class->_type->_symbol;
 
-    if (visited[class_name] == loop)
+    if (visited[class_symbol] == loop)
     {
         return false;
     }
 
-    visited[class_name] = loop;
+    visited[class_symbol] = loop;
 
     for (const auto &child : klass->_children)
     {
         SEMANT_RETURN_IF_FALSE(check_class_hierarchy_for_cycle(child, visited, loop), false);
-        visited[class_name] = false;
+        visited[class_symbol] = false;
     }
 
     return true;
@@ -148,28 +172,28 @@ bool Semant::check_class_hierarchy()
         SEMANT_RETURN_IF_FALSE_WITH_ERROR(!is_basic_type(klass->_type),
                                           "Redefinition of basic class " + class_name + ".", klass->_line_number,
                                           false);
-        SEMANT_RETURN_IF_FALSE_WITH_ERROR(_classes.find(class_name) == _classes.end(),
+        SEMANT_RETURN_IF_FALSE_WITH_ERROR(!class_exists(klass->_type->_symbol),
                                           "Class " + class_name + " was previously defined.", klass->_line_number,
                                           false);
 
         const auto new_class = std::make_shared<ClassNode>();
         new_class->_class = klass;
-        _classes.insert({class_name, new_class});
+        add_class(new_class);
 
-        const auto parent = _classes.find(klass->_parent->_string);
-        if (parent == _classes.end())
+        if (!class_exists(klass->_parent->_symbol))
         {
             delayed_parent.push_back(new_class);
         }
         else
         {
-            const auto &class_type = parent->second->_class->_type;
+            const auto &parent = class_node(klass->_parent);
+            const auto &class_type = parent->_class->_type;
 
             SEMANT_RETURN_IF_FALSE_WITH_ERROR(is_inherit_allowed(class_type),
                                               "Class " + class_name + " cannot inherit class " + class_type->_string +
                                                   ".",
                                               klass->_line_number, false);
-            parent->second->_children.push_back(new_class);
+            parent->_children.push_back(new_class);
         }
     }
 
@@ -178,39 +202,34 @@ bool Semant::check_class_hierarchy()
         _error_file_name = klass->_class->_file_name; // for error
         const auto &parent_class_name = klass->_class->_parent->_string;
 
-        const auto parent = _classes.find(parent_class_name);
-        SEMANT_RETURN_IF_FALSE_WITH_ERROR(parent != _classes.end(),
+        SEMANT_RETURN_IF_FALSE_WITH_ERROR(class_exists(klass->_class->_parent->_symbol),
                                           "Class " + klass->_class->_type->_string +
                                               " inherits from an undefined class " + parent_class_name + ".",
                                           klass->_class->_line_number, false);
-        parent->second->_children.push_back(klass);
+        class_node(klass->_class->_parent)->_children.push_back(klass);
     }
 
-    std::unordered_map<std::string, int> visited;
-    for (const auto &klass : _classes)
-    {
-        visited.insert({klass.first, -1});
-    }
+    std::vector<int> visited(_classes.size(), -1);
 
     auto loop_num = 0;
     auto cycle_num = 1;
     for (const auto &klass : _classes)
     {
-        if (visited[klass.first] != -1)
+        if (!klass || visited[klass->_class->_type->_symbol] != -1)
         {
             continue;
         }
         // format error
-        if (!check_class_hierarchy_for_cycle(klass.second, visited, loop_num))
+        if (!check_class_hierarchy_for_cycle(klass, visited, loop_num))
         {
             _error_line_number = -1;
             _error_message += "Cycle " + std::to_string(cycle_num) + ":\n";
             cycle_num++;
-            for (const auto &klass : visited)
+            for (auto symbol = 0; symbol < visited.size(); symbol++)
             {
-                if (klass.second == loop_num)
+                if (visited[symbol] == loop_num)
                 {
-                    const auto &class_node = _classes[klass.first]->_class;
+                    const auto &class_node = _classes[symbol]->_class;
                     const auto &class_name = class_node->_type->_string;
 
                     _error_message += class_node->_file_name + ":" + std::to_string(class_node->_line_number) +
@@ -232,16 +251,66 @@ bool Semant::check_class_hierarchy()
     return true;
 }
 
+void Semant::index_class(ClassNode *node, int &dfs_num, const int &depth)
+{
+    node->_dfs_num = dfs_num++;
+    node->_depth = depth;
+    node->_euler_index = _euler_tour.size();
+    _euler_tour.push_back(node);
+
+    for (const auto &child : node->_children)
+    {
+        index_class(child.get(), dfs_num, depth + 1);
+        _euler_tour.push_back(node);
+    }
+
+    node->_child_max_dfs_num = dfs_num - 1;
+}
+
+void Semant::index_class_hierarchy()
+{
+    SEMANT_VERBOSE_ONLY(LOG_ENTER("INDEX CLASS HIERARCHY"));
+
+    auto dfs_num = 0;
+    _euler_tour.clear();
+    index_class(_root.get(), dfs_num, 0);
+
+    const int size = _euler_tour.size();
+
+    _lca_table.clear();
+    _lca_table.emplace_back(size);
+    for (auto i = 0; i < size; i++)
+    {
+        _lca_table[0][i] = i;
+    }
+
+    for (auto k = 1; (1 << k) <= size; k++)
+    {
+        _lca_table.emplace_back(size - (1 << k) + 1);
+
+        const auto &prev = _lca_table[k - 1];
+        auto &level = _lca_table[k];
+        for (auto i = 0; i < level.size(); i++)
+        {
+            const auto l = prev[i];
+            const auto r = prev[i + (1 << (k - 1))];
+            level[i] = _euler_tour[l]->_depth <= _euler_tour[r]->_depth ? l : r;
+        }
+    }
+
+    SEMANT_VERBOSE_ONLY(LOG_EXIT("INDEX CLASS HIERARCHY"));
+}
+
 bool Semant::check_main()
 {
     SEMANT_VERBOSE_ONLY(LOG_ENTER("CHECK MAIN"));
 
     auto found_main = false;
 
-    const auto main_class = _classes.find(MainClassName);
-    SEMANT_RETURN_IF_FALSE_WITH_ERROR(main_class != _classes.end(), "Class Main is not defined.", -1, false);
+    const auto main_class = ast::SymbolTable::intern(MainClassName);
+    SEMANT_RETURN_IF_FALSE_WITH_ERROR(class_exists(main_class), "Class Main is not defined.", -1, false);
 
-    for (const auto &feature : main_class->second->_class->_features)
+    for (const auto &feature : _classes[main_class]->_class->_features)
     {
         if (std::holds_alternative<ast::MethodFeature>(feature->_base))
         {
@@ -257,7 +326,7 @@ bool Semant::check_main()
     }
 
     SEMANT_RETURN_IF_FALSE_WITH_ERROR(found_main, "No 'main' method in class Main.",
-                                      _classes[MainClassName]->_class->_line_number, false);
+                                      _classes[main_class]->_class->_line_number, false);
 
     SEMANT_VERBOSE_ONLY(LOG_EXIT("CHECK MAIN"));
     return true;
@@ -269,17 +338,10 @@ bool Semant::check_classes()
     // add Object to hierarchy
     SEMANT_VERBOSE_ONLY(LOG_ENTER("CREATE BASIC CLASSES"));
 
-    Empty = std::make_shared<ast::Type>();
-    Empty->_string = EMPTY_TYPE_NAME;
-
-    NativeInt = std::make_shared<ast::Type>();
-    NativeInt->_string = NATIVE_INT_TYPE_NAME;
-
-    NativeBool = std::make_shared<ast::Type>();
-    NativeBool->_string = NATIVE_BOOL_TYPE_NAME;
-
-    NativeString = std::make_shared<ast::Type>();
-    NativeString->_string = NATIVE_STRING_TYPE_NAME;
+    Empty = make_type(EMPTY_TYPE_NAME);
+    NativeInt = make_type(NATIVE_INT_TYPE_NAME);
+    NativeBool = make_type(NATIVE_BOOL_TYPE_NAME);
+    NativeString = make_type(NATIVE_STRING_TYPE_NAME);
 
     _root = make_basic_class(BaseClassesNames[BaseClasses::OBJECT], Empty->_string,
                              {{ObjectMethodsNames[ObjectMethods::ABORT], {BaseClassesNames[BaseClasses::OBJECT]}},
@@ -331,6 +393,7 @@ bool Semant::check_classes()
 
     // 2. Add user defined classes to hierarchy
     SEMANT_RETURN_IF_FALSE(check_class_hierarchy(), false);
+    index_class_hierarchy();
 
     // 3. Check main method in Main class
     SEMANT_RETURN_IF_FALSE(check_main(), false);
@@ -362,7 +425,7 @@ bool Semant::check_expression_in_method(const std::shared_ptr<ast::Feature> &fea
     scope.push_scope();
 
     auto &this_method = std::get<ast::MethodFeature>(feature->_base);
-    const auto &klass = _classes[_current_class->_string]->_class;
+    const auto &klass = class_node(_current_class)->_class;
 
     _expression_stack = 0;
 
@@ -373,14 +436,15 @@ bool Semant::check_expression_in_method(const std::shared_ptr<ast::Feature> &fea
 
     // multiple defined in one class
     const bool is_ones_defined =
-        std::count_if(klass->_features.begin(), klass->_features.end(), [&feature, &name](const auto &m) {
-            return (std::holds_alternative<ast::MethodFeature>(m->_base) && m->_object->_object == name);
+        std::count_if(klass->_features.begin(), klass->_features.end(), [&feature](const auto &m) {
+            return (std::holds_alternative<ast::MethodFeature>(m->_base) &&
+                    m->_object->_symbol == feature->_object->_symbol);
         }) == 1;
     SEMANT_RETURN_IF_FALSE_WITH_ERROR(is_ones_defined, "Method " + name + " is multiply defined.",
                                       feature->_line_number, false);
 
     // parent method
-    const auto parent_feature = find_method(name, klass->_type, false);
+    const auto parent_feature = find_method(feature->_object->_symbol, klass->_type, false);
     ast::MethodFeature parent_method;
 
     if (parent_feature)
@@ -407,7 +471,7 @@ bool Semant::check_expression_in_method(const std::shared_ptr<ast::Feature> &fea
                                               " is undefined.",
                                           formal->_line_number, false);
 
-        const auto result = scope.add_if_can(formal_name, formal->_type);
+        const auto result = scope.add_if_can(formal->_object->_symbol, formal->_type);
         if (result != Scope::AddResult::OK)
         {
             _error_line_number = formal->_line_number;
@@ -504,7 +568,7 @@ bool Semant::check_expressions_in_class(const std::shared_ptr<ClassNode> &node,
             const auto &feature_name = feature->_object->_object;
             if (std::holds_alternative<ast::AttrFeature>(feature->_base))
             {
-                const auto result = scope.add_if_can(feature_name, feature->_type);
+                const auto result = scope.add_if_can(feature->_object->_symbol, feature->_type);
                 _error_line_number = feature->_line_number;
                 if (result == Scope::RESERVED)
                 {
@@ -521,7 +585,7 @@ bool Semant::check_expressions_in_class(const std::shared_ptr<ClassNode> &node,
                 }
 
                 // check if attribute is inherited from parent or redefined
-                const auto parent_attr = scope.find(feature_name, 1);
+                const auto parent_attr = scope.find(feature->_object->_symbol, 1);
                 SEMANT_RETURN_IF_FALSE_WITH_ERROR(
                     !parent_attr, "Attribute " + feature_name + " is an attribute of an inherited class.",
                     feature->_line_number, false);
@@ -650,7 +714,7 @@ bool Semant::infer_expression_type(const std::shared_ptr<ast::Expression> &expr,
 // -------------------------------------- Infer Expression Type Helpers --------------------------------------
 std::shared_ptr<ast::Type> Semant::infer_object_type(const ast::ObjectExpression &obj, Scope &scope)
 {
-    const auto expr = scope.find(obj._object);
+    const auto expr = scope.find(obj._symbol);
     SEMANT_RETURN_IF_FALSE_WITH_ERROR(expr, "Undeclared identifier " + obj._object + ".", -1, nullptr);
 
     return expr;
@@ -703,7 +767,7 @@ std::shared_ptr<ast::Type> Semant::infer_let_type(const ast::LetExpression &let,
     }
 
     scope.push_scope();
-    SEMANT_RETURN_IF_FALSE_WITH_ERROR(scope.add_if_can(var_name, var_type) == Scope::AddResult::OK,
+    SEMANT_RETURN_IF_FALSE_WITH_ERROR(scope.add_if_can(let._object->_symbol, var_type) == Scope::AddResult::OK,
                                       "'" + var_name + "' cannot be bound in a 'let' expression.", -1, nullptr);
 
     _expression_stack = let_body_stack;
@@ -866,10 +930,11 @@ std::shared_ptr<ast::Type> Semant::infer_assign_type(const ast::AssignExpression
     const auto &expr_type = assign._expr->_type;
 
     std::shared_ptr<ast::Type> var_type = nullptr;
-    SEMANT_RETURN_IF_FALSE_WITH_ERROR(var_type = scope.find(var_name),
+    SEMANT_RETURN_IF_FALSE_WITH_ERROR(var_type = scope.find(assign._object->_symbol),
                                       "Assignment to undeclared variable " + var_name + ".", -1, nullptr);
 
-    SEMANT_RETURN_IF_FALSE_WITH_ERROR(Scope::can_assign(var_name), "Cannot assign to 'self'.", -1, nullptr);
+    SEMANT_RETURN_IF_FALSE_WITH_ERROR(scope.can_assign(assign._object->_symbol), "Cannot assign to 'self'.", -1,
+                                      nullptr);
     SEMANT_RETURN_IF_FALSE_WITH_ERROR(check_types_meet(expr_type, var_type),
                                       "Type " + expr_type->_string +
                                           " of assigned expression does not conform to declared type " +
@@ -964,7 +1029,7 @@ std::shared_ptr<ast::Type> Semant::infer_cases_type(const ast::CaseExpression &c
                                           "Class " + var_type->_string + " of case branch is undefined.",
                                           kase->_line_number, nullptr);
 
-        SEMANT_RETURN_IF_FALSE_WITH_ERROR(scope.add_if_can(var_name, var_type) == Scope::OK,
+        SEMANT_RETURN_IF_FALSE_WITH_ERROR(scope.add_if_can(kase->_object->_symbol, var_type) == Scope::OK,
                                           "'" + var_name + "' bound in 'case'.", kase->_line_number, nullptr);
 
         // check if we already seen such a branch
@@ -1027,7 +1092,7 @@ std::shared_ptr<ast::Type> Semant::infer_dispatch_type(const ast::DispatchExpres
 
     const auto &method_name = disp._object->_object;
 
-    const auto feature = find_method(method_name, exact_type(dispatch_expr_type), false);
+    const auto feature = find_method(disp._object->_symbol, exact_type(dispatch_expr_type), false);
     SEMANT_RETURN_IF_FALSE_WITH_ERROR(feature, "Dispatch to undefined method " + method_name + ".", -1, nullptr);
     const auto &method = std::get<ast::MethodFeature>(feature->_base);
 
@@ -1066,20 +1131,21 @@ bool Semant::check_types_meet(const std::shared_ptr<ast::Type> &dynamic_type,
         return same_type(dynamic_type, static_type);
     }
 
-    if (same_type(exact_type(dynamic_type), static_type))
+    const auto &exact_dynamic_type = exact_type(dynamic_type);
+    if (same_type(exact_dynamic_type, static_type))
     {
         return true;
     }
 
-    for (const auto &t : _classes.at(static_type->_string)->_children)
+    if (!class_exists(exact_dynamic_type->_symbol))
     {
-        if (check_types_meet(dynamic_type, t->_class->_type))
-        {
-            return true;
-        }
+        return false;
     }
 
-    return false;
+    // subclasses have DFS numbers in the range of the parent
+    const auto &dynamic_node = class_node(exact_dynamic_type);
+    const auto &static_node = class_node(static_type);
+    return static_node->_dfs_num <= dynamic_node->_dfs_num && dynamic_node->_dfs_num <= static_node->_child_max_dfs_num;
 }
 
 std::shared_ptr<ast::Type> Semant::exact_type(const std::shared_ptr<ast::Type> &type) const
@@ -1112,53 +1178,22 @@ std::shared_ptr<ast::Type> Semant::find_common_ancestor(const std::vector<std::s
 std::shared_ptr<ast::Type> Semant::find_common_ancestor_of_two(const std::shared_ptr<ast::Type> &t1,
                                                                const std::shared_ptr<ast::Type> &t2) const
 {
-    auto h1 = 0, h2 = 0;
-
-    auto t1_par = t1;
-    auto t2_par = t2;
-
-    // find depth of the t1
-    while (!same_type(_classes.at(t1_par->_string)->_class->_type, Object))
-    {
-        h1++;
-        t1_par = _classes.at(t1_par->_string)->_class->_parent;
-    }
-
-    // find depth of the t2
-    while (!same_type(_classes.at(t2_par->_string)->_class->_type, Object))
+    // LCA is the least deep class between the first occurrences of the classes in the Euler tour
+    auto l = class_node(t1)->_euler_index;
+    auto r = class_node(t2)->_euler_index;
+    if (l > r)
     {
-        h2++;
-        t2_par = _classes.at(t2_par->_string)->_class->_parent;
+        std::swap(l, r);
     }
 
-    // align subtrees
-    t1_par = t1;
-    t2_par = t2;
-    while (h1 != h2)
-    {
-        if (h1 > h2)
-        {
-            t1_par = _classes.at(t1_par->_string)->_class->_parent;
-            h1--;
-        }
-        else if (h2 > h1)
-        {
-            t2_par = _classes.at(t2_par->_string)->_class->_parent;
-            h2--;
-        }
-    }
-
-    // find lca
-    while (!same_type(t1_par, t2_par))
-    {
-        t1_par = _classes.at(t1_par->_string)->_class->_parent;
-        t2_par = _classes.at(t2_par->_string)->_class->_parent;
-    }
+    const auto k = std::bit_width(static_cast<unsigned>(r - l + 1)) - 1;
+    const auto *const left = _euler_tour[_lca_table[k][l]];
+    const auto *const right = _euler_tour[_lca_table[k][r - (1 << k) + 1]];
 
-    return t1_par;
+    return (left->_depth <= right->_depth ? left : right)->_class->_type;
 }
 
-std::shared_ptr<ast::Feature> Semant::find_method(const std::string &name, const std::shared_ptr<ast::Type> &klass,
+std::shared_ptr<ast::Feature> Semant::find_method(const int &name, const std::shared_ptr<ast::Type> &klass,
                                                   const bool &exact) const
 {
     if (same_type(klass, Empty))
@@ -1168,9 +1203,9 @@ std::shared_ptr<ast::Feature> Semant::find_method(const std::string &name, const
 
     std::shared_ptr<ast::Feature> method;
 
-    for (const auto &m : _classes.at(klass->_string)->_class->_features)
+    for (const auto &m : class_node(klass)->_class->_features)
     {
-        if (std::holds_alternative<ast::MethodFeature>(m->_base) && m->_object->_object == name)
+        if (std::holds_alternative<ast::MethodFeature>(m->_base) && m->_object->_symbol == name)
         {
             method = m;
             break;
@@ -1183,12 +1218,12 @@ std::shared_ptr<ast::Feature> Semant::find_method(const std::string &name, const
     }
 
     // find method in ancestors
-    auto current_class = _classes.at(klass->_string)->_class->_parent;
+    auto current_class = class_node(klass)->_class->_parent;
     while (!same_type(current_class, Empty))
     {
-        for (const auto &m : _classes.at(current_class->_string)->_class->_features)
+        for (const auto &m : class_node(current_class)->_class->_features)
         {
-            if (std::holds_alternative<ast::MethodFeature>(m->_base) && m->_object->_object == name)
+            if (std::holds_alternative<ast::MethodFeature>(m->_base) && m->_object->_symbol == name)
             {
                 method = m;
                 break;
@@ -1199,7 +1234,7 @@ std::shared_ptr<ast::Feature> Semant::find_method(const std::string &name, const
             break;
         }
 
-        current_class = _classes.at(current_class->_string)->_class->_parent;
+        current_class = class_node(current_class)->_class->_parent;
     }
 
     return method;
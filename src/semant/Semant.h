@@ -16,6 +16,12 @@ struct ClassNode
 {
     std::shared_ptr<ast::Class> _class;
     std::vector<std::shared_ptr<ClassNode>> _children;
+
+    // DFS numbering of the hierarchy: numbers of all subclasses are in [_dfs_num, _child_max_dfs_num]
+    int _dfs_num;
+    int _child_max_dfs_num;
+    int _depth;
+    int _euler_index; // first occurrence of this class in the Euler tour of the hierarchy
 };
 
 class Semant
@@ -43,10 +49,30 @@ class Semant
     int _expression_stack; // expression stack slots number for the currently analyzing method/class init
 
     // ----------------------------- Analysis algorithms support -----------------------------
-    std::unordered_map<std::string, std::shared_ptr<ClassNode>> _classes; // fast access to class info
-    std::shared_ptr<ClassNode> _root;                                     // root of classes
+    std::vector<std::shared_ptr<ClassNode>> _classes; // fast access to class info by the symbol of the class name
+    std::shared_ptr<ClassNode> _root;                 // root of classes
+
+    inline bool class_exists(const int &symbol) const { return symbol < _classes.size() && _classes[symbol]; }
+    inline const std::shared_ptr<ClassNode> &class_node(const std::shared_ptr<ast::Type> &type) const
+    {
+        GUARANTEE_DEBUG(class_exists(type->_symbol));
+        return _classes[type->_symbol];
+    }
+    void add_class(const std::shared_ptr<ClassNode> &klass);
+
+    // classes in the order of the Euler tour of the hierarchy and sparse table for LCA queries on it:
+    // _lca_table[k][i] is the position of the least deep class in _euler_tour[i, i + 2^k)
+    std::vector<ClassNode *> _euler_tour;
+    std::vector<std::vector<int>> _lca_table;
+    // number classes and build the sparse table after the hierarchy is checked
+    void index_class_hierarchy();
+    void index_class(ClassNode *node, int &dfs_num, const int &depth);
 
     // ----------------------------- Class checking -----------------------------
+    // create AST nodes for the names
+    static std::shared_ptr<ast::Type> make_type(const std::string_view &name);
+    static std::shared_ptr<ast::ObjectExpression> make_object(const std::string_view &name);
+
     // creates dummy class with methods:
     // methods array: [ ("method1", ["ret_type1", "type1", "type2"]),
     //                  ("method2", ["ret_type2", "type3", "type4"]) ]
@@ -60,8 +86,8 @@ class Semant
     bool check_class_hierarchy();
     bool check_main();
     // class check helpers
-    bool check_class_hierarchy_for_cycle(const std::shared_ptr<ClassNode> &klass,
-                                         std::unordered_map<std::string, int> &visited, const int &loop);
+    bool check_class_hierarchy_for_cycle(const std::shared_ptr<ClassNode> &klass, std::vector<int> &visited,
+                                         const int &loop);
     static bool is_inherit_allowed(const std::shared_ptr<ast::Type> &klass);
 
     // ----------------------------- Expression checking -----------------------------
@@ -105,18 +131,18 @@ class Semant
                           const std::shared_ptr<ast::Type> &static_type) const;
     inline static bool same_type(const std::shared_ptr<ast::Type> &t1, const std::shared_ptr<ast::Type> &t2)
     {
-        return t1->_string == t2->_string;
+        return t1->_symbol == t2->_symbol;
     }
 
     std::shared_ptr<ast::Type> exact_type(const std::shared_ptr<ast::Type> &type) const;
     std::shared_ptr<ast::Type> find_common_ancestor(const std::vector<std::shared_ptr<ast::Type>> &classes) const;
     std::shared_ptr<ast::Type> find_common_ancestor_of_two(const std::shared_ptr<ast::Type> &t1,
                                                            const std::shared_ptr<ast::Type> &t2) const;
-    std::shared_ptr<ast::Feature> find_method(const std::string &name, const std::shared_ptr<ast::Type> &klass,
+    std::shared_ptr<ast::Feature> find_method(const int &name, const std::shared_ptr<ast::Type> &klass,
                                               const bool &exact) const;
     inline bool check_exists(const std::shared_ptr<ast::Type> &type) const
     {
-        return _classes.find(type->_string) != _classes.end() || is_empty_type(type);
+        return class_exists(type->_symbol) || is_empty_type(type);
     }
 
   public:
@@ -1,35 +1,55 @@
 #include "Scope.h"
+#include <algorithm>
 #include <iostream>
 
 using namespace semant;
 
-Scope::Scope(const std::shared_ptr<ast::Type> &self_type)
+Scope::Scope(const std::shared_ptr<ast::Type> &self_type) : _self_symbol(ast::SymbolTable::intern(SelfObject))
 {
-    _symbols.emplace_back();
-    _symbols.back()[SelfObject] = self_type;
+    _scopes.emplace_back();
+    _definitions.resize(_self_symbol + 1);
+
+    _definitions[_self_symbol].push_back({0, self_type});
+    _scopes.back().push_back(_self_symbol);
 }
 
-Scope::AddResult Scope::add_if_can(const std::string &name, const std::shared_ptr<ast::Type> &type)
+Scope::AddResult Scope::add_if_can(const int &symbol, const std::shared_ptr<ast::Type> &type)
 {
-    SEMANT_RETURN_IF_FALSE(name != SelfObject, RESERVED);
+    SEMANT_RETURN_IF_FALSE(symbol != _self_symbol, RESERVED);
+
+    GUARANTEE_DEBUG(_scopes.size() != 0);
+    const int depth = _scopes.size() - 1;
+
+    if (symbol >= _definitions.size())
+    {
+        _definitions.resize(symbol + 1);
+    }
 
-    GUARANTEE_DEBUG(_symbols.size() != 0);
-    SEMANT_RETURN_IF_FALSE(_symbols.back().find(name) == _symbols.back().end(), REDEFINED);
+    auto &definitions = _definitions[symbol];
+    SEMANT_RETURN_IF_FALSE(definitions.empty() || definitions.back().first != depth, REDEFINED);
 
-    _symbols.back()[name] = type;
+    definitions.push_back({depth, type});
+    _scopes.back().push_back(symbol);
     return OK;
 }
 
-std::shared_ptr<ast::Type> Scope::find(const std::string &name, const int &scope_shift) const
+std::shared_ptr<ast::Type> Scope::find(const int &symbol, const int &scope_shift) const
 {
     SEMANT_VERBOSE_ONLY(dump());
 
-    for (auto class_scope = _symbols.rbegin() + scope_shift; class_scope != _symbols.rend(); class_scope++)
+    if (symbol >= _definitions.size())
     {
-        const auto symbol = class_scope->find(name);
-        if (symbol != class_scope->end())
+        return nullptr;
+    }
+
+    // definitions are sorted by depth, so the first suitable one is the innermost
+    const int max_depth = _scopes.size() - 1 - scope_shift;
+    const auto &definitions = _definitions[symbol];
+    for (auto definition = definitions.rbegin(); definition != definitions.rend(); definition++)
+    {
+        if (definition->first <= max_depth)
         {
-            return symbol->second;
+            return definition->second;
         }
     }
 
@@ -39,12 +59,16 @@ std::shared_ptr<ast::Type> Scope::find(const std::string &name, const int &scope
 #ifdef DEBUG
 void Scope::dump() const
 {
-    for (const auto &class_scope : _symbols)
+    for (auto depth = 0; depth < _scopes.size(); depth++)
     {
         std::cout << "--------------------------" << std::endl;
-        for (const auto &symbol : class_scope)
+        for (const auto &symbol : _scopes[depth])
         {
-            std::cout << symbol.first << " = " << symbol.second->_string << std::endl;
+            const auto &definitions = _definitions[symbol];
+            const auto definition = std::find_if(definitions.begin(), definitions.end(),
+                                                 [&depth](const auto &def) { return def.first == depth; });
+
+            std::cout << ast::SymbolTable::name(symbol) << " = " << definition->second->_string << std::endl;
         }
     }
 }
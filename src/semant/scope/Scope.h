@@ -3,7 +3,6 @@
 #include "ast/AST.h"
 #include "decls/Decls.h"
 #include "utils/Utils.h"
-#include <unordered_map>
 
 #define SEMANT_RETURN_IF_FALSE(cond, retval)                                                                           \
     if (!(cond))                                                                                                       \
@@ -17,8 +16,12 @@ namespace semant
 class Scope
 {
   private:
-    std::vector<std::unordered_map<std::string, std::shared_ptr<ast::Type>>>
-        _symbols; // vectors of maps for convenient way to model class scopes
+    // for every symbol: stack of its definitions as pairs (scope depth, type). Indexed by the symbol of the name
+    std::vector<std::vector<std::pair<int, std::shared_ptr<ast::Type>>>> _definitions;
+    // symbols defined in every scope, they are removed from _definitions when scope is popped
+    std::vector<std::vector<int>> _scopes;
+
+    const int _self_symbol;
 
   public:
     /**
@@ -43,7 +46,7 @@ class Scope
      * @brief Start new scope
      *
      */
-    inline void push_scope() { _symbols.emplace_back(); }
+    inline void push_scope() { _scopes.emplace_back(); }
 
     /**
      * @brief Pop current scope
@@ -51,35 +54,39 @@ class Scope
      */
     inline void pop_scope()
     {
-        GUARANTEE_DEBUG(_symbols.size() != 0);
-        _symbols.pop_back();
+        GUARANTEE_DEBUG(_scopes.size() != 0);
+        for (const auto &symbol : _scopes.back())
+        {
+            _definitions[symbol].pop_back();
+        }
+        _scopes.pop_back();
     }
 
     /**
      * @brief Add new element to the current scope
      *
-     * @param name Element name
+     * @param symbol Symbol of the element name
      * @param type Element type
      * @return Status
      */
-    AddResult add_if_can(const std::string &name, const std::shared_ptr<ast::Type> &type);
+    AddResult add_if_can(const int &symbol, const std::shared_ptr<ast::Type> &type);
 
     /**
      * @brief Check if assignment for given element is prohibited
      *
-     * @param name Element name
+     * @param symbol Symbol of the element name
      * @return True if assignment is allowed
      */
-    inline static bool can_assign(const std::string &name) { return name != SelfObject; }
+    inline bool can_assign(const int &symbol) const { return symbol != _self_symbol; }
 
     /**
      * @brief Find element in the scope
      *
-     * @param name Element for lookup
+     * @param symbol Symbol of the element for lookup
      * @param scope_shift Start lookup from previous scope_shift scopes
      * @return Type of the element
      */
-    std::shared_ptr<ast::Type> find(const std::string &name, const int &scope_shift = 0) const;
+    std::shared_ptr<ast::Type> find(const int &symbol, const int &scope_shift = 0) const;
 
 #ifdef DEBUG
     /**
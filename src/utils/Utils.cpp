@@ -1,6 +1,12 @@
 #include "utils/Utils.h"
+#include "utils/timer/PhaseTimer.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
 #include <cstring>
 #include <iomanip>
+#include <iostream>
+#include <string_view>
 #include <unordered_map>
 
 #ifdef DEBUG
@@ -60,6 +66,14 @@ bool VerifyOops = true;
 #ifdef LLVM
 bool UseArchSpecFeatures = true;
 bool DoOpts = true;
+int OptLevel = 2;
+int CodeGenThreads = 1;
+std::string ObjectCacheDir;
+bool StaticRuntime = false;
+bool RunInJit = false;
+std::vector<std::string> ProgramArgs;
+bool ProfileGenerate = false;
+std::string ProfileUseFile;
 
 #ifdef LLVM_SHADOW_STACK
 bool ReduceGCSpills = true;
@@ -68,6 +82,8 @@ bool ReduceGCSpills = true;
 #endif // LLVM
 
 #ifdef MYIR
+bool UseLLVMBackend = false;
+
 #ifdef DEBUG
 bool PrintDominanceInfo = false;
 bool TraceSSAConstruction = false;
@@ -96,7 +112,8 @@ std::unordered_map<std::string, bool *> BoolFlags = {
         ,
 #endif // DEBUG
     flag_pair(UseArchSpecFeatures),
-    flag_pair(DoOpts)
+    flag_pair(DoOpts),
+    flag_pair(StaticRuntime)
 #ifdef LLVM_SHADOW_STACK
         ,
     flag_pair(ReduceGCSpills)
@@ -104,6 +121,10 @@ std::unordered_map<std::string, bool *> BoolFlags = {
 #endif // LLVM
 
 #ifdef MYIR
+#ifdef DEBUG
+        ,
+#endif // DEBUG
+    flag_pair(UseLLVMBackend)
 #ifdef DEBUG
         ,
     flag_pair(PrintDominanceInfo),
@@ -132,6 +153,15 @@ std::pair<std::vector<int>, std::string> process_args(char *const args[], const
     std::vector<int> positions;
     for (int i = 1; i < args_num; i++)
     {
+#ifdef LLVM
+        // coolc --run <file.cl>... [flags] -- [program args]: everything after "--" is passed to the program
+        if (!strcmp(args[i], "--"))
+        {
+            ProgramArgs.assign(args + i + 1, args + args_num);
+            break;
+        }
+#endif // LLVM
+
         if (args[i][0] == '-' || args[i][0] == '+')
         {
             if (maybe_set(args[i]))
@@ -139,6 +169,13 @@ std::pair<std::vector<int>, std::string> process_args(char *const args[], const
                 continue;
             }
 
+            // report time and memory of the compiler phases: -time-phases, -time-phases=json
+            if (!strcmp(args[i], "-time-phases") || !strcmp(args[i], "-time-phases=json"))
+            {
+                TimePhases = true;
+                TimePhasesJSON = args[i][12] == '=';
+            }
+
             // output file name
             if (!strcmp(args[i], "-o"))
             {
@@ -148,6 +185,50 @@ std::pair<std::vector<int>, std::string> process_args(char *const args[], const
                     out_file_name = args[++i];
                 }
             }
+
+#ifdef LLVM
+            // optimization level: -O0, -O1, -O2, -O3
+            if (args[i][0] == '-' && args[i][1] == 'O' && args[i][2] >= '0' && args[i][2] <= '3' && !args[i][3])
+            {
+                OptLevel = args[i][2] - '0';
+            }
+
+            // number of threads for machine code generation: -j<N>
+            if (args[i][0] == '-' && args[i][1] == 'j' && isdigit(args[i][2]))
+            {
+                CodeGenThreads = std::max(atoi(args[i] + 2), 1);
+            }
+
+            // directory for object files of unchanged classes: -cache-dir <dir>
+            if (!strcmp(args[i], "-cache-dir"))
+            {
+                if (i + 1 < args_num)
+                {
+                    ObjectCacheDir = args[++i];
+                }
+            }
+
+            // instrument the program to collect the profile: -profile-generate
+            if (!strcmp(args[i], "-profile-generate"))
+            {
+                ProfileGenerate = true;
+            }
+
+            // optimize the program using the collected profile: -profile-use <file>
+            if (!strcmp(args[i], "-profile-use"))
+            {
+                if (i + 1 < args_num)
+                {
+                    ProfileUseFile = args[++i];
+                }
+            }
+
+            // compile in memory and run the program: --run
+            if (!strcmp(args[i], "--run"))
+            {
+                RunInJit = true;
+            }
+#endif // LLVM
         }
         else
         {
@@ -155,11 +236,27 @@ std::pair<std::vector<int>, std::string> process_args(char *const args[], const
         }
     }
 
+    if (positions.empty())
+    {
+        std::cerr << "usage: coolc [flags] <file.cl>... [-o <executable>]" << std::endl;
+#ifdef LLVM
+        std::cerr << "       coolc --run [flags] <file.cl>... [-- <program args>]" << std::endl;
+#endif // LLVM
+        exit(-1);
+    }
+
     if (!found_out_file_name)
     {
         out_file_name = args[positions[0]];
         out_file_name = out_file_name.substr(0, out_file_name.find_last_of("."));
     }
 
+#ifdef LLVM
+    if (RunInJit)
+    {
+        ProgramArgs.insert(ProgramArgs.begin(), out_file_name); // argv[0]
+    }
+#endif // LLVM
+
     return {positions, out_file_name};
 }
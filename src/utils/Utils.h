@@ -6,6 +6,14 @@
 #ifdef LLVM
 extern bool UseArchSpecFeatures;
 extern bool DoOpts;
+extern int OptLevel;
+extern int CodeGenThreads;
+extern std::string ObjectCacheDir;
+extern bool StaticRuntime;
+extern bool RunInJit;
+extern std::vector<std::string> ProgramArgs;
+extern bool ProfileGenerate;
+extern std::string ProfileUseFile;
 
 #ifdef LLVM_SHADOW_STACK
 extern bool ReduceGCSpills;
@@ -13,6 +21,10 @@ extern bool ReduceGCSpills;
 
 #endif // LLVM
 
+#ifdef MYIR
+extern bool UseLLVMBackend;
+#endif // MYIR
+
 /**
  * @brief Process command line arguments
  *
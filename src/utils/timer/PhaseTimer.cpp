@@ -0,0 +1,147 @@
+#include "utils/timer/PhaseTimer.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sys/resource.h>
+
+bool TimePhases = false;
+bool TimePhasesJSON = false;
+
+std::vector<PhaseTimer::Phase> PhaseTimer::Phases;
+std::vector<PhaseTimer::Report> PhaseTimer::Reports;
+int PhaseTimer::Depth = 0;
+
+namespace
+{
+
+double wall_time()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+rusage usage()
+{
+    rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru;
+}
+
+double cpu_time(const rusage &ru)
+{
+    return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+}
+
+long peak_rss_kb(const rusage &ru)
+{
+#ifdef __APPLE__
+    return ru.ru_maxrss / 1024; // bytes on MacOS
+#else
+    return ru.ru_maxrss;
+#endif // __APPLE__
+}
+
+std::string json_string(const std::string &str)
+{
+    std::string result = "\"";
+    for (const auto &c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            result += '\\';
+        }
+        result += c;
+    }
+
+    return result + "\"";
+}
+
+} // namespace
+
+PhaseTimer::PhaseTimer(const std::string &name) : _index(-1), _wall_start(0), _cpu_start(0)
+{
+    if (!TimePhases)
+    {
+        return;
+    }
+
+    // phases are listed in order of start, so subphases follow their parent
+    _index = Phases.size();
+    Phases.push_back({name, Depth++, 0, 0, 0});
+
+    _wall_start = wall_time();
+    _cpu_start = cpu_time(usage());
+}
+
+PhaseTimer::~PhaseTimer()
+{
+    if (_index < 0)
+    {
+        return;
+    }
+
+    const auto ru = usage();
+
+    auto &phase = Phases[_index];
+    phase._wall = wall_time() - _wall_start;
+    phase._cpu = cpu_time(ru) - _cpu_start;
+    phase._peak_rss_kb = peak_rss_kb(ru);
+
+    Depth--;
+}
+
+void PhaseTimer::add_report(const std::string &name, const std::string &text)
+{
+    if (TimePhases)
+    {
+        Reports.push_back({name, text});
+    }
+}
+
+void PhaseTimer::print()
+{
+    if (!TimePhases)
+    {
+        return;
+    }
+
+    if (TimePhasesJSON)
+    {
+        std::cerr << "{\"phases\": [";
+        for (auto i = 0; i < Phases.size(); i++)
+        {
+            const auto &phase = Phases[i];
+            std::cerr << (i ? ", " : "") << "{\"name\": " << json_string(phase._name) << ", \"depth\": " << phase._depth
+                      << ", \"wall\": " << phase._wall << ", \"cpu\": " << phase._cpu
+                      << ", \"peak_rss_kb\": " << phase._peak_rss_kb << "}";
+        }
+        std::cerr << "]";
+
+        for (const auto &report : Reports)
+        {
+            std::cerr << ", " << json_string(report._name) << ": " << report._text;
+        }
+        std::cerr << "}" << std::endl;
+
+        return;
+    }
+
+    constexpr int name_width = 32;
+    constexpr int value_width = 15;
+    constexpr int ident_size = 2;
+
+    std::cerr << "===" << std::string(name_width + 3 * value_width - 6, '-') << "===" << std::endl;
+    std::cerr << std::left << std::setw(name_width) << "Phase" << std::right << std::setw(value_width) << "Wall (s)"
+              << std::setw(value_width) << "CPU (s)" << std::setw(value_width) << "Peak RSS (KB)" << std::endl;
+    for (const auto &phase : Phases)
+    {
+        std::cerr << std::left << std::setw(name_width) << std::string(phase._depth * ident_size, ' ') + phase._name
+                  << std::right << std::fixed << std::setprecision(4) << std::setw(value_width) << phase._wall
+                  << std::setw(value_width) << phase._cpu << std::setw(value_width) << phase._peak_rss_kb
+                  << std::endl;
+    }
+
+    for (const auto &report : Reports)
+    {
+        std::cerr << report._text;
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+extern bool TimePhases;
+extern bool TimePhasesJSON;
+
+/**
+ * @brief Measure wall time, CPU time and peak RSS of the compiler phase
+ *
+ * @details
+ * Timer starts on construction and stops on destruction. Phases can be nested: the phase that starts while another
+ * one is running is its subphase. CPU time is the time of the whole process, so it includes worker threads of the
+ * phase. Does nothing if -time-phases was not passed.
+ */
+class PhaseTimer
+{
+  private:
+    struct Phase
+    {
+        std::string _name;
+        int _depth;
+        double _wall;
+        double _cpu;
+        long _peak_rss_kb;
+    };
+
+    struct Report
+    {
+        std::string _name;
+        std::string _text;
+    };
+
+    static std::vector<Phase> Phases;
+    static std::vector<Report> Reports;
+    static int Depth;
+
+    int _index;
+    double _wall_start;
+    double _cpu_start;
+
+  public:
+    /**
+     * @brief Start the phase
+     *
+     * @param name Name of the phase
+     */
+    explicit PhaseTimer(const std::string &name);
+
+    /**
+     * @brief Stop the phase
+     */
+    ~PhaseTimer();
+
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+    /**
+     * @brief Attach a report of the external tool to the phases report
+     *
+     * @param name Name of the report
+     * @param text Report. Plain text or JSON object depending on -time-phases format
+     */
+    static void add_report(const std::string &name, const std::string &text);
+
+    /**
+     * @brief Print all phases and reports to stderr
+     */
+    static void print();
+};
@@ -0,0 +1,41 @@
+#!/bin/bash
+
+# -profile-use reports a missing or corrupted profile and exits without a crash, instrumented program overwrites it
+COOLC=$1/coolc
+PROGRAM=$2/fibo.cl
+OUT_DIR=$(mktemp -d)
+trap "rm -rf $OUT_DIR" EXIT
+
+check() {
+    $COOLC $PROGRAM -profile-use $1 -o $OUT_DIR/fibo &> $OUT_DIR/log
+    local status=$?
+
+    # exit(-1) of the compiler, not a crash
+    if [ $status -ne 255 ] || ! grep -q "Can't read profile $1!" $OUT_DIR/log; then
+        echo "$2: exit status $status"
+        cat $OUT_DIR/log
+        exit 1
+    fi
+}
+
+check $OUT_DIR/missing.profile "missing profile"
+
+echo "Main.main 2 1" > $OUT_DIR/truncated.profile
+check $OUT_DIR/truncated.profile "truncated profile"
+
+echo "Main.main x 1" > $OUT_DIR/corrupted.profile
+check $OUT_DIR/corrupted.profile "corrupted profile"
+
+head -c 64 $COOLC > $OUT_DIR/binary.profile
+check $OUT_DIR/binary.profile "binary profile"
+
+# instrumented program drops a corrupted profile of the previous runs and writes its own counts
+$COOLC $PROGRAM -profile-generate -o $OUT_DIR/fibo-gen &> $OUT_DIR/log || { cat $OUT_DIR/log; exit 1; }
+echo "Main.main 1000000000000" > $OUT_DIR/runtime.profile
+LD_LIBRARY_PATH=$1 $OUT_DIR/fibo-gen ProfileFile=$OUT_DIR/runtime.profile &> $OUT_DIR/log
+if [ $? -ne 0 ] || ! grep -q "counts of the previous runs are dropped!" $OUT_DIR/log ||
+    ! $COOLC $PROGRAM -profile-use $OUT_DIR/runtime.profile -o $OUT_DIR/fibo &> $OUT_DIR/log; then
+    echo "corrupted profile of the previous runs"
+    cat $OUT_DIR/log
+    exit 1
+fi
@@ -0,0 +1,5 @@
+#!/bin/bash
+
+# the same as run.sh, but the program is compiled in memory and run with ORC JIT. Flags after the source file
+# are for the compiler, arguments after "--" are for the program
+$1/coolc --run $2/$5.cl -O3 -- GCAlgo=$6 MaxHeapSize=$7 &> $3
@@ -0,0 +1,28 @@
+#!/bin/bash
+
+# profile-guided build of the program: the instrumented program runs twice and the second run has to double the
+# counts of the first one, then the program is compiled with the profile and its output is the result
+PROFILE=$4/$5.profile
+rm -f $PROFILE
+
+$1/coolc $2/$5.cl -profile-generate -o $4/$5-gen
+for i in 1 2; do
+    LD_LIBRARY_PATH=$1 $4/$5-gen GCAlgo=$6 MaxHeapSize=$7 ProfileFile=$PROFILE &> /dev/null
+    cp $PROFILE $PROFILE.$i 2> /dev/null
+done
+
+if [ ! -s $PROFILE.1 ]; then
+    echo "profile is not written" > $3
+    exit
+fi
+
+# lines of both profiles are "<function> <counters num> <counters>..."
+if ! awk 'NR == FNR { first[$1] = $0; next }
+          { n = split(first[$1], f); if (n != NF) exit 1; for (i = 3; i <= NF; i++) if ($i != 2 * f[i]) exit 1 }' \
+    $PROFILE.1 $PROFILE.2; then
+    echo "counts of the second run are not accumulated" > $3
+    exit
+fi
+
+$1/coolc $2/$5.cl -profile-use $PROFILE -o $4/$5
+LD_LIBRARY_PATH=$1 $4/$5 GCAlgo=$6 MaxHeapSize=$7 &> $3
@@ -14,7 +14,7 @@ cd tests/
 
 for file in *.cl; do
     filename=${file%.*}
-    $1/coolc $file -o $TEST_DIR/out/$filename
+    $1/coolc $file $5 -o $TEST_DIR/out/$filename
     $2 $1 $TEST_DIR/tests/ $TEST_DIR/results/$file.result $TEST_DIR/out/ $filename $3 $4
 done;
 
@@ -0,0 +1,62 @@
+Object-init 1 38
+IO-init 1 8
+Int-init 1 2
+Bool-init 1 2
+String-init 1 0
+P-init 1 8
+C1-init 1 2
+C2-init 1 4
+C2_getX.unboxed 1 4
+C2_setX.unboxed 1 2
+Blah-init 1 6
+Blah_tiny.unboxed 1 10
+Blah_add.unboxed 1 8
+Blah_compare.unboxed 1 2
+Blah_compareEq.unboxed 1 2
+Blah_isv.unboxed 1 2
+Blah_divByZero.unboxed 1 0
+Blah_cmp.unboxed 1 6
+Blah_ng.unboxed 1 2
+Blah_caller.unboxed 1 2
+Blah_callee.unboxed 1 6
+Blah_get_t 1 2
+Blah_useLet.unboxed 1 2
+Blah_useIf.unboxed 3 2 0 2
+Blah_useWhile 3 2 0 2
+Blah_useCase.unboxed 2 2 2
+Blah_useNew 1 2
+Blah_doThemAll.unboxed 1 2
+Blah_bigIf.unboxed 17 2 2 0 0 2 0 2 0 2 2 0 2 0 0 2 2 0
+Blah_bigWhile 13 2 48 2 0 2 0 2 20 2 200 20 2000 200
+Blah_bail.unboxed 1 0
+Blah_bigMath 23 2 2 0 2 0 2 0 2 0 2 0 2 0 2 0 2 0 2 0 2 0 2 0
+Blah_assert.unboxed 3 126 126 0
+Blah_bigAssign 1 2
+Blah_setI.unboxed 1 8
+Blah_getI.unboxed 1 8
+Blah_bigSelf 1 2
+Blah_bigStrCompare 1 2
+Blah_bigCase 141 2 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 2 2
+Blah_bigAttrAccess 1 2
+A-init 1 8
+A_e.unboxed 1 0
+A_f.unboxed 1 0
+A_g.unboxed 1 0
+A_i.unboxed 1 0
+A_j.unboxed 1 0
+B-init 1 6
+B_e.unboxed 1 0
+B_g.unboxed 1 0
+B_h.unboxed 1 0
+B_k.unboxed 1 0
+C-init 1 4
+C_e.unboxed 1 0
+C_h.unboxed 1 0
+C_i.unboxed 1 0
+C_ell.unboxed 1 0
+Base-init 1 0
+Grandparent-init 1 0
+Parent-init 1 0
+Child-init 1 0
+Main-init 1 4
+Main_main 1 2
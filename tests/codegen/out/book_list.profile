@@ -0,0 +1,28 @@
+Object-init 1 12
+IO-init 1 10
+Book-init 1 4
+Book_initBook 1 4
+Book_print 1 4
+Article-init 1 2
+Article_initArticle 1 2
+Article_print 1 2
+BookList-init 1 6
+BookList_isNil.unboxed 1 0
+BookList_cons 1 4
+BookList_car 1 0
+BookList_cdr 1 0
+BookList_print_list 1 0
+Cons-init 1 4
+Cons_isNil.unboxed 1 0
+Cons_init 1 4
+Cons_car 1 0
+Cons_cdr 1 0
+Cons_print_list 8 2 2 2 2 2 0 2 2
+Nil-init 1 2
+Nil_isNil.unboxed 1 0
+Nil_print_list 1 2
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+Main-init 1 2
+Main_main 4 2 0 2 0
@@ -0,0 +1,7 @@
+Object-init 1 4
+IO-init 1 2
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+Main-init 1 2
+Main_main 1 2
@@ -0,0 +1,50 @@
+Object-init 1 50
+IO-init 1 48
+EvalObject-init 1 48
+EvalObject_eval 1 0
+Closure-init 1 48
+Closure_get_parent 1 10
+Closure_get_x 1 16
+Closure_init 1 30
+Closure_apply 1 0
+Closure8-init 1 2
+Closure8_apply 1 0
+Closure7-init 1 2
+Closure7_apply 1 2
+Closure9-init 1 2
+Closure9_apply 1 0
+Closure6-init 1 2
+Closure6_apply 1 2
+Closure5-init 1 2
+Closure5_apply 1 2
+Closure10-init 1 2
+Closure10_apply 1 0
+Closure11-init 1 0
+Closure11_apply 118 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0
+Closure4-init 1 2
+Closure4_apply 1 2
+Closure12-init 1 2
+Closure12_apply 1 2
+Closure3-init 1 2
+Closure3_apply 1 0
+Closure13-init 1 0
+Closure13_apply 1 0
+Closure14-init 1 0
+Closure14_apply 118 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0
+Closure2-init 1 2
+Closure2_apply 1 2
+Closure15-init 1 2
+Closure15_apply 1 2
+Closure16-init 1 2
+Closure16_apply 118 2 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0
+Closure1-init 1 2
+Closure1_apply 1 2
+Closure17-init 1 2
+Closure17_apply 1 2
+Closure0-init 1 2
+Closure0_apply 1 2
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+Main-init 1 2
+Main_main 313 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 2 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0
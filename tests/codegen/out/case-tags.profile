@@ -0,0 +1,16 @@
+Object-init 1 30
+IO-init 1 4
+Main-init 1 4
+Main_classify 14 22 0 0 2 2 2 2 2 2 2 2 2 2 2
+Main_classify_a 7 12 2 2 2 2 2 2
+Main_main 1 2
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+A-init 1 24
+B-init 1 8
+C-init 1 4
+D-init 1 12
+E-init 1 8
+F-init 1 4
+G-init 1 2
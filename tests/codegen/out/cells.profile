@@ -0,0 +1,16 @@
+Object-init 1 4
+IO-init 1 2
+CellularAutomaton-init 1 2
+CellularAutomaton_init 1 2
+CellularAutomaton_print 1 42
+CellularAutomaton_num_cells.unboxed 1 840
+CellularAutomaton_cell.unboxed 1 2280
+CellularAutomaton_cell_left_neighbor.unboxed 3 760 40 720
+CellularAutomaton_cell_right_neighbor.unboxed 3 760 40 720
+CellularAutomaton_cell_at_next_evolution.unboxed 9 760 200 560 200 560 200 560 202 558
+CellularAutomaton_evolve 3 40 760 40
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+Main-init 1 2
+Main_main 3 2 40 2
@@ -0,0 +1,12 @@
+Object-init 1 4
+IO-init 1 2
+Base-init 1 2
+Base_identify 1 0
+Base_duplicate 1 2
+Derived-init 1 2
+Derived_identify 1 2
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+Main-init 1 2
+Main_main 3 2 0 2
@@ -0,0 +1,12 @@
+Object-init 1 4
+IO-init 1 2
+Base-init 3 2 0 2
+Base_report.unboxed 1 8
+Base_duplicate 1 2
+Derived-init 1 2
+Derived_report.unboxed 1 8
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+Main-init 1 2
+Main_main 3 2 0 2
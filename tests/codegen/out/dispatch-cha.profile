@@ -0,0 +1,23 @@
+Object-init 1 22
+IO-init 1 22
+A-init 1 20
+A_name 1 6
+A_mono.unboxed 1 12
+A_many 1 4
+A_report 13 12 2 2 2 2 2 2 2 2 2 2 2 2
+B-init 1 8
+B_many 1 6
+E-init 1 6
+E_name 1 4
+C-init 1 10
+C_name 1 10
+C_many 1 6
+D-init 1 4
+D_many 1 4
+F-init 1 4
+Main-init 1 2
+Main_visit 1 12
+Main_main 9 2 0 0 2 0 2 0 0 2
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
@@ -0,0 +1,15 @@
+Object-init 1 16
+IO-init 1 16
+Node-init 1 12
+Node_link 1 2
+Node_get 1 4
+Node_fresh 1 6
+Node_show 1 10
+Holder-init 1 2
+Holder_peek 3 2 2 0
+Holder_second 1 2
+Main-init 1 2
+Main_main 4 2 2 2 0
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
@@ -0,0 +1,8 @@
+Object-init 1 8
+IO-init 1 2
+Main-init 1 2
+Main_exp.unboxed 5 30 6 24 10 14
+Main_main 1 2
+Int-init 1 6
+Bool-init 1 0
+String-init 1 0
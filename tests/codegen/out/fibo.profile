@@ -0,0 +1,8 @@
+Object-init 1 4
+IO-init 1 2
+Main-init 1 2
+Main_fibo.unboxed 5 3946 754 3192 1220 1972
+Main_main 1 2
+Int-init 1 2
+Bool-init 1 0
+String-init 1 0
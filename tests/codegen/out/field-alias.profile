@@ -0,0 +1,15 @@
+Object-init 1 6
+IO-init 1 2
+Main-init 1 2
+Main_main 8 2 10 2 0 4 6 2 8
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+Counter-init 1 4
+Counter_inc.unboxed 1 14
+Counter_count.unboxed 1 20
+Pair-init 1 4
+Pair_bump.unboxed 3 10 10 0
+Pair_other.unboxed 1 2
+Twice-init 1 2
+Twice_inc.unboxed 1 6
@@ -0,0 +1,14 @@
+Object-init 1 50
+IO-init 1 48
+Bazz-init 5 48 2 4 10 32
+Bazz_printh.unboxed 1 168
+Bazz_doh.unboxed 1 42
+Foo-init 4 46 4 10 32
+Foo_doh.unboxed 1 296
+Razz-init 3 42 10 32
+Bar-init 1 32
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+Main-init 1 2
+Main_main 1 2
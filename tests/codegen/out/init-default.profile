@@ -0,0 +1,9 @@
+Object-init 1 6
+IO-init 1 2
+A-init 3 2 0 2
+A_print_attr 3 2 2 0
+Int-init 1 2
+Bool-init 1 0
+String-init 1 0
+Main-init 1 2
+Main_main 1 2
@@ -0,0 +1,9 @@
+Object-init 1 2
+IO-init 1 2
+Base-init 1 2
+Base_recite.unboxed 1 10
+Main-init 1 2
+Main_main 1 2
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
@@ -0,0 +1,77 @@
+Object-init 1 572
+IO-init 1 474
+VarList-init 1 90
+VarList_isNil.unboxed 1 42
+VarList_head 1 0
+VarList_tail 1 0
+VarList_add 1 82
+VarList_print 1 0
+VarListNE-init 1 82
+VarListNE_isNil.unboxed 1 262
+VarListNE_head 1 138
+VarListNE_tail 1 54
+VarListNE_init 1 82
+VarListNE_print 3 0 0 0
+Expr-init 1 382
+Expr_print_self 1 0
+Expr_beta 1 0
+Expr_substitute 1 0
+Expr_gen_code 1 0
+Variable-init 1 116
+Variable_init 1 116
+Variable_print_self 1 326
+Variable_beta 1 0
+Variable_substitute 3 32 12 20
+Variable_gen_code 15 84 0 138 0 138 0 138 54 84 0 54 0 84 0 84
+Lambda-init 1 140
+Lambda_init 1 140
+Lambda_print_self 5 166 0 78 66 22
+Lambda_beta 1 4
+Lambda_apply 5 14 0 0 12 2
+Lambda_substitute 7 24 0 24 0 14 6 4
+Lambda_gen_code 5 82 42 40 42 40
+Lambda_gen_closure_code.unboxed 5 82 0 28 40 14
+App-init 1 126
+App_init 1 126
+App_print_self 9 128 0 38 38 52 0 44 52 32
+App_beta 9 24 0 0 14 10 0 0 0 10
+App_substitute 9 18 0 6 6 6 0 12 0 6
+App_gen_code 9 76 0 28 14 34 0 28 28 20
+Term-init 1 2
+Term_var 1 116
+Term_lam 1 116
+Term_app 1 98
+Term_i 1 26
+Term_k 1 18
+Term_s 1 18
+Main-init 1 2
+Main_beta_reduce 17 4 0 0 0 4 18 4 0 0 4 14 4 14 0 0 4 10
+Main_eval_class 1 8
+Main_closure_class 1 8
+Main_gen_code 11 8 0 0 0 8 0 0 0 8 82 8
+Main_main.unboxed 13 2 0 0 2 0 0 0 2 0 0 0 2 0
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+LambdaList-init 1 90
+LambdaList_isNil.unboxed 1 8
+LambdaList_headE 1 0
+LambdaList_headC 1 0
+LambdaList_headN.unboxed 1 0
+LambdaList_tail 1 0
+LambdaList_add.unboxed 1 82
+LambdaListNE-init 1 82
+LambdaListNE_isNil.unboxed 1 82
+LambdaListNE_headE 1 82
+LambdaListNE_headC 1 82
+LambdaListNE_headN.unboxed 1 82
+LambdaListNE_tail 1 82
+LambdaListNE_init.unboxed 1 82
+LambdaListRef-init 1 8
+LambdaListRef_isNil.unboxed 3 90 8 82
+LambdaListRef_headE 3 82 0 82
+LambdaListRef_headC 3 82 0 82
+LambdaListRef_headN.unboxed 3 82 0 82
+LambdaListRef_reset 1 8
+LambdaListRef_add.unboxed 1 82
+LambdaListRef_removeHead 3 82 0 82
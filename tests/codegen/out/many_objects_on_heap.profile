@@ -0,0 +1,7 @@
+Object-init 1 402
+IO-init 1 202
+Main-init 1 2
+Main_main 3 2 200 2
+Int-init 1 200
+Bool-init 1 0
+String-init 1 0
@@ -0,0 +1,12 @@
+Object-init 1 4
+IO-init 1 4
+A-init 1 2
+A_f.unboxed 1 2
+A_g.unboxed 1 4
+B-init 1 2
+B_f.unboxed 1 2
+Main-init 1 2
+Main_main 1 2
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
@@ -0,0 +1,12 @@
+Object-init 1 6
+IO-init 1 4
+Base-init 1 4
+Base_identify 1 0
+Base_duplicate 1 2
+Derived-init 1 4
+Derived_identify 1 2
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+Main-init 1 2
+Main_main 3 2 0 2
@@ -0,0 +1,12 @@
+Object-init 1 6
+IO-init 1 4
+Base-init 3 4 0 4
+Base_report.unboxed 1 12
+Base_duplicate 1 2
+Derived-init 1 4
+Derived_report.unboxed 1 12
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+Main-init 1 2
+Main_main 3 2 0 2
@@ -0,0 +1,11 @@
+Object-init 1 30
+IO-init 1 24
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+A-init 1 4
+A_printX 1 8
+A_new_st 1 2
+A_bump 1 6
+Main-init 1 2
+Main_main 1 2
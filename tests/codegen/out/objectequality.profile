@@ -0,0 +1,10 @@
+Object-init 1 10
+IO-init 1 0
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+A-init 1 8
+A_foo.unboxed 1 2
+B-init 1 4
+Main-init 1 2
+Main_main 13 2 2 0 0 2 0 2 2 0 2 0 2 0
@@ -0,0 +1,11 @@
+Object-init 1 8
+IO-init 1 6
+Base-init 1 6
+Base_identify 3 8 2 6
+Derived-init 1 4
+Derived_out_string 1 6
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+Main-init 1 2
+Main_main 1 2
@@ -0,0 +1,17 @@
+Object-init 1 16
+IO-init 1 2
+Main-init 1 2
+Main_main 37 2 2 0 0 0 2 0 0 0 2 0 0 2 0 0 2 0 2 0 0 2 0 0 0 2 0 0 0 2 0 0 2 0 0 2 0 2
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+A-init 1 14
+A_f.unboxed 1 12
+A_g.unboxed 1 6
+B-init 1 12
+B_g.unboxed 1 12
+C-init 1 8
+C_f.unboxed 1 6
+D-init 1 4
+D_f.unboxed 1 4
+D_g.unboxed 1 4
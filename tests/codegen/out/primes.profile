@@ -0,0 +1,7 @@
+Object-init 1 748
+IO-init 1 2
+Main-init 13 2 996 0 188 4226 808 3418 3418 996 188 808 2 994
+Main_main.unboxed 1 0
+Int-init 1 746
+Bool-init 1 0
+String-init 1 0
@@ -0,0 +1,13 @@
+Object-init 1 12
+IO-init 1 4
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+P-init 1 6
+P_foo 1 0
+P_badGuy 3 2 0 2
+C-init 1 6
+C_foo 1 4
+Main-init 1 2
+Main_f1 5 2 0 2 0 2
+Main_main 1 2
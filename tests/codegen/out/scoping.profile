@@ -0,0 +1,10 @@
+Object-init 1 2
+IO-init 1 2
+Bob-init 1 2
+Main-init 1 2
+Main_jack.unboxed 1 2
+Main_print_z.unboxed 1 6
+Main_main 1 2
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
@@ -0,0 +1,13 @@
+Object-init 1 6
+IO-init 1 2
+Main-init 1 2
+Main_main 3 2 0 2
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+A-init 1 4
+A_init 1 2
+A_foo.unboxed 1 0
+A_getx 1 2
+B-init 1 4
+B_foo.unboxed 1 2
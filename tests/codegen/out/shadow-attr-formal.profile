@@ -0,0 +1,8 @@
+Object-init 1 2
+IO-init 1 2
+Main-init 1 2
+Main_method 1 2
+Main_main 1 2
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
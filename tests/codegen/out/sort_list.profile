@@ -0,0 +1,35 @@
+Object-init 1 504
+IO-init 1 504
+List-init 1 502
+List_isNil.unboxed 1 0
+List_cons.unboxed 1 0
+List_car.unboxed 1 0
+List_cdr 1 0
+List_rev 4 0 0 0 0
+List_sort 4 0 0 0 0
+List_insert.unboxed 4 0 0 0 0
+List_rcons.unboxed 4 0 0 0 0
+List_print_list 1 0
+Cons-init 1 500
+Cons_isNil.unboxed 1 0
+Cons_init.unboxed 1 500
+Cons_car.unboxed 1 0
+Cons_cdr 1 0
+Cons_rev 7 40 0 38 2 0 38 2
+Cons_sort 7 40 0 38 2 0 38 2
+Cons_insert.unboxed 6 38 38 0 0 0 0
+Cons_rcons.unboxed 4 380 0 342 38
+Cons_print_list 4 2 0 38 2
+Nil-init 1 2
+Nil_isNil.unboxed 1 0
+Nil_rev 1 2
+Nil_sort 1 2
+Nil_insert.unboxed 1 2
+Nil_rcons.unboxed 1 42
+Nil_print_list 1 2
+Main-init 1 2
+Main_iota.unboxed 3 2 40 2
+Main_main 10 2 0 2 0 0 2 0 0 2 0
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
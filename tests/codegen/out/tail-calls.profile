@@ -0,0 +1,15 @@
+Object-init 1 999886
+IO-init 1 2
+Main-init 1 2
+Main_count.unboxed 3 2 2 2000000
+Main_count_let.unboxed 3 2 2 2000000
+Main_count_case.unboxed 10 2 2 2000000 0 0 0 1000000 0 1000000 0
+Main_count_block.unboxed 3 2 2 2000000
+Main_depth.unboxed 3 202 2 200
+Main_main 1 2
+Int-init 1 999880
+Bool-init 1 0
+String-init 1 0
+Node-init 1 4
+Node_init.unboxed 1 4
+Node_walk.unboxed 3 2 2 22
@@ -0,0 +1,11 @@
+Object-init 1 12
+IO-init 1 8
+Base-init 1 8
+Base_identify 1 10
+Base_test 1 2
+Derived-init 1 6
+Int-init 1 0
+Bool-init 1 0
+String-init 1 0
+Main-init 1 4
+Main_main 1 2
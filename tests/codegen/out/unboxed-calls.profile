@@ -0,0 +1,15 @@
+Object-init 1 18
+IO-init 1 2
+Main-init 1 2
+Main_print.unboxed 1 14
+Main_main 29 2 2 0 0 2 2 0 0 2 2 0 0 0 0 2 0 0 0 0 0 0 0 0 2 0 0 0 0 2
+Int-init 1 12
+Bool-init 1 0
+String-init 1 0
+Math-init 1 4
+Math_fact.unboxed 3 22 2 20
+Math_fib.unboxed 3 44712 22358 22354
+Math_even.unboxed 3 46 6 40
+Math_scale.unboxed 1 6
+Scaled-init 1 2
+Scaled_scale.unboxed 1 2
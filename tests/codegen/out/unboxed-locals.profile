@@ -0,0 +1,7 @@
+Object-init 1 6
+IO-init 1 2
+Main-init 1 2
+Main_main 13 2 2000 2 286 1714 0 2 0 0 0 2 0 0
+Int-init 1 4
+Bool-init 1 0
+String-init 1 0
@@ -0,0 +1,46 @@
+-- Case chooses the closest ancestor of the dynamic type among its branches.
+
+class A { };
+class B inherits A { };
+class C inherits B { };
+class D inherits A { };
+class E inherits D { };
+class F inherits E { };
+class G { };
+
+class Main inherits IO
+{
+  classify(o : Object) : String
+  {
+    case o of
+      e : E => "E";
+      b : B => "B";
+      a : A => "A";
+      g : G => "G";
+      i : Int => "Int";
+      s : String => "String";
+      x : Object => "Object";
+    esac
+  };
+
+  classify_a(a : A) : String
+  {
+    case a of
+      g : G => "G";
+      d : D => "D";
+      c : C => "C";
+      x : A => "A";
+    esac
+  };
+
+  main() : Object
+  {
+    {
+      out_string(classify(new A).concat(classify(new B)).concat(classify(new C)).concat(classify(new D)));
+      out_string(classify(new E).concat(classify(new F)).concat(classify(new G)).concat(classify(1)));
+      out_string(classify("s").concat(classify(true)).concat(classify(new Main)).concat("\n"));
+      out_string(classify_a(new A).concat(classify_a(new B)).concat(classify_a(new C)).concat(classify_a(new D)));
+      out_string(classify_a(new E).concat(classify_a(new F)).concat("\n"));
+    }
+  };
+};
@@ -0,0 +1,68 @@
+-- Dispatch must choose the same method regardless of the number of
+-- implementations visible from the static type of the receiver.
+
+class A inherits IO
+{
+  name() : String { "A" };
+  mono() : Int { 1 };
+  many() : String { "A" };
+  report() : Object { out_string(name().concat(" ").concat(many()).concat("\n")) };
+};
+
+class B inherits A
+{
+  many() : String { "B" };
+};
+
+class C inherits A
+{
+  name() : String { "C" };
+  many() : String { "C" };
+};
+
+class D inherits C
+{
+  many() : String { "D" };
+};
+
+class E inherits B
+{
+  name() : String { "E" };
+};
+
+class F inherits C
+{
+};
+
+class Main inherits IO
+{
+  sum : Int;
+
+  visit(a : A) : Object
+  {
+    {
+      a.report();
+      sum <- sum + a.mono();
+    }
+  };
+
+  main() : Object
+  {
+    {
+      visit(new A);
+      visit(new B);
+      visit(new C);
+      visit(new D);
+      visit(new E);
+      visit(new F);
+
+      let c : C <- new F in out_string(c.name().concat(c.many()).concat("\n"));
+      let c : C <- new D in out_string(c.name().concat(c.many()).concat("\n"));
+      let b : B <- new E in out_string(b.name().concat(b.many()).concat("\n"));
+      let a : A <- new E in out_string(a@A.name().concat(a@A.many()).concat("\n"));
+
+      out_int(sum);
+      out_string("\n");
+    }
+  };
+};
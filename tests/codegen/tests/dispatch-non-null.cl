@@ -0,0 +1,44 @@
+-- Receivers that are never void are dispatched without the null check.
+-- Attribute can be observed void by the dispatch in the init chain, so it is checked.
+
+class Node inherits IO
+{
+  next : Node;
+
+  link(n : Node) : Node { { next <- n; self; } };
+
+  get() : Node { next };
+
+  fresh() : Node { new Node };
+
+  show(s : String) : SELF_TYPE { out_string(s) };
+};
+
+class Holder inherits IO
+{
+  first : Node <- peek();
+  second : Node <- new Node;
+
+  peek() : Node { { if isvoid second then out_string("void\n") else out_string("set\n") fi; second; } };
+
+  second() : Node { second };
+};
+
+class Main inherits IO
+{
+  node : Node <- new Node;
+
+  main() : Object
+  {
+    {
+      node.show("attr\n");
+      node.fresh().fresh().show("fresh\n");
+      let n : Node <- new Node in n.link(node).get().show("link\n");
+      case node.fresh() of
+        n : Node => n.show("case\n");
+      esac;
+      (new Holder).second().show("holder\n");
+      if isvoid node.get() then out_string("next is void\n") else out_string("next is set\n") fi;
+    }
+  };
+};
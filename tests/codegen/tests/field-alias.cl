@@ -0,0 +1,45 @@
+-- Fields are accessed through the classes that declare and inherit them,
+-- header and dispatch table of the receiver are reloaded when the receiver changes.
+
+class Counter
+{
+  count : Int;
+
+  inc() : Int { count <- count + 1 };
+
+  count() : Int { count };
+};
+
+class Pair inherits Counter
+{
+  other : Int;
+
+  bump() : Int { { inc(); other <- other + count(); } };
+
+  other() : Int { other };
+};
+
+class Twice inherits Pair
+{
+  inc() : Int { count <- count() + 2 };
+};
+
+class Main inherits IO
+{
+  main() : Object
+  {
+    let p : Pair <- new Pair, c : Counter <- new Twice, i : Int <- 0 in
+    {
+      while i < 5 loop
+      {
+        p.bump();
+        c.inc();
+        if i = 2 then c <- p else 0 fi;
+        i <- i + 1;
+      }
+      pool;
+      out_int(p.count()).out_string(" ").out_int(p.other()).out_string(" ").out_int(c.count()).out_string("\n");
+      out_string(c.type_name()).out_string("\n");
+    }
+  };
+};
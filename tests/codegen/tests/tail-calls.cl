@@ -0,0 +1,64 @@
+class Node {
+  id : Int;
+
+  init(i : Int) : Node { { id <- i; self; } };
+
+  -- tail call on the other receiver: self changes on every step
+  walk(other : Node, n : Int) : Int {
+    if n = 0 then id else other.walk(self, n - 1) fi
+  };
+};
+
+class Main inherits IO {
+  -- too deep for the stack if the tail call is not a loop
+  count(n : Int, acc : Int) : Int {
+    if n = 0 then acc else count(n - 1, acc + 1) fi
+  };
+
+  -- tail call in a let body
+  count_let(n : Int, acc : Int) : Int {
+    if n = 0 then acc else
+      let m : Int <- n - 1 in count_let(m, acc + 2)
+    fi
+  };
+
+  -- tail calls in case branches, the scrutinee changes its type on every step
+  count_case(o : Object, n : Int, ints : Int) : Int {
+    if n = 0 then ints else
+      case o of
+        i : Int => count_case("s", n - 1, ints + 1);
+        s : String => count_case(n, n - 1, ints);
+      esac
+    fi
+  };
+
+  -- tail call in the last expression of a block
+  count_block(n : Int, acc : Int) : Int {
+    {
+      acc <- acc + 3;
+      if n = 0 then acc else count_block(n - 1, acc) fi;
+    }
+  };
+
+  -- self call is not in tail position: its result is used by the addition
+  depth(n : Int) : Int {
+    if n = 0 then 0 else 1 + depth(n - 1) fi
+  };
+
+  main() : Object {
+    {
+      out_int(count(1000000, 0));
+      out_string("\n");
+      out_int(count_let(1000000, 0));
+      out_string("\n");
+      out_int(count_case(0, 1000000, 0));
+      out_string("\n");
+      out_int(count_block(1000000, 0));
+      out_string("\n");
+      out_int(depth(100));
+      out_string("\n");
+      out_int((new Node).init(1).walk((new Node).init(2), 11));
+      out_string("\n");
+    }
+  };
+};
@@ -0,0 +1,50 @@
+-- Int and Bool arguments and results of the directly called methods
+-- are passed as raw values, but must behave as objects everywhere else.
+
+class Math
+{
+  fact(n : Int) : Int { if n = 0 then 1 else n * fact(n - 1) fi };
+  fib(n : Int) : Int { if n < 2 then n else fib(n - 1) + fib(n - 2) fi };
+  even(n : Int) : Bool { if n = 0 then true else not even(n - 1) fi };
+  scale(n : Int) : Int { n * 2 };
+};
+
+class Scaled inherits Math
+{
+  scale(n : Int) : Int { n * 3 };
+};
+
+class Main inherits IO
+{
+  last : Object;
+
+  print(n : Int) : Object { { out_int(n); out_string("\n"); } };
+
+  main() : Object
+  {
+    let m : Math <- new Math, s : Math <- new Scaled in
+    {
+      print(m.fact(10));
+      print(m.fib(20));
+      if m.even(10) then out_string("even\n") else out_string("odd\n") fi;
+      if m.even(7) then out_string("even\n") else out_string("odd\n") fi;
+
+      print(m.scale(5));
+      print(s.scale(5));
+      print(s@Math.scale(5));
+      print(m.scale(~100));
+
+      last <- m.fib(12);
+      case last of
+        i : Int => print(i);
+        o : Object => abort();
+      esac;
+
+      last <- m.even(3);
+      case last of
+        b : Bool => if b then out_string("true\n") else out_string("false\n") fi;
+        o : Object => abort();
+      esac;
+    }
+  };
+};
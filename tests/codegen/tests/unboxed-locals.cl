@@ -0,0 +1,31 @@
+-- Int and Bool let variables are kept as raw values inside of the method,
+-- so the counting loop doesn't allocate. They are boxed only when escape.
+
+class Main inherits IO
+{
+  last : Object;
+
+  main() : Object
+  {
+    let i : Int <- 0, sum : Int, odd : Bool in
+    {
+      while i < 1000 loop
+      {
+        if i - (i / 7) * 7 = 0 then sum <- sum + i else sum <- sum - 1 fi;
+        odd <- not odd;
+        i <- i + 1;
+      } pool;
+
+      out_int(sum);
+      out_string(if odd then " odd\n" else " even\n" fi);
+
+      last <- let j : Int <- i * 2 in j <- j + 1;
+      case last of
+        n : Int => { out_int(n); out_string("\n"); };
+        o : Object => abort();
+      esac;
+
+      let x : Int <- 5 in let x : Int <- x * x in { out_int(x); out_string("\n"); };
+    }
+  };
+};